@@ -0,0 +1,110 @@
+#include <fmt/core.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "ndt/context.h"
+#include "ndt/event_handler_select.h"
+#include "ndt/handler_dispatcher.h"
+#include "ndt/udp.h"
+
+// Compares the two ways executor calls socket handlers: through function
+// pointers stored in HandlerSelectBase and through compile-time handler list.
+// Handlers are called via the same HandlerDispatcher which executor uses, but
+// without waiting for sockets, so only the cost of dispatch itself and of the
+// handler body is measured. Events are spread over several handler types in
+// random order, like they are in a server with several kinds of sockets.
+
+namespace
+{
+constexpr std::size_t kHandlerTypeCount = 4;
+constexpr std::size_t kEventCount = 4096;
+constexpr std::size_t kRoundCount = 10000;
+
+template <typename SysWrapperT, std::size_t N>
+class Handler
+    : public ndt::HandlerSelect<ndt::Socket<ndt::UDP, SysWrapperT>,
+                                Handler<SysWrapperT, N>, SysWrapperT>
+{
+   public:
+    using SocketT = ndt::Socket<ndt::UDP, SysWrapperT>;
+
+    explicit Handler(ndt::Context<SysWrapperT> &aContext)
+        : ndt::HandlerSelect<SocketT, Handler, SysWrapperT>(aContext)
+    {
+    }
+
+    void readHandlerImpl(SocketT &) { count_ += N + 1; }
+
+    uint64_t count_ = 0;
+};
+
+struct DynamicOps : ndt::SocketOps
+{
+};
+
+struct StaticOps : ndt::SocketOps
+{
+    using HandlersT =
+        ndt::HandlerList<Handler<StaticOps, 0>, Handler<StaticOps, 1>,
+                         Handler<StaticOps, 2>, Handler<StaticOps, 3>>;
+};
+
+template <typename SysWrapperT>
+void run(const char *aName)
+{
+    using DispatcherT = ndt::HandlerDispatcher<SysWrapperT>;
+    using HandlerT = ndt::HandlerSelectBase<SysWrapperT>;
+
+    ndt::Context<SysWrapperT> ctx;
+    // socket is never opened, handlers don't touch it
+    ndt::Socket<ndt::UDP, SysWrapperT> socket(ctx, ndt::UDP::V4());
+    Handler<SysWrapperT, 0> h0(ctx);
+    Handler<SysWrapperT, 1> h1(ctx);
+    Handler<SysWrapperT, 2> h2(ctx);
+    Handler<SysWrapperT, 3> h3(ctx);
+    const std::array<HandlerT *, kHandlerTypeCount> handlers = {&h0, &h1, &h2,
+                                                                &h3};
+
+    // the same sequence for both dispatch paths
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<std::size_t> distribution(
+        0, kHandlerTypeCount - 1);
+    std::vector<HandlerT *> events(kEventCount);
+    for (auto &event: events)
+    {
+        event = handlers[distribution(generator)];
+    }
+
+    using ClockT = std::chrono::steady_clock;
+    const auto start = ClockT::now();
+    for (std::size_t round = 0; round < kRoundCount; ++round)
+    {
+        for (HandlerT *handler: events)
+        {
+            DispatcherT::inData(socket, handler);
+        }
+    }
+    const auto elapsed = ClockT::now() - start;
+
+    const double nsPerEvent =
+        static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                .count()) /
+        static_cast<double>(kEventCount * kRoundCount);
+    // printed so that handler calls can't be optimized out
+    const uint64_t checksum = h0.count_ + h1.count_ + h2.count_ + h3.count_;
+    fmt::print("{:<8} {:>6.2f} ns/event (checksum {})\n", aName, nsPerEvent,
+               checksum);
+}
+}  // namespace
+
+int main()
+{
+    run<DynamicOps>("dynamic");
+    run<StaticOps>("static");
+    return 0;
+}
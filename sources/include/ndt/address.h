@@ -2,6 +2,7 @@
 #define ndt_address_h
 
 #include <string>
+#include <string_view>
 #include <variant>
 
 #include "bin_rw.h"
@@ -19,13 +20,16 @@ inline const std::string kInvalidAddressFamilyDescr =
 inline const std::string kAddressUnknownFamilyDescr = "unknown address family";
 inline const std::string kStringIsNotIpAddressDescr =
     "string is not valid ip address";
+inline const std::string kInvalidUnixPathDescr =
+    "unix socket path is empty, too long or contains zero character";
 
 enum class eAddressErrorCode
 {
     kSuccess = 0,
     kInvalidAddressFamily,
     kAddressUnknownFamilyDescr,
-    kStringIsNotIpAddress
+    kStringIsNotIpAddress,
+    kInvalidUnixPath
 };
 
 class AddressErrorCategory : public std::error_category
@@ -105,6 +109,7 @@ class Address final
     Address(const ipv4_t &aIPv4, const uint16_t aPort) noexcept;
     Address(const ipv6_t &aIPv6, const uint16_t aPort) noexcept;
 
+    // aSockaddr of AF_UNIX family must be backed by sockaddr_un
     explicit Address(const sockaddr &aSockaddr);
 
     eAddressFamily addressFamily() const noexcept;
@@ -137,6 +142,35 @@ class Address final
     void port(uint16_t aPort) noexcept;
     uint16_t port() const noexcept;
 
+    // true for IPv6 address ::ffff:a.b.c.d which dual-stack socket reports
+    // for IPv4 peer
+    bool isV4Mapped() const noexcept;
+    // turns v4-mapped address into IPv4 one with the same port, other
+    // addresses aren't changed. Gives single form of peer's address for
+    // lookup tables.
+    void normalize() noexcept;
+    // turns IPv4 address into v4-mapped IPv6 one with the same port, other
+    // addresses aren't changed. Not every platform accepts IPv4 destinations
+    // on dual-stack socket.
+    void mapToV6() noexcept;
+
+#if !_WIN32
+    // AF_UNIX address of socket file at aPath, the file is created by bind
+    // and isn't removed when socket is closed
+    void unixPath(std::string_view aPath, std::error_code &aEc) noexcept;
+    void unixPath(std::string_view aPath);
+#if defined(__linux__)
+    // AF_UNIX address in abstract namespace of Linux, it has no file and
+    // is released with the last socket bound to it
+    void abstractPath(std::string_view aName, std::error_code &aEc) noexcept;
+    void abstractPath(std::string_view aName);
+#endif
+    // path of AF_UNIX address, name without leading zero character for
+    // abstract address, empty for unnamed socket and other families
+    std::string_view unixPath() const noexcept;
+    bool isAbstract() const noexcept;
+#endif
+
     const sockaddr *nativeDataConst() const noexcept;
     void reset() noexcept;
     std::size_t capacity() const noexcept;
@@ -163,6 +197,14 @@ class Address final
     void throwIfInvalidFamily(
         const typename AddressFamily<AF_Type>::type aFamily);
     sockaddr *nativeData() noexcept;
+    // length of address which kernel reported for peer, bytes of AF_UNIX
+    // path beyond it are cleared
+    void nativeLength(const std::size_t aLength) noexcept;
+#if !_WIN32
+    std::size_t unixCapacity() const noexcept;
+    void unixName(const std::size_t aOffset, std::string_view aName,
+                  std::error_code &aEc) noexcept;
+#endif
     sa_u sockaddr_;
 };
 
@@ -109,6 +109,69 @@ class CBuffer
     cbufp_t data_ = nullptr;
     dlen_t size_ = 0;
 };
+
+/*! \class Segments
+    \brief View of buffer which holds several datagrams of the same size
+   one after another, e.g. datagrams coalesced by UDP GRO
+   (SocketBase::recvSegmented) or sent by UDP GSO
+   (SocketBase::sendSegmented). The last datagram may be shorter. Datagrams
+   are views of the buffer, nothing is copied.
+ */
+class Segments
+{
+   public:
+    constexpr Segments(CBuffer aData, std::size_t aSegmentSize) noexcept
+        : data_(aData), segmentSize_(aSegmentSize)
+    {
+    }
+
+    constexpr std::size_t segmentSize() const noexcept { return segmentSize_; }
+
+    std::size_t count() const noexcept
+    {
+        if (segmentSize_ == 0)
+        {
+            return 0;
+        }
+        return (data_.size<std::size_t>() + segmentSize_ - 1) / segmentSize_;
+    }
+
+    CBuffer operator[](std::size_t aIndex) const noexcept
+    {
+        assert(aIndex < count() && "Error: segment index is out of range");
+        const std::size_t offset = aIndex * segmentSize_;
+        const std::size_t size = data_.size<std::size_t>() - offset;
+        return CBuffer(data_[offset],
+                       size < segmentSize_ ? size : segmentSize_);
+    }
+
+   private:
+    CBuffer data_;
+    std::size_t segmentSize_ = 0;
+};
+
+// Drops the first aBytes bytes of array of buffers after partial stream
+// write or read: fully consumed buffers are skipped and the first remaining
+// one is shortened in place. aBufs and aCount then describe the rest of data
+// for the next call.
+template <typename BufferT>
+void consume(BufferT *&aBufs, std::size_t &aCount, std::size_t aBytes) noexcept
+{
+    static_assert(std::is_same_v<BufferT, Buffer> ||
+                      std::is_same_v<BufferT, CBuffer>,
+                  "Error: BufferT must be Buffer or CBuffer");
+    while ((aCount > 0) && (aBytes >= aBufs->template size<std::size_t>()))
+    {
+        aBytes -= aBufs->template size<std::size_t>();
+        ++aBufs;
+        --aCount;
+    }
+    if ((aCount > 0) && (aBytes > 0))
+    {
+        *aBufs = BufferT((*aBufs)[aBytes],
+                         aBufs->template size<std::size_t>() - aBytes);
+    }
+}
 }  // namespace ndt
 
 #endif /* ndt_buffer_h */
\ No newline at end of file
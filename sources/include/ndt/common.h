@@ -62,11 +62,26 @@ using cbufp_t = char const *;
 #include <fcntl.h>
 #include <netdb.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netinet/udp.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/un.h>
 #include <unistd.h>
 #include <cstddef>
 
+#if defined(__linux__)
+#include <linux/errqueue.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define NDT_HAS_IO_URING
+#endif
+#endif
+
 namespace ndt
 {
 using buf_t = void;
@@ -1,7 +1,14 @@
 #ifndef ndt_context_h
 #define ndt_context_h
 
-#include "executor_select.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <utility>
+
+#include "executor.h"
+#include "timer_wheel.h"
 
 #ifdef _WIN32
 #include "platform/win/context_base.h"
@@ -18,12 +25,55 @@ class Context final : public ContextBase<SysWrapperT>
     ~Context();
     Context();
     void run();
+    // can be called from any thread, loop exits after current iteration and
+    // blocking wait of executor is interrupted
     void stop();
-    ExecutorSelect<SysWrapperT> &executor() noexcept;
+    bool isRunning() const noexcept;
+    // Can be called from any thread. aHandler is called on the thread which
+    // runs the context after events of current iteration are handled.
+    void post(std::function<void()> aHandler);
+    Executor<SysWrapperT> &executor() noexcept;
+
+    // Stepping API for embedding the loop into application's own loop,
+    // e.g. fixed-rate game loop. Iterations are run on the calling thread and
+    // number of handled events, posted handlers and fired timers is returned.
+    // aMaxEvents caps events handled by every iteration, the rest are left
+    // for the next one.
+    using ClockT = std::chrono::steady_clock;
+    static constexpr std::size_t kNoEventLimit =
+        Executor<SysWrapperT>::kNoEventLimit;
+
+    // one iteration which doesn't block
+    std::size_t poll(const std::size_t aMaxEvents = kNoEventLimit);
+    // one iteration which blocks until events are ready, the nearest timer
+    // expires or executor's timeout elapses
+    std::size_t runOnce(const std::size_t aMaxEvents = kNoEventLimit);
+    // iterations until aDeadline or stop
+    std::size_t runUntil(const ClockT::time_point aDeadline,
+                         const std::size_t aMaxEvents = kNoEventLimit);
+    template <typename RepT, typename PeriodT>
+    std::size_t runFor(const std::chrono::duration<RepT, PeriodT> aDuration,
+                       const std::size_t aMaxEvents = kNoEventLimit);
+
+    // Arms (or re-arms) aTimer to fire after aDelay. Timers are fired after
+    // each executor iteration, wait of executor is shortened so that they
+    // are not late by more than a millisecond.
+    void schedule(Timer &aTimer, const std::chrono::milliseconds aDelay);
+    void cancel(Timer &aTimer) noexcept;
+    TimerWheel &timers() noexcept;
 
    private:
-    bool isRunning_ = false;
-    ExecutorSelect<SysWrapperT> executor_;
+    static constexpr auto kNoWaitLimit = std::chrono::microseconds::max();
+
+    std::size_t iterate(const std::chrono::microseconds aWaitLimit,
+                        const std::size_t aMaxEvents);
+    uint64_t nowTick() const noexcept;
+    void limitWait(const std::chrono::microseconds aWaitLimit) noexcept;
+
+    std::atomic_bool isRunning_ = false;
+    Executor<SysWrapperT> executor_;
+    TimerWheel timers_;
+    const ClockT::time_point origin_ = ClockT::now();
 };
 
 template <typename SysWrapperT>
@@ -38,21 +88,150 @@ void Context<SysWrapperT>::run()
     isRunning_ = true;
     do
     {
-        executor_();
+        iterate(kNoWaitLimit, kNoEventLimit);
     } while (isRunning_);
+    // don't leave datagrams queued by postSendTo until the next run
+    executor_.flush();
 }
 
 template <typename SysWrapperT>
 void Context<SysWrapperT>::stop()
 {
     isRunning_ = false;
+    executor_.wakeup();
 }
 
 template <typename SysWrapperT>
-ExecutorSelect<SysWrapperT> &Context<SysWrapperT>::executor() noexcept
+void Context<SysWrapperT>::post(std::function<void()> aHandler)
+{
+    executor_.post(std::move(aHandler));
+}
+
+template <typename SysWrapperT>
+bool Context<SysWrapperT>::isRunning() const noexcept
+{
+    return isRunning_;
+}
+
+template <typename SysWrapperT>
+Executor<SysWrapperT> &Context<SysWrapperT>::executor() noexcept
 {
     return executor_;
 }
+
+template <typename SysWrapperT>
+std::size_t Context<SysWrapperT>::poll(const std::size_t aMaxEvents)
+{
+    const std::size_t count =
+        iterate(std::chrono::microseconds(0), aMaxEvents);
+    executor_.flush();
+    return count;
+}
+
+template <typename SysWrapperT>
+std::size_t Context<SysWrapperT>::runOnce(const std::size_t aMaxEvents)
+{
+    const std::size_t count = iterate(kNoWaitLimit, aMaxEvents);
+    executor_.flush();
+    return count;
+}
+
+template <typename SysWrapperT>
+std::size_t Context<SysWrapperT>::runUntil(const ClockT::time_point aDeadline,
+                                           const std::size_t aMaxEvents)
+{
+    std::size_t count = 0;
+    isRunning_ = true;
+    while (isRunning_)
+    {
+        const auto now = ClockT::now();
+        if (now >= aDeadline)
+        {
+            break;
+        }
+        count += iterate(std::chrono::duration_cast<std::chrono::microseconds>(
+                             aDeadline - now),
+                         aMaxEvents);
+    }
+    isRunning_ = false;
+    executor_.flush();
+    return count;
+}
+
+template <typename SysWrapperT>
+template <typename RepT, typename PeriodT>
+std::size_t Context<SysWrapperT>::runFor(
+    const std::chrono::duration<RepT, PeriodT> aDuration,
+    const std::size_t aMaxEvents)
+{
+    return runUntil(ClockT::now() +
+                        std::chrono::duration_cast<ClockT::duration>(aDuration),
+                    aMaxEvents);
+}
+
+template <typename SysWrapperT>
+void Context<SysWrapperT>::schedule(Timer &aTimer,
+                                    const std::chrono::milliseconds aDelay)
+{
+    // expiry is based on the clock rather than on wheel time, which is
+    // behind while handlers are called
+    const auto delay = static_cast<uint64_t>(std::max<long long>(
+        static_cast<long long>(aDelay.count()), 0));
+    timers_.schedule(aTimer, nowTick() + delay);
+}
+
+template <typename SysWrapperT>
+void Context<SysWrapperT>::cancel(Timer &aTimer) noexcept
+{
+    timers_.cancel(aTimer);
+}
+
+template <typename SysWrapperT>
+TimerWheel &Context<SysWrapperT>::timers() noexcept
+{
+    return timers_;
+}
+
+template <typename SysWrapperT>
+uint64_t Context<SysWrapperT>::nowTick() const noexcept
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(ClockT::now() -
+                                                              origin_)
+            .count());
+}
+
+template <typename SysWrapperT>
+std::size_t Context<SysWrapperT>::iterate(
+    const std::chrono::microseconds aWaitLimit, const std::size_t aMaxEvents)
+{
+    limitWait(aWaitLimit);
+    if (aMaxEvents != kNoEventLimit)
+    {
+        executor_.limitEvents(aMaxEvents);
+    }
+    const std::size_t count = executor_();
+    return count + timers_.advance(nowTick());
+}
+
+template <typename SysWrapperT>
+void Context<SysWrapperT>::limitWait(
+    const std::chrono::microseconds aWaitLimit) noexcept
+{
+    // wait ends at the nearest timer expiry or at aWaitLimit
+    std::chrono::microseconds limit = aWaitLimit;
+    if (const uint64_t next = timers_.nextExpiry(); next != TimerWheel::kNever)
+    {
+        const uint64_t now = nowTick();
+        const uint64_t delay = (next > now) ? (next - now) : 0;
+        limit = std::min<std::chrono::microseconds>(
+            limit, std::chrono::milliseconds(static_cast<long long>(delay)));
+    }
+    if (limit != kNoWaitLimit)
+    {
+        executor_.limitWait(limit);
+    }
+}
 }  // namespace ndt
 
 #endif /* ndt_context_h */
\ No newline at end of file
@@ -0,0 +1,208 @@
+#ifndef ndt_context_group_h
+#define ndt_context_group_h
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "context.h"
+#include "useful_base_types.h"
+
+namespace ndt
+{
+/*! \class ContextGroup
+    \brief Runs N Context instances, each on its own thread. Every thread
+   constructs its reactor as ReactorT(Context &, std::size_t aIndex, aArgs...)
+   right before running the context and destroys it on the same thread after
+   the context is stopped, so reactor's sockets and handlers are touched by
+   one thread only. To spread one server port across threads reactor opens
+   its socket, calls reusePort(true) and binds it to the common port, then
+   kernel distributes flows between the sockets.
+ */
+template <typename SysWrapperT>
+class ContextGroup final
+    : private NoCopyAble
+    , private NoMoveAble
+{
+   public:
+    using ContextT = Context<SysWrapperT>;
+
+    ~ContextGroup();
+    // one context per hardware thread
+    ContextGroup();
+    explicit ContextGroup(const std::size_t aSize);
+
+    template <typename ReactorT, typename... ArgsT>
+    void start(const ArgsT &... aArgs);
+    // requests stop of all contexts and waits for their threads, rethrows
+    // the first exception which escaped from any reactor
+    void stop();
+    // waits until all contexts are stopped (e.g. reactors stopped their
+    // contexts themselves), rethrows the same way as stop
+    void join();
+
+    bool isStopRequested() const noexcept;
+    std::size_t size() const noexcept;
+    ContextT &context(const std::size_t aIndex) noexcept;
+
+   private:
+    template <typename ReactorT, typename... ArgsT>
+    void runReactor(const std::size_t aIndex, const ArgsT &... aArgs);
+    void requestStop();
+    void joinThreads() noexcept;
+
+    std::atomic_bool isStopRequested_ = false;
+    std::vector<std::unique_ptr<ContextT>> contexts_;
+    std::vector<std::thread> threads_;
+    std::mutex errorMutex_;
+    std::exception_ptr error_;
+};
+
+template <typename SysWrapperT>
+ContextGroup<SysWrapperT>::~ContextGroup()
+{
+    requestStop();
+    joinThreads();
+}
+
+template <typename SysWrapperT>
+ContextGroup<SysWrapperT>::ContextGroup()
+    : ContextGroup(std::max(std::thread::hardware_concurrency(), 1u))
+{
+}
+
+template <typename SysWrapperT>
+ContextGroup<SysWrapperT>::ContextGroup(const std::size_t aSize)
+{
+    assert(aSize > 0 && "Error: group must contain at least one context");
+    contexts_.reserve(aSize);
+    for (std::size_t i = 0; i < aSize; ++i)
+    {
+        contexts_.push_back(std::make_unique<ContextT>());
+    }
+}
+
+template <typename SysWrapperT>
+template <typename ReactorT, typename... ArgsT>
+void ContextGroup<SysWrapperT>::start(const ArgsT &... aArgs)
+{
+    assert(threads_.empty() && "Error: group is already started");
+    isStopRequested_ = false;
+    error_ = nullptr;
+    threads_.reserve(contexts_.size());
+    for (std::size_t i = 0; i < contexts_.size(); ++i)
+    {
+        // arguments are copied, every reactor gets its own instance
+        threads_.emplace_back(
+            [this, i, args = std::make_tuple(aArgs...)]() {
+                std::apply(
+                    [this, i](const auto &... aCopies) {
+                        runReactor<ReactorT>(i, aCopies...);
+                    },
+                    args);
+            });
+    }
+}
+
+template <typename SysWrapperT>
+void ContextGroup<SysWrapperT>::stop()
+{
+    requestStop();
+    join();
+}
+
+template <typename SysWrapperT>
+void ContextGroup<SysWrapperT>::join()
+{
+    joinThreads();
+    if (error_)
+    {
+        std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+}
+
+template <typename SysWrapperT>
+bool ContextGroup<SysWrapperT>::isStopRequested() const noexcept
+{
+    return isStopRequested_;
+}
+
+template <typename SysWrapperT>
+std::size_t ContextGroup<SysWrapperT>::size() const noexcept
+{
+    return contexts_.size();
+}
+
+template <typename SysWrapperT>
+auto ContextGroup<SysWrapperT>::context(const std::size_t aIndex) noexcept
+    -> ContextT &
+{
+    assert(aIndex < contexts_.size() && "Error: invalid context index");
+    return *contexts_[aIndex];
+}
+
+template <typename SysWrapperT>
+template <typename ReactorT, typename... ArgsT>
+void ContextGroup<SysWrapperT>::runReactor(const std::size_t aIndex,
+                                           const ArgsT &... aArgs)
+{
+    ContextT &ctx = *contexts_[aIndex];
+    try
+    {
+        ReactorT reactor(ctx, aIndex, aArgs...);
+        ctx.run();
+    }
+    catch (...)
+    {
+        {
+            std::lock_guard<std::mutex> lock(errorMutex_);
+            if (!error_)
+            {
+                error_ = std::current_exception();
+            }
+        }
+        requestStop();
+    }
+}
+
+template <typename SysWrapperT>
+void ContextGroup<SysWrapperT>::requestStop()
+{
+    isStopRequested_ = true;
+    for (auto &ctx: contexts_)
+    {
+        // Context::stop made before run has started would be overridden by
+        // run, posted handler is called by run itself. Handler which stays
+        // queued because run hasn't started at all must not stop next start.
+        ContextT *context = ctx.get();
+        context->post([this, context]() {
+            if (isStopRequested_)
+            {
+                context->stop();
+            }
+        });
+    }
+}
+
+template <typename SysWrapperT>
+void ContextGroup<SysWrapperT>::joinThreads() noexcept
+{
+    for (auto &thread: threads_)
+    {
+        if (thread.joinable())
+        {
+            thread.join();
+        }
+    }
+    threads_.clear();
+}
+}  // namespace ndt
+
+#endif /* ndt_context_group_h */
@@ -13,20 +13,36 @@
 #include "buffer.h"
 #include "common.h"
 #include "context.h"
+#include "context_group.h"
+#include "coroutine.h"
 #include "endian.h"
 #include "event_handler_select.h"
 #include "exception.h"
+#include "executor.h"
+#include "executor_base.h"
+#include "executor_epoll.h"
 #include "executor_select.h"
 #include "executor_select_base.h"
+#include "executor_stats.h"
+#include "executor_uring.h"
 #include "fast_pimpl.h"
+#include "handler_dispatcher.h"
+#include "histogram.h"
 #include "index_maker.h"
+#include "mpsc_queue.h"
 #include "ndt/version_info.h"
 #include "packet_handlers.h"
+#include "send_queue.h"
+#include "shm_ring.h"
 #include "socket.h"
 #include "sys_socket_ops.h"
+#include "tcp.h"
 #include "thread_pool.h"
+#include "timer_wheel.h"
 #include "udp.h"
+#include "unix_dgram.h"
 #include "useful_base_types.h"
 #include "utils.h"
+#include "waker.h"
 
 #endif /* ndt_core_h */
\ No newline at end of file
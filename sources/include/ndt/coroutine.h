@@ -0,0 +1,303 @@
+#ifndef ndt_coroutine_h
+#define ndt_coroutine_h
+
+#if defined(NDT_COROUTINES)
+
+#include <cassert>
+#include <coroutine>
+#include <exception>
+#include <system_error>
+
+#include "address.h"
+#include "buffer.h"
+#include "event_handler_select.h"
+#include "exception.h"
+#include "socket.h"
+
+namespace ndt
+{
+/*! \class DetachedTask
+    \brief Return type of coroutines driven by Context. Coroutine starts
+   right away, runs until its first co_await which can't complete
+   immediately and is resumed by the executor of its socket's Context.
+   Coroutine frame is freed when coroutine finishes. Like std::thread
+   function coroutine must not let exceptions escape, std::terminate is
+   called otherwise.
+ */
+class DetachedTask final
+{
+   public:
+    struct promise_type
+    {
+        DetachedTask get_return_object() const noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+namespace details
+{
+// result of socket operation shared by awaiters, coroutine is resumed by
+// executor as deferred call, so it may destroy the socket it has awaited
+class AwaitState final : public DeferredCall
+{
+   public:
+    explicit AwaitState(std::error_code *aEc) noexcept : ecOut_(aEc)
+    {
+        call_ = [](DeferredCall &aCall) {
+            static_cast<AwaitState &>(aCall).handle_.resume();
+        };
+    }
+
+    // returns true if operation is completed, false if it would block
+    bool complete(const std::size_t aResult, const std::error_code &aEc)
+    {
+        if (aEc == std::errc::operation_would_block)
+        {
+            return false;
+        }
+        result_ = aResult;
+        ec_ = aEc;
+        return true;
+    }
+
+    std::size_t resume()
+    {
+        if (ecOut_)
+        {
+            *ecOut_ = ec_;
+        }
+        else
+        {
+            throw_if_error(ec_);
+        }
+        return result_;
+    }
+
+    std::coroutine_handle<> handle_;
+
+   private:
+    std::error_code ec_;
+    std::error_code *ecOut_ = nullptr;
+    std::size_t result_ = 0;
+};
+}  // namespace details
+
+/*! \class RecvFromAwaiter
+    \brief Result of Socket::asyncRecvFrom. Datagram is read right away if it
+   is already available. Otherwise awaiter lives in coroutine frame, becomes
+   socket's handler until datagram arrives and executor resumes coroutine
+   after current dispatch pass. co_await returns number of received bytes.
+ */
+template <typename SocketT>
+class RecvFromAwaiter final
+    : public HandlerSelect<SocketT, RecvFromAwaiter<SocketT>,
+                           typename SocketT::SysCallsT>
+{
+    using SysWrapperT = typename SocketT::SysCallsT;
+    using BaseT = HandlerSelect<SocketT, RecvFromAwaiter, SysWrapperT>;
+
+   public:
+    RecvFromAwaiter(Context<SysWrapperT> &aContext, SocketT &aSocket,
+                    Buffer &aBuf, Address &aSender,
+                    std::error_code *aEc) noexcept;
+
+    bool await_ready();
+    void await_suspend(std::coroutine_handle<> aHandle);
+    std::size_t await_resume();
+
+    void readHandlerImpl(SocketT &aSocket);
+
+   private:
+    bool tryRecv();
+
+    SocketT &socket_;
+    Buffer &buf_;
+    Address &sender_;
+    details::AwaitState state_;
+};
+
+template <typename SocketT>
+RecvFromAwaiter<SocketT>::RecvFromAwaiter(Context<SysWrapperT> &aContext,
+                                          SocketT &aSocket, Buffer &aBuf,
+                                          Address &aSender,
+                                          std::error_code *aEc) noexcept
+    : BaseT(aContext)
+    , socket_(aSocket)
+    , buf_(aBuf)
+    , sender_(aSender)
+    , state_(aEc)
+{
+}
+
+template <typename SocketT>
+bool RecvFromAwaiter<SocketT>::await_ready()
+{
+    return tryRecv();
+}
+
+template <typename SocketT>
+void RecvFromAwaiter<SocketT>::await_suspend(std::coroutine_handle<> aHandle)
+{
+    assert(!socket_.handler() &&
+           "Error: socket awaited by coroutine must not have other handler");
+    state_.handle_ = aHandle;
+    socket_.handler(this);
+}
+
+template <typename SocketT>
+std::size_t RecvFromAwaiter<SocketT>::await_resume()
+{
+    return state_.resume();
+}
+
+template <typename SocketT>
+void RecvFromAwaiter<SocketT>::readHandlerImpl(SocketT &)
+{
+    if (tryRecv())
+    {
+        // coroutine may await socket again or destroy the awaiter, so
+        // handler is detached before resuming
+        socket_.handler(nullptr);
+        this->context_.executor().defer(state_);
+    }
+}
+
+template <typename SocketT>
+bool RecvFromAwaiter<SocketT>::tryRecv()
+{
+    std::error_code ec;
+    const auto bytesReceived = socket_.recvFrom(buf_, sender_, ec);
+    return state_.complete(bytesReceived, ec);
+}
+
+/*! \class SendToAwaiter
+    \brief Result of Socket::asyncSendTo. Datagram is sent right away if
+   socket's send buffer has room for it. Otherwise coroutine is suspended
+   until socket becomes writable. co_await returns number of sent bytes.
+   aBuf must stay valid until co_await returns.
+ */
+template <typename SocketT>
+class SendToAwaiter final
+    : public HandlerSelect<SocketT, SendToAwaiter<SocketT>,
+                           typename SocketT::SysCallsT>
+{
+    using SysWrapperT = typename SocketT::SysCallsT;
+    using BaseT = HandlerSelect<SocketT, SendToAwaiter, SysWrapperT>;
+
+   public:
+    SendToAwaiter(Context<SysWrapperT> &aContext, SocketT &aSocket,
+                  const Address &aDst, CBuffer aBuf,
+                  std::error_code *aEc) noexcept;
+
+    bool await_ready();
+    void await_suspend(std::coroutine_handle<> aHandle);
+    std::size_t await_resume();
+
+    void writeHandlerImpl(SocketT &aSocket);
+
+   private:
+    bool trySend();
+
+    SocketT &socket_;
+    Address dst_;
+    CBuffer buf_;
+    details::AwaitState state_;
+};
+
+template <typename SocketT>
+SendToAwaiter<SocketT>::SendToAwaiter(Context<SysWrapperT> &aContext,
+                                      SocketT &aSocket, const Address &aDst,
+                                      CBuffer aBuf,
+                                      std::error_code *aEc) noexcept
+    : BaseT(aContext), socket_(aSocket), dst_(aDst), buf_(aBuf), state_(aEc)
+{
+}
+
+template <typename SocketT>
+bool SendToAwaiter<SocketT>::await_ready()
+{
+    return trySend();
+}
+
+template <typename SocketT>
+void SendToAwaiter<SocketT>::await_suspend(std::coroutine_handle<> aHandle)
+{
+    assert(!socket_.handler() &&
+           "Error: socket awaited by coroutine must not have other handler");
+    state_.handle_ = aHandle;
+    socket_.handler(this);
+}
+
+template <typename SocketT>
+std::size_t SendToAwaiter<SocketT>::await_resume()
+{
+    return state_.resume();
+}
+
+template <typename SocketT>
+void SendToAwaiter<SocketT>::writeHandlerImpl(SocketT &)
+{
+    if (trySend())
+    {
+        socket_.handler(nullptr);
+        this->context_.executor().defer(state_);
+    }
+}
+
+template <typename SocketT>
+bool SendToAwaiter<SocketT>::trySend()
+{
+    std::error_code ec;
+    const auto bytesSent = socket_.sendTo(dst_, buf_, ec);
+    return state_.complete(bytesSent, ec);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+auto Socket<FlagsT, SysWrapperT>::asyncRecvFrom(Buffer &aBuf,
+                                                Address &aSender)
+    -> RecvFromAwaiter<Socket>
+{
+    assert(this->nonBlocking() &&
+           "Error: socket awaited by coroutine must be non-blocking");
+    return {this->context_.get(), *this, aBuf, aSender, nullptr};
+}
+
+template <typename FlagsT, typename SysWrapperT>
+auto Socket<FlagsT, SysWrapperT>::asyncRecvFrom(Buffer &aBuf,
+                                                Address &aSender,
+                                                std::error_code &aEc)
+    -> RecvFromAwaiter<Socket>
+{
+    assert(this->nonBlocking() &&
+           "Error: socket awaited by coroutine must be non-blocking");
+    return {this->context_.get(), *this, aBuf, aSender, &aEc};
+}
+
+template <typename FlagsT, typename SysWrapperT>
+auto Socket<FlagsT, SysWrapperT>::asyncSendTo(const Address &aDst,
+                                              CBuffer aBuf)
+    -> SendToAwaiter<Socket>
+{
+    assert(this->nonBlocking() &&
+           "Error: socket awaited by coroutine must be non-blocking");
+    return {this->context_.get(), *this, aDst, aBuf, nullptr};
+}
+
+template <typename FlagsT, typename SysWrapperT>
+auto Socket<FlagsT, SysWrapperT>::asyncSendTo(const Address &aDst,
+                                              CBuffer aBuf,
+                                              std::error_code &aEc)
+    -> SendToAwaiter<Socket>
+{
+    assert(this->nonBlocking() &&
+           "Error: socket awaited by coroutine must be non-blocking");
+    return {this->context_.get(), *this, aDst, aBuf, &aEc};
+}
+}  // namespace ndt
+
+#endif /* NDT_COROUTINES */
+
+#endif /* ndt_coroutine_h */
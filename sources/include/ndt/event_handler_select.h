@@ -4,7 +4,10 @@
 #include <cstdint>
 #include <type_traits>
 
-#include "executor_select.h"
+#include "address.h"
+#include "buffer.h"
+#include "executor.h"
+#include "handler_dispatcher.h"
 
 namespace ndt
 {
@@ -21,12 +24,30 @@ class HandlerSelectBase
     template <typename SocketT, typename HandlerT, typename SysWrappersT>
     friend class HandlerSelect;
 
+    template <typename ImplT, typename SysWrappersT>
+    friend class ExecutorBase;
+
     template <typename ImplT, typename SysWrappersT>
     friend class ExecutorSelectBase;
 
-    using InDataHandlerT = void (*)(ndt::SocketBase<SysWrapperT> &, void *);
+    template <typename SysWrappersT>
+    friend class ExecutorEpoll;
+
+    template <typename SysWrappersT>
+    friend class ExecutorUring;
+
+    template <typename SysWrappersT, typename ListT>
+    friend class HandlerDispatcher;
+
+    template <typename SysWrappersT>
+    friend class SocketBase;
+
+    // returns true if socket may have more data to read
+    using InDataHandlerT = bool (*)(ndt::SocketBase<SysWrapperT> &, void *);
     using OutDataHandlerT = void (*)(ndt::SocketBase<SysWrapperT> &, void *);
     using ExceptCondHandlerT = void (*)(ndt::SocketBase<SysWrapperT> &, void *);
+    using RecvHandlerT = void (*)(ndt::SocketBase<SysWrapperT> &, void *,
+                                  const Address &, CBuffer);
 
     enum eTrakingEvents : uint8_t
     {
@@ -34,9 +55,14 @@ class HandlerSelectBase
         kRead = 1 << 0,
         kWrite = 1 << 1,
         kExceptCond = 1 << 2,
-        kAll = kRead | kWrite | kExceptCond
+        kAll = kRead | kWrite | kExceptCond,
+        kEdgeTriggered = 1 << 3,
+        kRecv = 1 << 4
     };
 
+    // enough for any UDP datagram
+    static constexpr std::size_t kMaxDatagramSize = 65536;
+
     ~HandlerSelectBase();
     HandlerSelectBase() = delete;
     HandlerSelectBase(const HandlerSelectBase &);
@@ -44,15 +70,23 @@ class HandlerSelectBase
     HandlerSelectBase(HandlerSelectBase &&);
     HandlerSelectBase &operator=(HandlerSelectBase &&) = delete;
 
-    HandlerSelectBase(uint8_t aEventMask, InDataHandlerT aReadCallback,
+    HandlerSelectBase(uint8_t aEventMask, uint8_t aTypeIndex,
+                      InDataHandlerT aReadCallback,
                       OutDataHandlerT aWriteCallback,
                       ExceptCondHandlerT aExceptCondCallback,
+                      RecvHandlerT aRecvCallback,
                       Context<SysWrapperT> &aContext);
 
     const uint8_t eventMask_;
+    // position of actual handler type in SysWrapperT::HandlersT, 0 if it
+    // isn't listed and must be called through function pointers
+    const uint8_t typeIndex_;
     const InDataHandlerT inDataHandler_ = nullptr;
     const OutDataHandlerT outDataHandler_ = nullptr;
     const ExceptCondHandlerT exceptCondHandler_ = nullptr;
+    const RecvHandlerT recvHandler_ = nullptr;
+    // head of registered sockets of the handler, see SocketBase
+    SocketBase<SysWrapperT> *sockets_ = nullptr;
 
    protected:
     Context<SysWrapperT> &context_;
@@ -64,23 +98,35 @@ HandlerSelectBase<SysWrapperT>::~HandlerSelectBase()
     context_.executor().delHandler(this);
 }
 
+// copy isn't registered for any socket
 template <typename SysWrapperT>
-HandlerSelectBase<SysWrapperT>::HandlerSelectBase(const HandlerSelectBase &) =
-    default;
+HandlerSelectBase<SysWrapperT>::HandlerSelectBase(
+    const HandlerSelectBase &aOther)
+    : HandlerSelectBase(aOther.eventMask_, aOther.typeIndex_,
+                        aOther.inDataHandler_, aOther.outDataHandler_,
+                        aOther.exceptCondHandler_, aOther.recvHandler_,
+                        aOther.context_)
+{
+}
 
 template <typename SysWrapperT>
-HandlerSelectBase<SysWrapperT>::HandlerSelectBase(HandlerSelectBase &&) =
-    default;
+HandlerSelectBase<SysWrapperT>::HandlerSelectBase(
+    HandlerSelectBase &&aOther)
+    : HandlerSelectBase(static_cast<const HandlerSelectBase &>(aOther))
+{
+}
 
 template <typename SysWrapperT>
 HandlerSelectBase<SysWrapperT>::HandlerSelectBase(
-    uint8_t aEventMask, InDataHandlerT aReadCallback,
+    uint8_t aEventMask, uint8_t aTypeIndex, InDataHandlerT aReadCallback,
     OutDataHandlerT aWriteCallback, ExceptCondHandlerT aExceptCondCallback,
-    Context<SysWrapperT> &aContext)
+    RecvHandlerT aRecvCallback, Context<SysWrapperT> &aContext)
     : eventMask_(aEventMask)
+    , typeIndex_(aTypeIndex)
     , inDataHandler_(aReadCallback)
     , outDataHandler_(aWriteCallback)
     , exceptCondHandler_(aExceptCondCallback)
+    , recvHandler_(aRecvCallback)
     , context_(aContext)
 {
 }
@@ -103,22 +149,77 @@ HandlerSelectBase<SysWrapperT>::HandlerSelectBase(
     };
 
 CREATE_MEMBER_METHOD_EXISTANCE_CHECKER(readHandlerImpl);
+CREATE_MEMBER_METHOD_EXISTANCE_CHECKER(edgeReadHandlerImpl);
+CREATE_MEMBER_METHOD_EXISTANCE_CHECKER(recvHandlerImpl);
 CREATE_MEMBER_METHOD_EXISTANCE_CHECKER(writeHandlerImpl);
 CREATE_MEMBER_METHOD_EXISTANCE_CHECKER(exceptionConditionHandlerImpl);
 
+/*! \class HandlerSelect
+    \brief Base class for socket event handlers. Events which executor tracks
+   for the socket are deduced from methods defined in ActualHandlerT:
+   - void readHandlerImpl(ActualSocketT &) - called once per readiness
+   notification;
+   - bool edgeReadHandlerImpl(ActualSocketT &) - opts in edge-triggered mode.
+   Executor keeps calling it while it returns true, so it should read one
+   datagram per call and return false as soon as recvFrom reports
+   operation_would_block. Socket must be non-blocking. Number of calls per
+   executor iteration is limited by ExecutorBase::setReadBudget so that one
+   flooded socket cannot starve the others;
+   - void recvHandlerImpl(ActualSocketT &, const Address &, CBuffer) - receives
+   already read datagram. Completion based executors (ExecutorUring) deliver
+   datagrams straight from the kernel, readiness based executors call
+   recvFrom on behalf of the handler. Data is valid only during the call;
+   - void writeHandlerImpl(ActualSocketT &);
+   - void exceptionConditionHandlerImpl(ActualSocketT &).
+
+   If ActualHandlerT is listed in SysWrapperT::HandlersT executor calls these
+   methods directly instead of through function pointers, see
+   HandlerDispatcher.
+ */
+
 template <typename ActualSocketT, typename ActualHandlerT, typename SysWrapperT>
 class HandlerSelect : public HandlerSelectBase<SysWrapperT>
 {
     using BaseT = HandlerSelectBase<SysWrapperT>;
 
+    template <typename SysWrappersT, typename ListT>
+    friend class HandlerDispatcher;
+
    private:
+    using HandlerSelectT = HandlerSelect;
+
+    static constexpr bool isEdgeTriggered()
+    {
+        return CheckMethod_edgeReadHandlerImpl<ActualHandlerT, bool,
+                                               ActualSocketT &>::value;
+    }
+    static constexpr bool isRecv()
+    {
+        return CheckMethod_recvHandlerImpl<ActualHandlerT, void,
+                                           ActualSocketT &, const Address &,
+                                           CBuffer>::value;
+    }
     static constexpr uint8_t eventMask()
     {
-        constexpr typename BaseT::eTrakingEvents kReadMask =
+        constexpr bool kHasReadHandler =
             CheckMethod_readHandlerImpl<ActualHandlerT, void,
-                                        ActualSocketT &>::value
-                ? BaseT::eTrakingEvents::kRead
-                : BaseT::eTrakingEvents::kNone;
+                                        ActualSocketT &>::value;
+        static_assert(static_cast<int>(kHasReadHandler) +
+                              static_cast<int>(isEdgeTriggered()) +
+                              static_cast<int>(isRecv()) <=
+                          1,
+                      "Handler class must define only one of 'void "
+                      "readHandlerImpl(SocketT&)', 'bool "
+                      "edgeReadHandlerImpl(SocketT&)' or 'void "
+                      "recvHandlerImpl(SocketT&, const Address&, CBuffer)'.");
+        constexpr uint8_t kReadMask =
+            isEdgeTriggered()
+                ? (BaseT::eTrakingEvents::kRead |
+                   BaseT::eTrakingEvents::kEdgeTriggered)
+            : isRecv()
+                ? (BaseT::eTrakingEvents::kRead | BaseT::eTrakingEvents::kRecv)
+                : (kHasReadHandler ? BaseT::eTrakingEvents::kRead
+                                   : BaseT::eTrakingEvents::kNone);
         constexpr typename BaseT::eTrakingEvents kWriteMask =
             CheckMethod_writeHandlerImpl<ActualHandlerT, void,
                                          ActualSocketT &>::value
@@ -131,12 +232,44 @@ class HandlerSelect : public HandlerSelectBase<SysWrapperT>
                 : BaseT::eTrakingEvents::kNone;
         return kReadMask | kWriteMask | kExceptCondMask;
     }
-    static void readHandler(ndt::SocketBase<SysWrapperT> &s, void *aHandler)
+    static bool readHandler(ndt::SocketBase<SysWrapperT> &s, void *aHandler)
     {
-        if constexpr (static_cast<bool>(
-                          eventMask() &
-                          HandlerSelectBase<
-                              SysWrapperT>::eTrakingEvents::kRead))
+        if constexpr (isEdgeTriggered())
+        {
+            ActualSocketT &actualSocket = static_cast<ActualSocketT &>(s);
+            ActualHandlerT *actualHandler =
+                static_cast<ActualHandlerT *>(aHandler);
+            return actualHandler->edgeReadHandlerImpl(actualSocket);
+        }
+        else if constexpr (isRecv())
+        {
+            // readiness based executor, read datagram on behalf of handler
+            char data[BaseT::kMaxDatagramSize];
+            Buffer buf(data);
+            Address sender;
+            std::error_code ec;
+            static_cast<ActualSocketT &>(s).recvFrom(buf, sender, ec);
+            if (ec)
+            {
+                // recvFrom takes pending error of socket, e.g. connection
+                // refused by ICMP, so handler would never see it
+                if ((ec != std::errc::operation_would_block) &&
+                    (ec != std::errc::interrupted))
+                {
+                    static_cast<ActualHandlerT *>(aHandler)
+                        ->context_.executor()
+                        .reportError(ec.value());
+                }
+                return false;
+            }
+            recvHandler(s, aHandler, sender, CBuffer(buf));
+            // blocking socket must not be read again without notification
+            return s.nonBlocking();
+        }
+        else if constexpr (static_cast<bool>(
+                               eventMask() &
+                               HandlerSelectBase<
+                                   SysWrapperT>::eTrakingEvents::kRead))
         {
             ActualSocketT &actualSocket = static_cast<ActualSocketT &>(s);
             ActualHandlerT *actualHandler =
@@ -148,9 +281,23 @@ class HandlerSelect : public HandlerSelectBase<SysWrapperT>
                 eventMask() &
                 HandlerSelectBase<SysWrapperT>::eTrakingEvents::kAll),
             "In order to be not useless handler class must have at least one "
-            "of 'void readHandlerImpl(SocketT&)', 'void "
+            "of 'void readHandlerImpl(SocketT&)', 'bool "
+            "edgeReadHandlerImpl(SocketT&)', 'void "
+            "recvHandlerImpl(SocketT&, const Address&, CBuffer)', 'void "
             "writeHandlerImpl(SocketT&)' or 'void "
             "exceptionConditionHandlerImpl(SocketT&)' methods to be defined.");
+        return false;
+    }
+    static void recvHandler(ndt::SocketBase<SysWrapperT> &s, void *aHandler,
+                            const Address &aSender, CBuffer aData)
+    {
+        if constexpr (isRecv())
+        {
+            ActualSocketT &actualSocket = static_cast<ActualSocketT &>(s);
+            ActualHandlerT *actualHandler =
+                static_cast<ActualHandlerT *>(aHandler);
+            actualHandler->recvHandlerImpl(actualSocket, aSender, aData);
+        }
     }
     static void writeHandler(ndt::SocketBase<SysWrapperT> &s, void *aHandler)
     {
@@ -184,9 +331,13 @@ class HandlerSelect : public HandlerSelectBase<SysWrapperT>
     ~HandlerSelect() = default;
     HandlerSelect(Context<SysWrapperT> &aContext)
         : HandlerSelectBase<SysWrapperT>(
-              eventMask(), &HandlerSelect::readHandler,
+              eventMask(),
+              handlerIndex<ActualHandlerT>(
+                  typename HandlerListOf<SysWrapperT>::type{}),
+              &HandlerSelect::readHandler,
               &HandlerSelect::writeHandler,
-              &HandlerSelect::exceptionConditionHandler, aContext)
+              &HandlerSelect::exceptionConditionHandler,
+              &HandlerSelect::recvHandler, aContext)
     {
     }
     HandlerSelect(const HandlerSelect &) = default;
@@ -0,0 +1,39 @@
+/** @file executor.h
+    @brief Selects event loop backend used by Context.
+
+    epoll is used on Linux. Define NDT_EXECUTOR_IO_URING to use io_uring
+    instead (Linux 6.0+) or NDT_EXECUTOR_SELECT to force select based backend
+    on every platform.
+ */
+#ifndef ndt_executor_h
+#define ndt_executor_h
+
+#include "common.h"
+
+#if defined(NDT_EXECUTOR_IO_URING)
+#if !defined(NDT_HAS_IO_URING)
+#error "io_uring executor requires Linux with <linux/io_uring.h>"
+#endif
+#include "executor_uring.h"
+#elif defined(__linux__) && !defined(NDT_EXECUTOR_SELECT)
+#define NDT_EXECUTOR_EPOLL
+#include "executor_epoll.h"
+#else
+#include "executor_select.h"
+#endif
+
+namespace ndt
+{
+#if defined(NDT_EXECUTOR_IO_URING)
+template <typename SysWrapperT>
+using Executor = ExecutorUring<SysWrapperT>;
+#elif defined(NDT_EXECUTOR_EPOLL)
+template <typename SysWrapperT>
+using Executor = ExecutorEpoll<SysWrapperT>;
+#else
+template <typename SysWrapperT>
+using Executor = ExecutorSelect<SysWrapperT>;
+#endif
+}  // namespace ndt
+
+#endif /* ndt_executor_h */
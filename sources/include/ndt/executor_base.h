@@ -0,0 +1,823 @@
+#ifndef ndt_executor_base_h
+#define ndt_executor_base_h
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "common.h"
+#include "event_handler_select.h"
+#include "executor_stats.h"
+#include "handler_dispatcher.h"
+#include "mpsc_queue.h"
+#include "socket.h"
+#include "waker.h"
+
+namespace ndt
+{
+template <typename SysWrapperT>
+class SocketBase;
+
+/*! \enum eWaitMode
+    \brief How executor waits for events:
+   - kBlocking - wait blocks until events are ready or timeout expires;
+   - kBusyPoll - every wait is a zero-timeout poll, events are picked up
+   without wakeup latency at the cost of a fully loaded core;
+   - kAdaptive - after the last event executor busy polls for spin period,
+   then polls yielding the thread for yield period, then blocks as kBlocking.
+ */
+enum class eWaitMode : uint8_t
+{
+    kBlocking = 0,
+    kBusyPoll,
+    kAdaptive
+};
+
+/*! \struct DeferredCall
+    \brief Intrusive node of executor's list of calls made on executor's
+   thread right after ready events of current iteration are dispatched, see
+   ExecutorBase::defer. Node must stay alive until it is called.
+ */
+struct DeferredCall
+{
+    using CallT = void (*)(DeferredCall &);
+
+    DeferredCall *next_ = nullptr;
+    CallT call_ = nullptr;
+};
+
+/*! \class PriorityBuckets
+    \brief Ready events of one executor iteration grouped by priority class
+   of their sockets. Buckets keep their capacity, so warmed up executor
+   doesn't allocate.
+ */
+template <typename ReadyT>
+class PriorityBuckets final
+{
+   public:
+    void push(const ePriority aPriority, const ReadyT &aReady)
+    {
+        buckets_[static_cast<std::size_t>(aPriority)].push_back(aReady);
+    }
+
+    // calls aFunc(priority, ready) for every event, higher classes first,
+    // and empties the buckets
+    template <typename FuncT>
+    void drain(FuncT &&aFunc)
+    {
+        for (std::size_t i = 0; i < kPriorityCount; ++i)
+        {
+            for (const ReadyT &ready: buckets_[i])
+            {
+                aFunc(static_cast<ePriority>(i), ready);
+            }
+            buckets_[i].clear();
+        }
+    }
+
+   private:
+    std::array<std::vector<ReadyT>, kPriorityCount> buckets_;
+};
+
+/*! \class ExecutorBase
+    \brief Part of the event loop shared by all executor backends: socket
+   registration entry points, timeout settings, timeout/error handlers and
+   dispatching of ready events to HandlerSelect callbacks.
+
+   Every iteration returns number of handled events: ready sockets, received
+   datagrams and posted handlers. Backends stop dispatching when
+   isEventLimitReached() and keep the rest for subsequent iterations. Ready
+   sockets are dispatched by their priority classes, higher first, and
+   backends keep events of class which reached its limit the same way, see
+   isLimitReached().
+
+   ImplT must provide:
+   - int waitImpl() - blocks until events are ready or timeout expires and
+   returns number of ready events, 0 on timeout or kSocketError on failure;
+   - void dispatchImpl(const int aResult) - calls dispatch() for every ready
+   socket. dispatch() returns true if edge-triggered socket used up its read
+   budget and has to be drained again without waiting for a new
+   notification;
+   - void registerSocketImpl(SocketBase<SysWrapperT> *aSocket);
+   - void unregisterSocketImpl(SocketBase<SysWrapperT> const *aSocket).
+
+   Sockets of removed handler are unregistered one by one, executor finds
+   them in handler's list of registered sockets.
+
+   ImplT may override:
+   - void updateSocketImpl(SocketBase<SysWrapperT> *aSocket) - applies
+   changed SocketBase::eventMask() of registered socket, by default socket is
+   registered again;
+   - void postSendToImpl(SocketBase<SysWrapperT> &, const Address &, CBuffer,
+   std::error_code &) - by default datagram is sent immediately;
+   - void flushImpl() - submits datagrams queued by postSendToImpl;
+   - void watchWakeupImpl(const sock_t aHandle) - starts watching descriptor
+   of the waker for reading, called once when waker is opened. Readiness of
+   the waker is counted by waitImpl as an event, dispatchImpl drains it.
+
+   Handlers are called through HandlerDispatcher, so handler types listed in
+   SysWrapperT::HandlersT are dispatched statically by every backend.
+
+   If NDT_EXECUTOR_STATS is defined executor measures its iterations and
+   handler calls, see stats().
+
+   post and wakeup are the only members which can be called from any thread.
+   Posted handlers are called on executor's thread at the end of iteration,
+   waker interrupts the wait so that they are not delayed by timeout.
+ */
+template <typename ImplT, typename SysWrapperT>
+class ExecutorBase
+{
+    // reports errors of datagrams it reads on behalf of recv handlers
+    template <typename SocketT, typename HandlerT, typename SysWrappersT>
+    friend class HandlerSelect;
+
+   public:
+    std::size_t operator()();
+
+    void addSocket(SocketBase<SysWrapperT> *aSocket);
+    // applies changed interest of registered socket
+    void updateSocket(SocketBase<SysWrapperT> *aSocket);
+    void delHandler(HandlerSelectBase<SysWrapperT> *aHandler);
+    void delSocket(SocketBase<SysWrapperT> *aSocket);
+
+    void postSendTo(SocketBase<SysWrapperT> &aSocket, const Address &aDst,
+                    CBuffer aBuf, std::error_code &aEc);
+    void flush();
+
+    // Not thread-safe. Unlike post doesn't allocate, call is made once
+    // current dispatch pass is over, so it may destroy sockets and handlers
+    // which were being dispatched.
+    void defer(DeferredCall &aCall) noexcept;
+
+    // thread-safe
+    void post(std::function<void()> aHandler);
+    void wakeup() noexcept;
+
+    inline timeval const *timeout() const noexcept;
+    void setTimeout(const timeval aTimeout) noexcept;
+    void setTimeoutInfinite() noexcept;
+
+    void setTimeoutHandler(
+        const std::function<void()> aTimeoutHandler) noexcept;
+    void setErrorHandler(
+        const std::function<void(std::error_code aEc)> aErrorHandler) noexcept;
+
+    std::size_t readBudget() const noexcept;
+    void setReadBudget(const std::size_t aBudget) noexcept;
+
+    // Caps the wait of the next iteration only, e.g. by the nearest timer
+    // expiry. Timeout handler isn't called if the wait ends because of the
+    // cap rather than the timeout set by setTimeout.
+    void limitWait(const std::chrono::microseconds aLimit) noexcept;
+    // Caps number of events handled by the next iteration only.
+    void limitEvents(const std::size_t aLimit) noexcept;
+    // Caps number of events of sockets of priority class handled by every
+    // iteration, so that bulk traffic can't hold up the loop. Events above
+    // the cap are handled by subsequent iterations, which don't wait while
+    // there are any. No class is capped by default.
+    void setPriorityLimit(const ePriority aPriority,
+                          const std::size_t aLimit) noexcept;
+    std::size_t priorityLimit(const ePriority aPriority) const noexcept;
+
+    // Timeout handler is called in polling modes too, after timeout elapsed
+    // without any events. Sockets may additionally be switched to busy
+    // polling of device queue by SocketBase::busyPoll.
+    void setWaitMode(const eWaitMode aMode) noexcept;
+    eWaitMode waitMode() const noexcept;
+    void setAdaptivePeriods(
+        const std::chrono::microseconds aSpinPeriod,
+        const std::chrono::microseconds aYieldPeriod) noexcept;
+
+#if defined(NDT_EXECUTOR_STATS)
+    // can be called from any thread
+    ExecutorStatsSnapshot stats() const noexcept;
+#endif
+
+    static constexpr std::size_t kDefaultReadBudget = 64;
+    // handlers posted faster than this are left for the next iteration, so
+    // that posting thread can't starve sockets
+    static constexpr std::size_t kMaxPostedPerIteration = 1024;
+    static constexpr std::size_t kNoEventLimit =
+        std::numeric_limits<std::size_t>::max();
+    static constexpr std::chrono::microseconds kDefaultSpinPeriod{50};
+    static constexpr std::chrono::microseconds kDefaultYieldPeriod{1000};
+
+   protected:
+    using EventsT = typename HandlerSelectBase<SysWrapperT>::eTrakingEvents;
+    using DispatcherT = HandlerDispatcher<SysWrapperT>;
+
+    ~ExecutorBase();
+    ExecutorBase() noexcept;
+
+    inline ImplT &impl() noexcept;
+    // effective timeout of current wait, nullptr if it is infinite
+    timeval const *waitTimeout() noexcept;
+    int timeoutMs() noexcept;
+    std::size_t eventLimit() const noexcept;
+    bool isEventLimitReached() const noexcept;
+    // event limit of iteration or limit of priority class is reached
+    bool isLimitReached(const ePriority aPriority) const noexcept;
+    void reportError(const int aErrorCode);
+    bool dispatch(SocketBase<SysWrapperT> *aSocket, const uint8_t aEvents);
+    void dispatchDatagram(SocketBase<SysWrapperT> *aSocket,
+                          const Address &aSender, CBuffer aData);
+
+    void updateSocketImpl(SocketBase<SysWrapperT> *aSocket);
+    void postSendToImpl(SocketBase<SysWrapperT> &aSocket, const Address &aDst,
+                        CBuffer aBuf, std::error_code &aEc);
+    void flushImpl() noexcept;
+    void watchWakeupImpl(const sock_t aHandle) noexcept;
+
+    void prepareWakeup();
+    bool preparePolling();
+    bool isPollingTimeout();
+    void runDeferred();
+    void runPosted();
+
+    timeval masterTimeout_ = {0, 0};
+    bool infiniteTimeout_ = false;
+    std::size_t readBudget_ = kDefaultReadBudget;
+    timeval waitLimit_ = {0, 0};
+    bool hasWaitLimit_ = false;
+    bool isWaitLimited_ = false;
+    std::size_t eventLimit_ = kNoEventLimit;
+    std::size_t handledCount_ = 0;
+    std::array<std::size_t, kPriorityCount> priorityLimits_ = {
+        kNoEventLimit, kNoEventLimit, kNoEventLimit};
+    std::array<std::size_t, kPriorityCount> handledByPriority_ = {};
+    eWaitMode waitMode_ = eWaitMode::kBlocking;
+    std::chrono::microseconds spinPeriod_ = kDefaultSpinPeriod;
+    std::chrono::microseconds yieldPeriod_ = kDefaultYieldPeriod;
+    // used by polling modes only
+    std::chrono::steady_clock::time_point lastEventTime_;
+    std::chrono::steady_clock::time_point lastTimeoutTime_;
+    std::function<void()> timeoutHandler_ = []() {};
+    std::function<void(std::error_code aEc)> errorHandler_ =
+        [](std::error_code) {};
+    DeferredCall *deferredHead_ = nullptr;
+    DeferredCall *deferredTail_ = nullptr;
+    MpscQueue<std::function<void()>> posted_;
+    Waker<SysWrapperT> waker_;
+    // set by wakeup until posted handlers are run, waker is notified only
+    // by the first wakeup after that
+    std::atomic_bool isWakeupPending_ = false;
+#if defined(NDT_EXECUTOR_STATS)
+    ExecutorStats stats_;
+#endif
+};
+
+template <typename ImplT, typename SysWrapperT>
+ExecutorBase<ImplT, SysWrapperT>::~ExecutorBase() = default;
+
+template <typename ImplT, typename SysWrapperT>
+ExecutorBase<ImplT, SysWrapperT>::ExecutorBase() noexcept = default;
+
+template <typename ImplT, typename SysWrapperT>
+ImplT &ExecutorBase<ImplT, SysWrapperT>::impl() noexcept
+{
+    return static_cast<ImplT &>(*this);
+}
+
+template <typename ImplT, typename SysWrapperT>
+std::size_t ExecutorBase<ImplT, SysWrapperT>::operator()()
+{
+    prepareWakeup();
+    const bool isPolling = preparePolling();
+    handledCount_ = 0;
+    handledByPriority_.fill(0);
+    NDT_STATS_ONLY(const auto waitStart = ExecutorStats::ClockT::now();)
+    const int result = impl().waitImpl();
+    NDT_STATS_ONLY(const auto dispatchStart = ExecutorStats::ClockT::now();
+                   stats_.onWait(waitStart, dispatchStart, result);)
+    hasWaitLimit_ = false;
+    if (result != kSocketError)
+    {
+        if (result)
+        {
+            // handle events
+            impl().dispatchImpl(result);
+        }
+        else if (isPolling ? isPollingTimeout() : !isWaitLimited_)
+        {
+            // handle timeout
+            NDT_STATS_ONLY(stats_.onTimeout();)
+            timeoutHandler_();
+        }
+    }
+    else
+    {
+        // handle error
+        NDT_STATS_ONLY(stats_.onError();)
+        reportError(SysWrapperT::lastErrorCode());
+    }
+    runDeferred();
+    runPosted();
+    if ((waitMode_ != eWaitMode::kBlocking) && handledCount_)
+    {
+        lastEventTime_ = std::chrono::steady_clock::now();
+    }
+    NDT_STATS_ONLY(stats_.onDispatch(dispatchStart);)
+    eventLimit_ = kNoEventLimit;
+    return handledCount_;
+}
+
+template <typename ImplT, typename SysWrapperT>
+void ExecutorBase<ImplT, SysWrapperT>::addSocket(
+    SocketBase<SysWrapperT> *aSocket)
+{
+    if ((aSocket == nullptr) || !aSocket->isOpen() ||
+        (aSocket->handler() == nullptr))
+    {
+        return;
+    }
+    aSocket->linkHandler();
+    impl().registerSocketImpl(aSocket);
+}
+
+template <typename ImplT, typename SysWrapperT>
+void ExecutorBase<ImplT, SysWrapperT>::updateSocket(
+    SocketBase<SysWrapperT> *aSocket)
+{
+    if ((aSocket == nullptr) || !aSocket->isOpen() ||
+        (aSocket->handler() == nullptr))
+    {
+        return;
+    }
+    impl().updateSocketImpl(aSocket);
+}
+
+template <typename ImplT, typename SysWrapperT>
+void ExecutorBase<ImplT, SysWrapperT>::delHandler(
+    HandlerSelectBase<SysWrapperT> *aHandler)
+{
+    if (!aHandler)
+    {
+        return;
+    }
+    while (SocketBase<SysWrapperT> *socket = aHandler->sockets_)
+    {
+        socket->unlinkHandler();
+        socket->handler_ = nullptr;
+        impl().unregisterSocketImpl(socket);
+    }
+}
+
+template <typename ImplT, typename SysWrapperT>
+void ExecutorBase<ImplT, SysWrapperT>::delSocket(
+    SocketBase<SysWrapperT> *aSocket)
+{
+    if ((aSocket == nullptr) || !aSocket->isOpen() ||
+        (aSocket->handler() == nullptr))
+    {
+        return;
+    }
+    aSocket->unlinkHandler();
+    impl().unregisterSocketImpl(aSocket);
+}
+
+template <typename ImplT, typename SysWrapperT>
+void ExecutorBase<ImplT, SysWrapperT>::postSendTo(
+    SocketBase<SysWrapperT> &aSocket, const Address &aDst, CBuffer aBuf,
+    std::error_code &aEc)
+{
+    impl().postSendToImpl(aSocket, aDst, aBuf, aEc);
+}
+
+template <typename ImplT, typename SysWrapperT>
+void ExecutorBase<ImplT, SysWrapperT>::flush()
+{
+    impl().flushImpl();
+}
+
+template <typename ImplT, typename SysWrapperT>
+void ExecutorBase<ImplT, SysWrapperT>::defer(DeferredCall &aCall) noexcept
+{
+    assert(aCall.call_ && "Error: deferred call must have a function");
+    aCall.next_ = nullptr;
+    if (deferredTail_)
+    {
+        deferredTail_->next_ = &aCall;
+    }
+    else
+    {
+        deferredHead_ = &aCall;
+    }
+    deferredTail_ = &aCall;
+}
+
+template <typename ImplT, typename SysWrapperT>
+void ExecutorBase<ImplT, SysWrapperT>::post(std::function<void()> aHandler)
+{
+    posted_.push(std::move(aHandler));
+    wakeup();
+}
+
+template <typename ImplT, typename SysWrapperT>
+void ExecutorBase<ImplT, SysWrapperT>::wakeup() noexcept
+{
+    if (!isWakeupPending_.exchange(true))
+    {
+        waker_.notify();
+    }
+}
+
+template <typename ImplT, typename SysWrapperT>
+timeval const *ExecutorBase<ImplT, SysWrapperT>::timeout() const noexcept
+{
+    return infiniteTimeout_ ? nullptr : &masterTimeout_;
+}
+
+template <typename ImplT, typename SysWrapperT>
+void ExecutorBase<ImplT, SysWrapperT>::setTimeout(
+    const timeval aTimeout) noexcept
+{
+    masterTimeout_ = aTimeout;
+    infiniteTimeout_ = false;
+}
+
+template <typename ImplT, typename SysWrapperT>
+void ExecutorBase<ImplT, SysWrapperT>::setTimeoutInfinite() noexcept
+{
+    infiniteTimeout_ = true;
+}
+
+template <typename ImplT, typename SysWrapperT>
+void ExecutorBase<ImplT, SysWrapperT>::setTimeoutHandler(
+    const std::function<void()> aTimeoutHandler) noexcept
+{
+    if (aTimeoutHandler)
+    {
+        timeoutHandler_ = aTimeoutHandler;
+    }
+    else
+    {
+        timeoutHandler_ = []() {};
+    }
+}
+
+template <typename ImplT, typename SysWrapperT>
+void ExecutorBase<ImplT, SysWrapperT>::setErrorHandler(
+    const std::function<void(std::error_code aEc)> aErrorHandler) noexcept
+{
+    if (aErrorHandler)
+    {
+        errorHandler_ = aErrorHandler;
+    }
+    else
+    {
+        errorHandler_ = [](std::error_code) {};
+    }
+}
+
+template <typename ImplT, typename SysWrapperT>
+std::size_t ExecutorBase<ImplT, SysWrapperT>::readBudget() const noexcept
+{
+    return readBudget_;
+}
+
+template <typename ImplT, typename SysWrapperT>
+void ExecutorBase<ImplT, SysWrapperT>::setReadBudget(
+    const std::size_t aBudget) noexcept
+{
+    readBudget_ = aBudget ? aBudget : 1;
+}
+
+template <typename ImplT, typename SysWrapperT>
+void ExecutorBase<ImplT, SysWrapperT>::limitWait(
+    const std::chrono::microseconds aLimit) noexcept
+{
+    const auto usec = std::max<long long>(aLimit.count(), 0);
+    waitLimit_.tv_sec =
+        static_cast<decltype(waitLimit_.tv_sec)>(usec / 1000000);
+    waitLimit_.tv_usec =
+        static_cast<decltype(waitLimit_.tv_usec)>(usec % 1000000);
+    hasWaitLimit_ = true;
+}
+
+template <typename ImplT, typename SysWrapperT>
+void ExecutorBase<ImplT, SysWrapperT>::limitEvents(
+    const std::size_t aLimit) noexcept
+{
+    eventLimit_ = aLimit ? aLimit : 1;
+}
+
+template <typename ImplT, typename SysWrapperT>
+void ExecutorBase<ImplT, SysWrapperT>::setPriorityLimit(
+    const ePriority aPriority, const std::size_t aLimit) noexcept
+{
+    priorityLimits_[static_cast<std::size_t>(aPriority)] =
+        aLimit ? aLimit : 1;
+}
+
+template <typename ImplT, typename SysWrapperT>
+std::size_t ExecutorBase<ImplT, SysWrapperT>::priorityLimit(
+    const ePriority aPriority) const noexcept
+{
+    return priorityLimits_[static_cast<std::size_t>(aPriority)];
+}
+
+template <typename ImplT, typename SysWrapperT>
+timeval const *ExecutorBase<ImplT, SysWrapperT>::waitTimeout() noexcept
+{
+    const auto toUsec = [](const timeval &aValue) {
+        return static_cast<long long>(aValue.tv_sec) * 1000000 +
+               static_cast<long long>(aValue.tv_usec);
+    };
+    isWaitLimited_ =
+        hasWaitLimit_ &&
+        (infiniteTimeout_ || (toUsec(waitLimit_) < toUsec(masterTimeout_)));
+    if (isWaitLimited_)
+    {
+        return &waitLimit_;
+    }
+    return infiniteTimeout_ ? nullptr : &masterTimeout_;
+}
+
+template <typename ImplT, typename SysWrapperT>
+int ExecutorBase<ImplT, SysWrapperT>::timeoutMs() noexcept
+{
+    timeval const *timeout = waitTimeout();
+    if (!timeout)
+    {
+        return -1;
+    }
+    // round up so that a non-zero timeout never degrades into busy polling
+    const auto usec = static_cast<long long>(timeout->tv_sec) * 1000000 +
+                      static_cast<long long>(timeout->tv_usec);
+    return static_cast<int>((usec + 999) / 1000);
+}
+
+template <typename ImplT, typename SysWrapperT>
+void ExecutorBase<ImplT, SysWrapperT>::setWaitMode(
+    const eWaitMode aMode) noexcept
+{
+    waitMode_ = aMode;
+    lastEventTime_ = std::chrono::steady_clock::now();
+    lastTimeoutTime_ = lastEventTime_;
+}
+
+template <typename ImplT, typename SysWrapperT>
+eWaitMode ExecutorBase<ImplT, SysWrapperT>::waitMode() const noexcept
+{
+    return waitMode_;
+}
+
+template <typename ImplT, typename SysWrapperT>
+void ExecutorBase<ImplT, SysWrapperT>::setAdaptivePeriods(
+    const std::chrono::microseconds aSpinPeriod,
+    const std::chrono::microseconds aYieldPeriod) noexcept
+{
+    spinPeriod_ = aSpinPeriod;
+    yieldPeriod_ = aYieldPeriod;
+}
+
+#if defined(NDT_EXECUTOR_STATS)
+template <typename ImplT, typename SysWrapperT>
+ExecutorStatsSnapshot ExecutorBase<ImplT, SysWrapperT>::stats() const noexcept
+{
+    return stats_.snapshot();
+}
+#endif
+
+template <typename ImplT, typename SysWrapperT>
+std::size_t ExecutorBase<ImplT, SysWrapperT>::eventLimit() const noexcept
+{
+    return eventLimit_;
+}
+
+template <typename ImplT, typename SysWrapperT>
+bool ExecutorBase<ImplT, SysWrapperT>::isEventLimitReached() const noexcept
+{
+    return handledCount_ >= eventLimit_;
+}
+
+template <typename ImplT, typename SysWrapperT>
+bool ExecutorBase<ImplT, SysWrapperT>::isLimitReached(
+    const ePriority aPriority) const noexcept
+{
+    const auto i = static_cast<std::size_t>(aPriority);
+    return isEventLimitReached() ||
+           (handledByPriority_[i] >= priorityLimits_[i]);
+}
+
+template <typename ImplT, typename SysWrapperT>
+void ExecutorBase<ImplT, SysWrapperT>::reportError(const int aErrorCode)
+{
+    errorHandler_(std::error_code(aErrorCode, std::system_category()));
+}
+
+template <typename ImplT, typename SysWrapperT>
+bool ExecutorBase<ImplT, SysWrapperT>::dispatch(
+    SocketBase<SysWrapperT> *aSocket, const uint8_t aEvents)
+{
+    // Every callback may remove socket from executor, so handler must be
+    // checked before each call. Readiness may be reported before interest
+    // was switched off, e.g. by previous handler, so interest is checked as
+    // well. Socket whose reading is paused is re-armed by executor when
+    // reading is resumed.
+    if (!(aEvents & aSocket->interest()))
+    {
+        return false;
+    }
+    ++handledCount_;
+    ++handledByPriority_[static_cast<std::size_t>(aSocket->priority())];
+    bool mayHaveMore = false;
+    if (aEvents & EventsT::kRead)
+    {
+        // data can be read from socket without blocking, edge-triggered
+        // handler is called until it drains the socket or runs out of budget
+        std::size_t budget = readBudget_;
+        HandlerSelectBase<SysWrapperT> *handler = nullptr;
+        while ((handler = aSocket->handler_) && aSocket->readInterest())
+        {
+            NDT_STATS_ONLY(const auto start = ExecutorStats::ClockT::now();)
+            mayHaveMore = DispatcherT::inData(*aSocket, handler);
+            NDT_STATS_ONLY(stats_.onHandler(start);)
+            if (!mayHaveMore || (--budget == 0))
+            {
+                break;
+            }
+        }
+        mayHaveMore = mayHaveMore && aSocket->readInterest();
+    }
+    if ((aEvents & EventsT::kWrite) && aSocket->writeInterest())
+    {
+        // data can be written to socket without blocking
+        if (HandlerSelectBase<SysWrapperT> *handler = aSocket->handler_)
+        {
+            NDT_STATS_ONLY(const auto start = ExecutorStats::ClockT::now();)
+            DispatcherT::outData(*aSocket, handler);
+            NDT_STATS_ONLY(stats_.onHandler(start);)
+        }
+    }
+    if ((aEvents & EventsT::kExceptCond) &&
+        (aSocket->interest() & kInterestExceptCond))
+    {
+        // exception conditions occured in this socket can be handled
+        // without blocking
+        if (HandlerSelectBase<SysWrapperT> *handler = aSocket->handler_)
+        {
+            NDT_STATS_ONLY(const auto start = ExecutorStats::ClockT::now();)
+            DispatcherT::exceptCond(*aSocket, handler);
+            NDT_STATS_ONLY(stats_.onHandler(start);)
+        }
+    }
+    return mayHaveMore;
+}
+
+template <typename ImplT, typename SysWrapperT>
+void ExecutorBase<ImplT, SysWrapperT>::dispatchDatagram(
+    SocketBase<SysWrapperT> *aSocket, const Address &aSender, CBuffer aData)
+{
+    ++handledCount_;
+    ++handledByPriority_[static_cast<std::size_t>(aSocket->priority())];
+    if (HandlerSelectBase<SysWrapperT> *handler = aSocket->handler_)
+    {
+        NDT_STATS_ONLY(const auto start = ExecutorStats::ClockT::now();)
+        DispatcherT::recv(*aSocket, handler, aSender, aData);
+        NDT_STATS_ONLY(stats_.onHandler(start);)
+    }
+}
+
+template <typename ImplT, typename SysWrapperT>
+void ExecutorBase<ImplT, SysWrapperT>::updateSocketImpl(
+    SocketBase<SysWrapperT> *aSocket)
+{
+    impl().registerSocketImpl(aSocket);
+}
+
+template <typename ImplT, typename SysWrapperT>
+void ExecutorBase<ImplT, SysWrapperT>::postSendToImpl(
+    SocketBase<SysWrapperT> &aSocket, const Address &aDst, CBuffer aBuf,
+    std::error_code &aEc)
+{
+    aSocket.sendTo(aDst, aBuf, aEc);
+}
+
+template <typename ImplT, typename SysWrapperT>
+void ExecutorBase<ImplT, SysWrapperT>::flushImpl() noexcept
+{
+}
+
+template <typename ImplT, typename SysWrapperT>
+void ExecutorBase<ImplT, SysWrapperT>::watchWakeupImpl(const sock_t) noexcept
+{
+}
+
+template <typename ImplT, typename SysWrapperT>
+void ExecutorBase<ImplT, SysWrapperT>::prepareWakeup()
+{
+    // waker is opened lazily by the thread which runs executor, so that
+    // contexts which are never run don't consume descriptors
+    if (!waker_.isOpen())
+    {
+        if (!waker_.open())
+        {
+            reportError(SysWrapperT::lastErrorCode());
+        }
+        else
+        {
+            impl().watchWakeupImpl(waker_.nativeHandle());
+        }
+    }
+    // wakeup made before waker was opened didn't notify it
+    if (isWakeupPending_)
+    {
+        limitWait(std::chrono::milliseconds(0));
+    }
+}
+
+template <typename ImplT, typename SysWrapperT>
+bool ExecutorBase<ImplT, SysWrapperT>::preparePolling()
+{
+    if (waitMode_ == eWaitMode::kBlocking)
+    {
+        return false;
+    }
+    if (waitMode_ == eWaitMode::kAdaptive)
+    {
+        const auto idle = std::chrono::steady_clock::now() - lastEventTime_;
+        if (idle >= spinPeriod_ + yieldPeriod_)
+        {
+            return false;
+        }
+        if (idle >= spinPeriod_)
+        {
+            std::this_thread::yield();
+        }
+    }
+    limitWait(std::chrono::microseconds(0));
+    return true;
+}
+
+template <typename ImplT, typename SysWrapperT>
+bool ExecutorBase<ImplT, SysWrapperT>::isPollingTimeout()
+{
+    // zero-timeout polls never time out by themselves, timeout is measured
+    // from the last event or the last reported timeout
+    if (infiniteTimeout_)
+    {
+        return false;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    const auto timeout = std::chrono::seconds(masterTimeout_.tv_sec) +
+                         std::chrono::microseconds(masterTimeout_.tv_usec);
+    if (now - std::max(lastEventTime_, lastTimeoutTime_) < timeout)
+    {
+        return false;
+    }
+    lastTimeoutTime_ = now;
+    return true;
+}
+
+template <typename ImplT, typename SysWrapperT>
+void ExecutorBase<ImplT, SysWrapperT>::runDeferred()
+{
+    // calls deferred by deferred calls are made during the same pass
+    while (DeferredCall *call = deferredHead_)
+    {
+        deferredHead_ = call->next_;
+        if (!deferredHead_)
+        {
+            deferredTail_ = nullptr;
+        }
+        call->next_ = nullptr;
+        call->call_(*call);
+    }
+}
+
+template <typename ImplT, typename SysWrapperT>
+void ExecutorBase<ImplT, SysWrapperT>::runPosted()
+{
+    isWakeupPending_ = false;
+    for (std::size_t i = 0;
+         (i < kMaxPostedPerIteration) && !isEventLimitReached(); ++i)
+    {
+        auto handler = posted_.pop();
+        if (!handler)
+        {
+            return;
+        }
+        ++handledCount_;
+        NDT_STATS_ONLY(const auto start = ExecutorStats::ClockT::now();)
+        (*handler)();
+        NDT_STATS_ONLY(stats_.onHandler(start);)
+    }
+    // don't block on the next wait while there are handlers left
+    if (!posted_.empty())
+    {
+        isWakeupPending_ = true;
+    }
+}
+}  // namespace ndt
+
+#endif /* ndt_executor_base_h */
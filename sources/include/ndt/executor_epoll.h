@@ -0,0 +1,8 @@
+#ifndef ndt_executor_epoll_h
+#define ndt_executor_epoll_h
+
+#if defined(__linux__)
+#include "platform/linux/executor_epoll_impl.h"
+#endif
+
+#endif /* ndt_executor_epoll_h */
@@ -2,11 +2,10 @@
 #define ndt_executor_select_base_h
 
 #include <array>
-#include <functional>
-#include <system_error>
 
 #include "common.h"
 #include "event_handler_select.h"
+#include "executor_base.h"
 #include "socket.h"
 
 #ifndef FD_COPY
@@ -19,25 +18,11 @@ template <typename SysWrapperT>
 class SocketBase;
 
 template <typename ImplT, typename SysWrapperT>
-class ExecutorSelectBase
+class ExecutorSelectBase : public ExecutorBase<ImplT, SysWrapperT>
 {
+    friend class ExecutorBase<ImplT, SysWrapperT>;
     friend class ExecutorSelect<SysWrapperT>;
-
-   public:
-    void operator()();
-
-    void addSocket(SocketBase<SysWrapperT> *aSocket);
-    void delHandler(HandlerSelectBase<SysWrapperT> *aHandler);
-    void delSocket(SocketBase<SysWrapperT> const *aSocket);
-
-    inline timeval const *timeout() const noexcept;
-    void setTimeout(const timeval aTimeout) noexcept;
-    void setTimeoutInfinite() noexcept;
-
-    void setTimeoutHandler(
-        const std::function<void()> aTimeoutHandler) noexcept;
-    void setErrorHandler(
-        const std::function<void(std::error_code aEc)> aErrorHandler) noexcept;
+    using BaseT = ExecutorBase<ImplT, SysWrapperT>;
 
    protected:
     ~ExecutorSelectBase();
@@ -45,11 +30,23 @@ class ExecutorSelectBase
     static void setFlag(const sock_t aSocketHandle, const bool aState,
                         fd_set *aFDs) noexcept;
 
-    inline ImplT &impl() noexcept;
     bool isTracked(const sock_t aHandle) const noexcept;
     void initSelectArgs() noexcept;
     void iterateResult(const int aResult);
 
+    int waitImpl() noexcept;
+    void dispatchImpl(const int aResult);
+    void registerSocketImpl(SocketBase<SysWrapperT> *aSocket);
+    void updateSocketImpl(SocketBase<SysWrapperT> *aSocket);
+    void unregisterSocketImpl(SocketBase<SysWrapperT> const *aSocket);
+
+    struct ReadySocket
+    {
+        std::size_t index;
+        sock_t handle;
+        uint8_t events;
+    };
+
     static constexpr int kMaxFDCount = FD_SETSIZE;
     fd_set masterReadFDs_;
     fd_set masterWriteFDs_;
@@ -60,11 +57,7 @@ class ExecutorSelectBase
     fd_set exceptfds_;
     timeval *timeoutPtr_ = nullptr;
     timeval timeout_ = {0, 0};
-    timeval masterTimeout_ = {0, 0};
-    bool infiniteTimeout_ = false;
-    std::function<void()> timeoutHandler_ = []() {};
-    std::function<void(std::error_code aEc)> errorHandler_ =
-        [](std::error_code) {};
+    PriorityBuckets<ReadySocket> ready_;
 };
 
 template <typename ImplT, typename SysWrapperT>
@@ -79,139 +72,49 @@ ExecutorSelectBase<ImplT, SysWrapperT>::ExecutorSelectBase() noexcept
 }
 
 template <typename ImplT, typename SysWrapperT>
-ImplT &ExecutorSelectBase<ImplT, SysWrapperT>::impl() noexcept
+int ExecutorSelectBase<ImplT, SysWrapperT>::waitImpl() noexcept
 {
-    return static_cast<ImplT &>(*this);
+    initSelectArgs();
+    return BaseT::impl().selectImpl();
 }
 
 template <typename ImplT, typename SysWrapperT>
-void ExecutorSelectBase<ImplT, SysWrapperT>::operator()()
+void ExecutorSelectBase<ImplT, SysWrapperT>::dispatchImpl(const int aResult)
 {
-    initSelectArgs();
-
-    const int result = impl().selectImpl();
-    if (result != kSocketError)
-    {
-        if (result)
-        {
-            // handle events
-            iterateResult(result);
-        }
-        else
-        {
-            // handle timeout
-            timeoutHandler_();
-        }
-    }
-    else
-    {
-        // handle error
-        errorHandler_(std::error_code(SysWrapperT::lastErrorCode(),
-                                      std::system_category()));
-    }
+    iterateResult(aResult);
 }
 
 template <typename ImplT, typename SysWrapperT>
-void ExecutorSelectBase<ImplT, SysWrapperT>::addSocket(
+void ExecutorSelectBase<ImplT, SysWrapperT>::registerSocketImpl(
     SocketBase<SysWrapperT> *aSocket)
 {
-    if ((aSocket == nullptr) || !aSocket->isOpen() ||
-        (aSocket->handler() == nullptr))
-    {
-        return;
-    }
-
-    const auto socketHandle = aSocket->nativeHandle();
-    const auto eventMask = aSocket->handler()->eventMask_;
-
-    setFlag(socketHandle,
-            HandlerSelectBase<SysWrapperT>::eTrakingEvents::kRead & eventMask,
-            &masterReadFDs_);
-    setFlag(socketHandle,
-            HandlerSelectBase<SysWrapperT>::eTrakingEvents::kWrite & eventMask,
-            &masterWriteFDs_);
-    setFlag(
-        socketHandle,
-        HandlerSelectBase<SysWrapperT>::eTrakingEvents::kExceptCond & eventMask,
-        &masterExceptFDs_);
-
-    impl().addSocketImpl(aSocket);
+    updateSocketImpl(aSocket);
+    BaseT::impl().addSocketImpl(aSocket);
 }
 
 template <typename ImplT, typename SysWrapperT>
-void ExecutorSelectBase<ImplT, SysWrapperT>::delHandler(
-    HandlerSelectBase<SysWrapperT> *aHandler)
+void ExecutorSelectBase<ImplT, SysWrapperT>::updateSocketImpl(
+    SocketBase<SysWrapperT> *aSocket)
 {
-    if (!aHandler)
-    {
-        return;
-    }
-    impl().delHandlerImpl(aHandler);
+    const auto socketHandle = aSocket->nativeHandle();
+    const auto eventMask = aSocket->eventMask();
+
+    setFlag(socketHandle, BaseT::EventsT::kRead & eventMask, &masterReadFDs_);
+    setFlag(socketHandle, BaseT::EventsT::kWrite & eventMask,
+            &masterWriteFDs_);
+    setFlag(socketHandle, BaseT::EventsT::kExceptCond & eventMask,
+            &masterExceptFDs_);
 }
 
 template <typename ImplT, typename SysWrapperT>
-void ExecutorSelectBase<ImplT, SysWrapperT>::delSocket(
+void ExecutorSelectBase<ImplT, SysWrapperT>::unregisterSocketImpl(
     SocketBase<SysWrapperT> const *aSocket)
 {
-    if ((aSocket == nullptr) || !aSocket->isOpen() ||
-        (aSocket->handler() == nullptr))
-    {
-        return;
-    }
-
     const auto socketHandle = aSocket->nativeHandle();
     setFlag(socketHandle, false, &masterReadFDs_);
     setFlag(socketHandle, false, &masterWriteFDs_);
     setFlag(socketHandle, false, &masterExceptFDs_);
-    impl().delNativeHandleImpl(socketHandle);
-}
-
-template <typename ImplT, typename SysWrapperT>
-timeval const *ExecutorSelectBase<ImplT, SysWrapperT>::timeout() const noexcept
-{
-    return infiniteTimeout_ ? nullptr : &masterTimeout_;
-}
-
-template <typename ImplT, typename SysWrapperT>
-void ExecutorSelectBase<ImplT, SysWrapperT>::setTimeout(
-    const timeval aTimeout) noexcept
-{
-    masterTimeout_ = aTimeout;
-    infiniteTimeout_ = false;
-}
-
-template <typename ImplT, typename SysWrapperT>
-void ExecutorSelectBase<ImplT, SysWrapperT>::setTimeoutInfinite() noexcept
-{
-    infiniteTimeout_ = true;
-}
-
-template <typename ImplT, typename SysWrapperT>
-void ExecutorSelectBase<ImplT, SysWrapperT>::setTimeoutHandler(
-    const std::function<void()> aTimeoutHandler) noexcept
-{
-    if (aTimeoutHandler)
-    {
-        timeoutHandler_ = aTimeoutHandler;
-    }
-    else
-    {
-        timeoutHandler_ = []() {};
-    }
-}
-
-template <typename ImplT, typename SysWrapperT>
-void ExecutorSelectBase<ImplT, SysWrapperT>::setErrorHandler(
-    const std::function<void(std::error_code aEc)> aErrorHandler) noexcept
-{
-    if (aErrorHandler)
-    {
-        errorHandler_ = aErrorHandler;
-    }
-    else
-    {
-        errorHandler_ = [](std::error_code) {};
-    }
+    BaseT::impl().delNativeHandleImpl(socketHandle);
 }
 
 template <typename ImplT, typename SysWrapperT>
@@ -244,10 +147,14 @@ void ExecutorSelectBase<ImplT, SysWrapperT>::initSelectArgs() noexcept
     FD_COPY(&masterReadFDs_, &readfds_);
     FD_COPY(&masterWriteFDs_, &writefds_);
     FD_COPY(&masterExceptFDs_, &exceptfds_);
+    if (BaseT::waker_.isOpen())
+    {
+        FD_SET(BaseT::waker_.nativeHandle(), &readfds_);
+    }
 
-    if (!infiniteTimeout_)
+    if (timeval const *timeout = BaseT::waitTimeout(); timeout)
     {
-        timeout_ = masterTimeout_;
+        timeout_ = *timeout;
         timeoutPtr_ = &timeout_;
     }
     else
@@ -259,36 +166,63 @@ void ExecutorSelectBase<ImplT, SysWrapperT>::initSelectArgs() noexcept
 template <typename ImplT, typename SysWrapperT>
 void ExecutorSelectBase<ImplT, SysWrapperT>::iterateResult(const int aResult)
 {
-    std::size_t processed = 0;
-    const std::size_t readyFDCount = static_cast<std::size_t>(aResult);
-    for (std::size_t i = 0, processedCount = 0; processedCount < readyFDCount;
+    // select returns total number of bits set in all three sets
+    std::size_t readyEventCount = static_cast<std::size_t>(aResult);
+    if (BaseT::waker_.isOpen() &&
+        FD_ISSET(BaseT::waker_.nativeHandle(), &readfds_))
+    {
+        BaseT::waker_.drain();
+        --readyEventCount;
+    }
+    for (std::size_t i = 0, processedCount = 0;
+         (processedCount < readyEventCount) &&
+         (i < static_cast<std::size_t>(kMaxFDCount));
          ++i)
     {
-        processed = 0;
-        if (FD_ISSET(impl().nativeHandleImpl(i), &readfds_))
+        SocketBase<SysWrapperT> *socket = fdInfos_[i];
+        if (!socket)
+        {
+            continue;
+        }
+        const sock_t handle = BaseT::impl().nativeHandleImpl(i);
+        uint8_t events = BaseT::EventsT::kNone;
+        if (FD_ISSET(handle, &readfds_))
+        {
+            events |= BaseT::EventsT::kRead;
+            ++processedCount;
+        }
+        if (FD_ISSET(handle, &writefds_))
         {
-            // data can be read from socket without blocking
-            HandlerSelectBase<SysWrapperT> *handler = fdInfos_[i]->handler_;
-            handler->inDataHandler_(*fdInfos_[i], handler);
-            processed = 1;
+            events |= BaseT::EventsT::kWrite;
+            ++processedCount;
         }
-        if (FD_ISSET(impl().nativeHandleImpl(i), &writefds_))
+        if (FD_ISSET(handle, &exceptfds_))
         {
-            // data can be written to socket without blocking
-            HandlerSelectBase<SysWrapperT> *handler = fdInfos_[i]->handler_;
-            handler->outDataHandler_(*fdInfos_[i], handler);
-            processed = 1;
+            events |= BaseT::EventsT::kExceptCond;
+            ++processedCount;
         }
-        if (FD_ISSET(impl().nativeHandleImpl(i), &exceptfds_))
+        // select reports error queue as readability, socket waiting for
+        // completions of zero-copy sends may have some
+        if ((events & BaseT::EventsT::kRead) &&
+            (socket->zeroCopyPendingCount() > 0))
         {
-            // exception conditions occured in this socket can be handled
-            // without blocking
-            HandlerSelectBase<SysWrapperT> *handler = fdInfos_[i]->handler_;
-            handler->exceptCondHandler_(*fdInfos_[i], handler);
-            processed = 1;
+            events |= BaseT::EventsT::kExceptCond;
+        }
+        if (events)
+        {
+            ready_.push(socket->priority(), {i, handle, events});
         }
-        processedCount += processed;
     }
+    // sockets skipped because of limits stay ready and are reported again by
+    // the next select. Socket could be removed by handler of previous one.
+    ready_.drain([this](const ePriority aPriority, const ReadySocket &aReady) {
+        SocketBase<SysWrapperT> *socket = fdInfos_[aReady.index];
+        if (socket && (socket->nativeHandle() == aReady.handle) &&
+            !BaseT::isLimitReached(aPriority))
+        {
+            BaseT::dispatch(socket, aReady.events);
+        }
+    });
 }
 }  // namespace ndt
 
@@ -0,0 +1,75 @@
+#ifndef ndt_executor_stats_h
+#define ndt_executor_stats_h
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "histogram.h"
+#include "useful_base_types.h"
+
+/*! \def NDT_STATS_ONLY
+    \brief Keeps its arguments only if NDT_EXECUTOR_STATS is defined, so that
+   instrumentation of the event loop costs nothing when it is disabled.
+ */
+#if defined(NDT_EXECUTOR_STATS)
+#define NDT_STATS_ONLY(...) __VA_ARGS__
+#else
+#define NDT_STATS_ONLY(...)
+#endif
+
+namespace ndt
+{
+struct ExecutorStatsSnapshot
+{
+    uint64_t iterations_ = 0;
+    uint64_t timeouts_ = 0;
+    uint64_t errors_ = 0;
+    // nanoseconds executor was blocked waiting for events
+    HistogramSnapshot waitTime_;
+    // number of events reported by a wait (ready descriptors, completions)
+    HistogramSnapshot readyCount_;
+    // nanoseconds spent handling events of an iteration
+    HistogramSnapshot dispatchTime_;
+    // nanoseconds of every handler call, posted handlers included
+    HistogramSnapshot handlerTime_;
+};
+
+/*! \class ExecutorStats
+    \brief Counters and histograms of event loop iterations. Updated by the
+   thread which runs executor, snapshot can be taken from any thread.
+ */
+class ExecutorStats final
+    : private NoCopyAble
+    , private NoMoveAble
+{
+   public:
+    using ClockT = std::chrono::steady_clock;
+
+    ~ExecutorStats();
+    ExecutorStats() noexcept;
+
+    void onWait(const ClockT::time_point aStart, const ClockT::time_point aEnd,
+                const int aResult) noexcept;
+    void onDispatch(const ClockT::time_point aStart) noexcept;
+    void onHandler(const ClockT::time_point aStart) noexcept;
+    void onTimeout() noexcept;
+    void onError() noexcept;
+
+    ExecutorStatsSnapshot snapshot() const noexcept;
+
+   private:
+    static uint64_t elapsedNs(const ClockT::time_point aStart,
+                              const ClockT::time_point aEnd) noexcept;
+
+    std::atomic<uint64_t> iterations_ = 0;
+    std::atomic<uint64_t> timeouts_ = 0;
+    std::atomic<uint64_t> errors_ = 0;
+    Histogram waitTime_;
+    Histogram readyCount_;
+    Histogram dispatchTime_;
+    Histogram handlerTime_;
+};
+}  // namespace ndt
+
+#endif /* ndt_executor_stats_h */
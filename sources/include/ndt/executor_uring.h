@@ -0,0 +1,10 @@
+#ifndef ndt_executor_uring_h
+#define ndt_executor_uring_h
+
+#include "common.h"
+
+#if defined(NDT_HAS_IO_URING)
+#include "platform/linux/executor_uring_impl.h"
+#endif
+
+#endif /* ndt_executor_uring_h */
@@ -0,0 +1,189 @@
+#ifndef ndt_handler_dispatcher_h
+#define ndt_handler_dispatcher_h
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+
+#include "address.h"
+#include "buffer.h"
+
+namespace ndt
+{
+template <typename SysWrapperT>
+class SocketBase;
+
+template <typename SysWrapperT>
+class HandlerSelectBase;
+
+/*! \struct HandlerList
+    \brief Compile-time list of handler types (classes derived from
+   HandlerSelect). Executor dispatches events to listed handlers statically,
+   see HandlerDispatcher.
+ */
+template <typename... HandlersT>
+struct HandlerList
+{
+    static_assert(sizeof...(HandlersT) < 256,
+                  "Error: too many handler types in the list");
+};
+
+/*! \struct HandlerListOf
+    \brief Handler list of SysWrapperT: SysWrapperT::HandlersT if it is
+   defined, empty list otherwise.
+ */
+template <typename SysWrapperT, typename = void>
+struct HandlerListOf
+{
+    using type = HandlerList<>;
+};
+
+template <typename SysWrapperT>
+struct HandlerListOf<SysWrapperT, std::void_t<typename SysWrapperT::HandlersT>>
+{
+    using type = typename SysWrapperT::HandlersT;
+};
+
+// one-based position of HandlerT in the list, 0 if HandlerT isn't listed
+template <typename HandlerT, typename... HandlersT>
+constexpr uint8_t handlerIndex(HandlerList<HandlersT...>) noexcept
+{
+    constexpr bool kMatches[] = {false,
+                                 std::is_same_v<HandlerT, HandlersT>...};
+    for (std::size_t i = 1; i < sizeof(kMatches); ++i)
+    {
+        if (kMatches[i])
+        {
+            return static_cast<uint8_t>(i);
+        }
+    }
+    return 0;
+}
+
+/*! \class HandlerDispatcher
+    \brief Calls socket event handlers on behalf of executor. By default every
+   call goes through function pointers stored in HandlerSelectBase. When the
+   set of handler types is known at compile time it is declared in the
+   syscall wrapper:
+
+       class Server;
+       class Client;
+       struct Ops : ndt::SocketOps
+       {
+           using HandlersT = ndt::HandlerList<Server, Client>;
+       };
+
+   then executor of Context<Ops> compares handler's type index with every
+   listed type and calls the matched handler directly, so handler's methods
+   can be inlined into executor's loop. Handlers which aren't listed are
+   still called through function pointers.
+ */
+template <typename SysWrapperT,
+          typename ListT = typename HandlerListOf<SysWrapperT>::type>
+class HandlerDispatcher;
+
+template <typename SysWrapperT, typename... HandlersT>
+class HandlerDispatcher<SysWrapperT, HandlerList<HandlersT...>>
+{
+   public:
+    using SocketT = SocketBase<SysWrapperT>;
+    using HandlerT = HandlerSelectBase<SysWrapperT>;
+
+    // returns true if socket may have more data to read
+    static bool inData(SocketT &aSocket, HandlerT *aHandler);
+    static void outData(SocketT &aSocket, HandlerT *aHandler);
+    static void exceptCond(SocketT &aSocket, HandlerT *aHandler);
+    static void recv(SocketT &aSocket, HandlerT *aHandler,
+                     const Address &aSender, CBuffer aData);
+
+   private:
+    template <typename T>
+    struct Tag
+    {
+        using type = T;
+    };
+
+    template <std::size_t I = 0, typename CallT, typename FallbackT>
+    static decltype(auto) visit(const HandlerT *aHandler, CallT &aCall,
+                                FallbackT &aFallback);
+};
+
+template <typename SysWrapperT, typename... HandlersT>
+bool HandlerDispatcher<SysWrapperT, HandlerList<HandlersT...>>::inData(
+    SocketT &aSocket, HandlerT *aHandler)
+{
+    auto call = [&](auto aTag) {
+        return decltype(aTag)::type::readHandler(aSocket, aHandler);
+    };
+    auto fallback = [&]() {
+        return aHandler->inDataHandler_(aSocket, aHandler);
+    };
+    return visit(aHandler, call, fallback);
+}
+
+template <typename SysWrapperT, typename... HandlersT>
+void HandlerDispatcher<SysWrapperT, HandlerList<HandlersT...>>::outData(
+    SocketT &aSocket, HandlerT *aHandler)
+{
+    auto call = [&](auto aTag) {
+        decltype(aTag)::type::writeHandler(aSocket, aHandler);
+    };
+    auto fallback = [&]() { aHandler->outDataHandler_(aSocket, aHandler); };
+    visit(aHandler, call, fallback);
+}
+
+template <typename SysWrapperT, typename... HandlersT>
+void HandlerDispatcher<SysWrapperT, HandlerList<HandlersT...>>::exceptCond(
+    SocketT &aSocket, HandlerT *aHandler)
+{
+    auto call = [&](auto aTag) {
+        decltype(aTag)::type::exceptionConditionHandler(aSocket, aHandler);
+    };
+    auto fallback = [&]() {
+        aHandler->exceptCondHandler_(aSocket, aHandler);
+    };
+    visit(aHandler, call, fallback);
+}
+
+template <typename SysWrapperT, typename... HandlersT>
+void HandlerDispatcher<SysWrapperT, HandlerList<HandlersT...>>::recv(
+    SocketT &aSocket, HandlerT *aHandler, const Address &aSender,
+    CBuffer aData)
+{
+    auto call = [&](auto aTag) {
+        decltype(aTag)::type::recvHandler(aSocket, aHandler, aSender, aData);
+    };
+    auto fallback = [&]() {
+        aHandler->recvHandler_(aSocket, aHandler, aSender, aData);
+    };
+    visit(aHandler, call, fallback);
+}
+
+template <typename SysWrapperT, typename... HandlersT>
+template <std::size_t I, typename CallT, typename FallbackT>
+decltype(auto)
+HandlerDispatcher<SysWrapperT, HandlerList<HandlersT...>>::visit(
+    const HandlerT *aHandler, CallT &aCall, FallbackT &aFallback)
+{
+    if constexpr (I == sizeof...(HandlersT))
+    {
+        return aFallback();
+    }
+    else
+    {
+        // HandlerSelect base of listed type, it owns static trampolines
+        using SelectT = typename std::tuple_element_t<
+            I, std::tuple<HandlersT...>>::HandlerSelectT;
+        static_assert(std::is_base_of_v<HandlerT, SelectT>,
+                      "Error: listed handler must derive from HandlerSelect");
+        if (aHandler->typeIndex_ == I + 1)
+        {
+            return aCall(Tag<SelectT>{});
+        }
+        return visit<I + 1>(aHandler, aCall, aFallback);
+    }
+}
+}  // namespace ndt
+
+#endif /* ndt_handler_dispatcher_h */
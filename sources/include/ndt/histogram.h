@@ -0,0 +1,82 @@
+#ifndef ndt_histogram_h
+#define ndt_histogram_h
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "useful_base_types.h"
+
+namespace ndt
+{
+// Adds aValue to counter which only one thread writes, so plain relaxed load
+// and store are enough and readers never see a torn value.
+inline void addSingleWriter(std::atomic<uint64_t> &aCounter,
+                            const uint64_t aValue) noexcept
+{
+    aCounter.store(aCounter.load(std::memory_order_relaxed) + aValue,
+                   std::memory_order_relaxed);
+}
+
+/*! \class HistogramSnapshot
+    \brief Copy of Histogram taken at some moment, values are reported with
+   precision of the bucket they fell into (relative error is below 1/16).
+ */
+class HistogramSnapshot
+{
+   public:
+    static constexpr std::size_t kSubBucketBits = 4;
+    static constexpr std::size_t kSubBucketCount = 1 << kSubBucketBits;
+    // values below kSubBucketCount are exact, every next power of two is
+    // split into kSubBucketCount buckets
+    static constexpr std::size_t kBucketCount =
+        (64 - kSubBucketBits + 1) * kSubBucketCount;
+
+    static std::size_t bucketIndex(const uint64_t aValue) noexcept;
+    static uint64_t bucketLowerBound(const std::size_t aIndex) noexcept;
+    static uint64_t bucketUpperBound(const std::size_t aIndex) noexcept;
+
+    uint64_t count() const noexcept;
+    uint64_t sum() const noexcept;
+    uint64_t max() const noexcept;
+    uint64_t mean() const noexcept;
+    // upper bound of the bucket holding value at aPercentile (0..100), 0 if
+    // nothing was recorded
+    uint64_t valueAtPercentile(const double aPercentile) const noexcept;
+    uint64_t bucket(const std::size_t aIndex) const noexcept;
+
+   private:
+    friend class Histogram;
+
+    std::array<uint64_t, kBucketCount> buckets_ = {};
+    uint64_t count_ = 0;
+    uint64_t sum_ = 0;
+    uint64_t max_ = 0;
+};
+
+/*! \class Histogram
+    \brief Log-linear histogram of non-negative values (durations in
+   nanoseconds, sizes). record is called by one thread, snapshot may be taken
+   from any thread, so buckets are relaxed atomics which are updated without
+   read-modify-write instructions.
+ */
+class Histogram final
+    : private NoCopyAble
+    , private NoMoveAble
+{
+   public:
+    ~Histogram();
+    Histogram() noexcept;
+
+    void record(const uint64_t aValue) noexcept;
+    HistogramSnapshot snapshot() const noexcept;
+
+   private:
+    std::array<std::atomic<uint64_t>, HistogramSnapshot::kBucketCount>
+        buckets_ = {};
+    std::atomic<uint64_t> sum_ = 0;
+    std::atomic<uint64_t> max_ = 0;
+};
+}  // namespace ndt
+
+#endif /* ndt_histogram_h */
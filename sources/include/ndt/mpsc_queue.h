@@ -0,0 +1,91 @@
+#ifndef ndt_mpsc_queue_h
+#define ndt_mpsc_queue_h
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+#include "useful_base_types.h"
+
+namespace ndt
+{
+/*! \class MpscQueue
+    \brief Unbounded lock-free multi-producer single-consumer queue (intrusive
+   list with a stub node by D. Vyukov). push is wait-free and can be called
+   from any thread, pop must be called from one consumer thread only. pop may
+   miss element whose push hasn't been completed yet, it is returned by one
+   of subsequent pops.
+ */
+template <typename T>
+class MpscQueue final
+    : private NoCopyAble
+    , private NoMoveAble
+{
+   public:
+    ~MpscQueue();
+    MpscQueue();
+
+    void push(T aValue);
+    std::optional<T> pop();
+    // approximate unless called from consumer thread with no producers
+    bool empty() const noexcept;
+
+   private:
+    struct Node
+    {
+        std::atomic<Node *> next_ = nullptr;
+        std::optional<T> value_;
+    };
+
+    // producers append to head_, consumer takes from tail_
+    std::atomic<Node *> head_;
+    Node *tail_;
+};
+
+template <typename T>
+MpscQueue<T>::~MpscQueue()
+{
+    while (pop())
+    {
+    }
+    delete tail_;
+}
+
+template <typename T>
+MpscQueue<T>::MpscQueue() : head_(new Node), tail_(head_.load())
+{
+}
+
+template <typename T>
+void MpscQueue<T>::push(T aValue)
+{
+    Node *node = new Node;
+    node->value_.emplace(std::move(aValue));
+    Node *prev = head_.exchange(node, std::memory_order_acq_rel);
+    prev->next_.store(node, std::memory_order_release);
+}
+
+template <typename T>
+std::optional<T> MpscQueue<T>::pop()
+{
+    Node *next = tail_->next_.load(std::memory_order_acquire);
+    if (!next)
+    {
+        return std::nullopt;
+    }
+    // next becomes the new stub, its value is moved out
+    std::optional<T> result = std::move(next->value_);
+    next->value_.reset();
+    delete tail_;
+    tail_ = next;
+    return result;
+}
+
+template <typename T>
+bool MpscQueue<T>::empty() const noexcept
+{
+    return tail_->next_.load(std::memory_order_acquire) == nullptr;
+}
+}  // namespace ndt
+
+#endif /* ndt_mpsc_queue_h */
@@ -0,0 +1,329 @@
+#ifndef ndt_executor_epoll_impl_h
+#define ndt_executor_epoll_impl_h
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "../../common.h"
+#include "../../executor_base.h"
+
+namespace ndt
+{
+/*! \class ExecutorEpoll
+    \brief Executor backed by epoll. Sockets are registered in the kernel once
+   in addSocket, so every iteration costs O(number of ready events) and there
+   is no upper limit on descriptor values like FD_SETSIZE for select.
+ */
+template <typename SysWrapperT>
+class ExecutorEpoll
+    : public ExecutorBase<ExecutorEpoll<SysWrapperT>, SysWrapperT>
+{
+    friend class ExecutorBase<ExecutorEpoll<SysWrapperT>, SysWrapperT>;
+    using BaseT = ExecutorBase<ExecutorEpoll<SysWrapperT>, SysWrapperT>;
+
+   public:
+    ~ExecutorEpoll();
+    ExecutorEpoll() noexcept;
+    ExecutorEpoll(const ExecutorEpoll &) = delete;
+    ExecutorEpoll &operator=(const ExecutorEpoll &) = delete;
+
+   private:
+    struct ReadySocket
+    {
+        sock_t handle;
+        uint8_t events;
+    };
+
+    int waitImpl() noexcept;
+    void dispatchImpl(const int aResult);
+    void registerSocketImpl(SocketBase<SysWrapperT> *aSocket);
+    void unregisterSocketImpl(SocketBase<SysWrapperT> const *aSocket);
+    void watchWakeupImpl(const sock_t aHandle) noexcept;
+
+    bool initEpoll() noexcept;
+    void delNativeHandle(const sock_t aHandle) noexcept;
+    void addPendingRead(const sock_t aHandle);
+    SocketBase<SysWrapperT> *socket(const sock_t aHandle) const noexcept;
+    static uint32_t nativeEvents(const uint8_t aEventMask) noexcept;
+    static uint8_t events(const uint32_t aNativeEvents,
+                          const SocketBase<SysWrapperT> &aSocket) noexcept;
+
+    static constexpr int kMaxEventCount = 256;
+    sock_t epollHandle_ = kInvalidSocket;
+    int readyCount_ = 0;
+    std::vector<SocketBase<SysWrapperT> *> fdInfos_;
+    // edge-triggered sockets which used up read budget and must be drained
+    // again on the next iteration
+    std::vector<sock_t> pendingReads_;
+    // by descriptor: events of socket from pendingReads_, so that socket
+    // which is reported by epoll as well is dispatched once
+    std::vector<uint8_t> pendingEvents_;
+    std::array<epoll_event, kMaxEventCount> events_;
+    PriorityBuckets<ReadySocket> ready_;
+};
+
+template <typename SysWrapperT>
+ExecutorEpoll<SysWrapperT>::~ExecutorEpoll()
+{
+    if (epollHandle_ != kInvalidSocket)
+    {
+        SysWrapperT::close(epollHandle_);
+    }
+}
+
+template <typename SysWrapperT>
+ExecutorEpoll<SysWrapperT>::ExecutorEpoll() noexcept = default;
+
+template <typename SysWrapperT>
+bool ExecutorEpoll<SysWrapperT>::initEpoll() noexcept
+{
+    // epoll instance is created lazily so that constructing Context which
+    // never gets any sockets doesn't consume a descriptor
+    if (epollHandle_ == kInvalidSocket)
+    {
+        epollHandle_ = SysWrapperT::epoll_create1(EPOLL_CLOEXEC);
+    }
+    return epollHandle_ != kInvalidSocket;
+}
+
+template <typename SysWrapperT>
+int ExecutorEpoll<SysWrapperT>::waitImpl() noexcept
+{
+    if (!initEpoll())
+    {
+        return kSocketError;
+    }
+    // edge-triggered socket with pending data won't be reported again, so
+    // don't block if there are some
+    const int timeout = pendingReads_.empty() ? BaseT::timeoutMs() : 0;
+    const auto maxEventCount = static_cast<int>(std::min<std::size_t>(
+        BaseT::eventLimit(), static_cast<std::size_t>(kMaxEventCount)));
+    readyCount_ = SysWrapperT::epoll_wait(epollHandle_, events_.data(),
+                                          maxEventCount, timeout);
+    if (readyCount_ == kSocketError)
+    {
+        return kSocketError;
+    }
+    return readyCount_ + static_cast<int>(pendingReads_.size());
+}
+
+template <typename SysWrapperT>
+void ExecutorEpoll<SysWrapperT>::dispatchImpl(const int)
+{
+    // new events of pending socket are merged into its pending read
+    const std::size_t readyEventCount = static_cast<std::size_t>(readyCount_);
+    for (std::size_t i = 0; i < readyEventCount; ++i)
+    {
+        const sock_t handle = events_[i].data.fd;
+        const auto index = static_cast<std::size_t>(handle);
+        SocketBase<SysWrapperT> *s = socket(handle);
+        if (s && pendingEvents_[index])
+        {
+            pendingEvents_[index] |= events(events_[i].events, *s);
+            events_[i].data.fd = kInvalidSocket;
+        }
+    }
+    for (const sock_t handle: pendingReads_)
+    {
+        const auto index = static_cast<std::size_t>(handle);
+        SocketBase<SysWrapperT> *s = socket(handle);
+        if (s && pendingEvents_[index])
+        {
+            ready_.push(s->priority(), {handle, pendingEvents_[index]});
+            pendingEvents_[index] = 0;
+        }
+    }
+    pendingReads_.clear();
+
+    for (std::size_t i = 0; i < readyEventCount; ++i)
+    {
+        const sock_t handle = events_[i].data.fd;
+        if (handle == kInvalidSocket)
+        {
+            continue;
+        }
+        if (handle == BaseT::waker_.nativeHandle())
+        {
+            BaseT::waker_.drain();
+            continue;
+        }
+        if (SocketBase<SysWrapperT> *s = socket(handle); s)
+        {
+            ready_.push(s->priority(),
+                        {handle, events(events_[i].events, *s)});
+        }
+    }
+
+    // sockets are looked up by descriptor because they could be removed by
+    // handler of one of previous events
+    ready_.drain([this](const ePriority aPriority, const ReadySocket &aReady) {
+        SocketBase<SysWrapperT> *s = socket(aReady.handle);
+        if (!s)
+        {
+            return;
+        }
+        if (BaseT::isLimitReached(aPriority))
+        {
+            // level-triggered sockets are reported again, edge-triggered
+            // ones have to be remembered
+            if (s->eventMask() & BaseT::EventsT::kEdgeTriggered)
+            {
+                addPendingRead(aReady.handle);
+            }
+        }
+        else if (BaseT::dispatch(s, aReady.events) &&
+                 (s->eventMask() & BaseT::EventsT::kEdgeTriggered))
+        {
+            // level-triggered socket with more data is reported again
+            addPendingRead(aReady.handle);
+        }
+    });
+}
+
+template <typename SysWrapperT>
+void ExecutorEpoll<SysWrapperT>::registerSocketImpl(
+    SocketBase<SysWrapperT> *aSocket)
+{
+    if (!initEpoll())
+    {
+        BaseT::reportError(SysWrapperT::lastErrorCode());
+        return;
+    }
+
+    const auto handle = aSocket->nativeHandle();
+    const auto index = static_cast<std::size_t>(handle);
+    if (index >= fdInfos_.size())
+    {
+        fdInfos_.resize(index + 1, nullptr);
+        pendingEvents_.resize(index + 1, 0);
+    }
+
+    epoll_event event{};
+    event.events = nativeEvents(aSocket->eventMask());
+    event.data.fd = handle;
+    const int op = fdInfos_[index] ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+    if (SysWrapperT::epoll_ctl(epollHandle_, op, handle, &event) ==
+        kSocketError)
+    {
+        BaseT::reportError(SysWrapperT::lastErrorCode());
+        return;
+    }
+    fdInfos_[index] = aSocket;
+}
+
+template <typename SysWrapperT>
+void ExecutorEpoll<SysWrapperT>::unregisterSocketImpl(
+    SocketBase<SysWrapperT> const *aSocket)
+{
+    delNativeHandle(aSocket->nativeHandle());
+}
+
+template <typename SysWrapperT>
+void ExecutorEpoll<SysWrapperT>::watchWakeupImpl(const sock_t aHandle) noexcept
+{
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = aHandle;
+    if (!initEpoll() ||
+        (SysWrapperT::epoll_ctl(epollHandle_, EPOLL_CTL_ADD, aHandle, &event) ==
+         kSocketError))
+    {
+        BaseT::reportError(SysWrapperT::lastErrorCode());
+    }
+}
+
+template <typename SysWrapperT>
+void ExecutorEpoll<SysWrapperT>::delNativeHandle(const sock_t aHandle) noexcept
+{
+    const auto index = static_cast<std::size_t>(aHandle);
+    if ((index >= fdInfos_.size()) || !fdInfos_[index])
+    {
+        return;
+    }
+    fdInfos_[index] = nullptr;
+    pendingEvents_[index] = 0;
+    SysWrapperT::epoll_ctl(epollHandle_, EPOLL_CTL_DEL, aHandle, nullptr);
+}
+
+template <typename SysWrapperT>
+void ExecutorEpoll<SysWrapperT>::addPendingRead(const sock_t aHandle)
+{
+    uint8_t &events = pendingEvents_[static_cast<std::size_t>(aHandle)];
+    if (!events)
+    {
+        events = BaseT::EventsT::kRead;
+        pendingReads_.push_back(aHandle);
+    }
+}
+
+template <typename SysWrapperT>
+SocketBase<SysWrapperT> *ExecutorEpoll<SysWrapperT>::socket(
+    const sock_t aHandle) const noexcept
+{
+    const auto index = static_cast<std::size_t>(aHandle);
+    return (index < fdInfos_.size()) ? fdInfos_[index] : nullptr;
+}
+
+template <typename SysWrapperT>
+uint32_t ExecutorEpoll<SysWrapperT>::nativeEvents(
+    const uint8_t aEventMask) noexcept
+{
+    uint32_t result = 0;
+    if (aEventMask & BaseT::EventsT::kRead)
+    {
+        result |= EPOLLIN;
+    }
+    if (aEventMask & BaseT::EventsT::kWrite)
+    {
+        result |= EPOLLOUT;
+    }
+    if (aEventMask & BaseT::EventsT::kExceptCond)
+    {
+        result |= EPOLLPRI;
+    }
+    // Pending error or hang up is reported even if socket isn't watched for
+    // reading, but only reading takes it. Socket which is neither read nor
+    // written is edge-triggered, so it doesn't wake executor over and over.
+    // It is registered again when reading is resumed.
+    if ((aEventMask & BaseT::EventsT::kEdgeTriggered) ||
+        !(aEventMask & (BaseT::EventsT::kRead | BaseT::EventsT::kWrite)))
+    {
+        result |= EPOLLET;
+    }
+    return result;
+}
+
+template <typename SysWrapperT>
+uint8_t ExecutorEpoll<SysWrapperT>::events(
+    const uint32_t aNativeEvents,
+    const SocketBase<SysWrapperT> &aSocket) noexcept
+{
+    uint8_t result = BaseT::EventsT::kNone;
+    // select reports socket with pending error or hang up as readable, keep
+    // the same behaviour. Error of socket waiting for completions of
+    // zero-copy sends is usually its error queue, which only exception
+    // condition handler reads.
+    const uint32_t readEvents =
+        (aSocket.zeroCopyPendingCount() > 0)
+            ? (EPOLLIN | EPOLLHUP)
+            : (EPOLLIN | EPOLLERR | EPOLLHUP);
+    if (aNativeEvents & readEvents)
+    {
+        result |= BaseT::EventsT::kRead;
+    }
+    if (aNativeEvents & EPOLLOUT)
+    {
+        result |= BaseT::EventsT::kWrite;
+    }
+    // error queue, e.g. completions of zero-copy sends, is handled as
+    // exception condition as well
+    if (aNativeEvents & (EPOLLPRI | EPOLLERR))
+    {
+        result |= BaseT::EventsT::kExceptCond;
+    }
+    return result;
+}
+}  // namespace ndt
+
+#endif /* ndt_executor_epoll_impl_h */
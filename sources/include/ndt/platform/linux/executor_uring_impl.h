@@ -0,0 +1,1100 @@
+#ifndef ndt_executor_uring_impl_h
+#define ndt_executor_uring_impl_h
+
+#include <poll.h>
+
+#include <algorithm>
+#include <csignal>
+#include <cstring>
+#include <vector>
+
+#include "../../common.h"
+#include "../../executor_base.h"
+
+namespace ndt
+{
+/*! \class ExecutorUring
+    \brief Completion based executor backed by io_uring. Requires Linux 6.0 or
+   newer.
+
+   Sockets whose handler defines recvHandlerImpl get a multishot recvmsg
+   request which takes buffers from a ring registered in the kernel, so every
+   datagram is delivered to the handler together with the sender address
+   without any system call. Sockets with other handlers are served by poll
+   requests which are re-armed after every notification. Datagrams sent with
+   postSendTo are queued in the submission ring and submitted together with
+   the wait at the beginning of the next iteration.
+ */
+template <typename SysWrapperT>
+class ExecutorUring
+    : public ExecutorBase<ExecutorUring<SysWrapperT>, SysWrapperT>
+{
+    friend class ExecutorBase<ExecutorUring<SysWrapperT>, SysWrapperT>;
+    using BaseT = ExecutorBase<ExecutorUring<SysWrapperT>, SysWrapperT>;
+
+   public:
+    ~ExecutorUring();
+    ExecutorUring() noexcept;
+    ExecutorUring(const ExecutorUring &) = delete;
+    ExecutorUring &operator=(const ExecutorUring &) = delete;
+
+    static constexpr unsigned kRingSize = 256;
+    static constexpr unsigned kRecvBufferCount = 256;
+    // includes io_uring_recvmsg_out header and sender address
+    static constexpr std::size_t kRecvBufferSize = 2048;
+    static constexpr std::size_t kSendSlotCount = 256;
+
+   private:
+    enum eRequestKind : uint8_t
+    {
+        kPoll,
+        kRecv,
+        kSend,
+        kCancel,
+        kWakeup,
+        // not a request: socket which used up its read budget, it is queued
+        // among completions so that it is drained in order of its priority
+        kPendingRead
+    };
+
+    struct Entry
+    {
+        SocketBase<SysWrapperT> *socket = nullptr;
+        uint32_t generation = 0;
+        // events of poll request in flight, 0 if there is none
+        uint32_t pollEvents = 0;
+        // multishot recvmsg request is in flight, it may be being cancelled
+        bool isRecvArmed = false;
+    };
+
+    struct SendSlot
+    {
+        msghdr msg;
+        iovec iov;
+        sa_u addr;
+        std::vector<char> data;
+    };
+
+    struct PendingRead
+    {
+        sock_t handle;
+        uint32_t generation;
+    };
+
+    int waitImpl() noexcept;
+    void dispatchImpl(const int aResult);
+    void registerSocketImpl(SocketBase<SysWrapperT> *aSocket);
+    void updateSocketImpl(SocketBase<SysWrapperT> *aSocket);
+    void unregisterSocketImpl(SocketBase<SysWrapperT> const *aSocket);
+    void postSendToImpl(SocketBase<SysWrapperT> &aSocket, const Address &aDst,
+                        CBuffer aBuf, std::error_code &aEc);
+    void flushImpl() noexcept;
+    void watchWakeupImpl(const sock_t aHandle) noexcept;
+
+    bool initRing() noexcept;
+    bool initBufferRing() noexcept;
+    void releaseRing() noexcept;
+
+    io_uring_sqe *getSqe() noexcept;
+    int submit(const unsigned aMinComplete, const unsigned aFlags,
+               const void *aArg, const std::size_t aArgSize) noexcept;
+    unsigned readyCompletions() const noexcept;
+
+    void armRecv(const sock_t aHandle, const uint32_t aGeneration);
+    void armPoll(const sock_t aHandle, const uint32_t aGeneration,
+                 const uint32_t aNativeEvents);
+    void updatePoll(const sock_t aHandle, const uint32_t aGeneration,
+                    const uint32_t aNativeEvents);
+    void rearmPoll(const sock_t aHandle, const uint32_t aGeneration);
+    bool isReadPending(const sock_t aHandle) const noexcept;
+    void armWakeup(const sock_t aHandle) noexcept;
+    void cancel(const sock_t aHandle);
+    void cancelRecv(const sock_t aHandle, const uint32_t aGeneration);
+    void delEntry(const sock_t aHandle);
+
+    void collect(const io_uring_cqe &aCqe);
+    void handleReady(const ePriority aPriority, const io_uring_cqe &aCqe);
+    void handleRecv(const io_uring_cqe &aCqe);
+    void handlePoll(const io_uring_cqe &aCqe);
+    void handlePendingRead(const io_uring_cqe &aCqe);
+    void handleSend(const io_uring_cqe &aCqe);
+    void recycleBuffer(const uint16_t aBufferId) noexcept;
+
+    Entry *entry(const sock_t aHandle, const uint32_t aGeneration) noexcept;
+    static uint32_t pollEvents(const uint8_t aEventMask) noexcept;
+    static uint8_t events(const uint32_t aNativeEvents,
+                          const SocketBase<SysWrapperT> &aSocket) noexcept;
+
+    // user_data of request: kind (8 bits) | generation (24 bits) | fd or
+    // send slot index (32 bits). Generation lets to ignore completions which
+    // belong to socket that was removed from executor.
+    static uint64_t userData(const eRequestKind aKind,
+                             const uint32_t aGeneration,
+                             const uint32_t aIndex) noexcept;
+    static eRequestKind kind(const uint64_t aUserData) noexcept;
+    static uint32_t generation(const uint64_t aUserData) noexcept;
+    static uint32_t index(const uint64_t aUserData) noexcept;
+    static constexpr uint32_t kGenerationMask = 0xFFFFFF;
+
+    static constexpr uint16_t kBufferGroup = 0;
+
+    int ringHandle_ = kInvalidSocket;
+    void *sqRingPtr_ = nullptr;
+    std::size_t sqRingSize_ = 0;
+    void *cqRingPtr_ = nullptr;
+    std::size_t cqRingSize_ = 0;
+    io_uring_sqe *sqes_ = nullptr;
+    std::size_t sqesSize_ = 0;
+    unsigned *sqHead_ = nullptr;
+    unsigned *sqTail_ = nullptr;
+    unsigned sqMask_ = 0;
+    unsigned sqEntries_ = 0;
+    unsigned sqeTail_ = 0;
+    unsigned *cqHead_ = nullptr;
+    unsigned *cqTail_ = nullptr;
+    unsigned cqMask_ = 0;
+    io_uring_cqe *cqes_ = nullptr;
+
+    io_uring_buf_ring *bufRing_ = nullptr;
+    std::size_t bufRingSize_ = 0;
+    uint16_t bufRingTail_ = 0;
+    std::vector<char> recvBuffers_;
+    // multishot recvmsg takes only name and control lengths from msghdr
+    msghdr recvMsg_{};
+
+    std::vector<Entry> entries_;
+    std::vector<PendingRead> pendingReads_;
+    std::vector<PendingRead> drainingReads_;
+    // completions of sockets are dispatched by priority class of socket,
+    // ones left because of limits are handled by the next iteration
+    PriorityBuckets<io_uring_cqe> ready_;
+    std::vector<io_uring_cqe> carried_;
+    std::vector<SendSlot> sendSlots_;
+    std::vector<uint32_t> freeSendSlots_;
+};
+
+template <typename SysWrapperT>
+ExecutorUring<SysWrapperT>::~ExecutorUring()
+{
+    flushImpl();
+    releaseRing();
+}
+
+template <typename SysWrapperT>
+ExecutorUring<SysWrapperT>::ExecutorUring() noexcept
+{
+    recvMsg_.msg_namelen = sizeof(sa_u);
+}
+
+template <typename SysWrapperT>
+bool ExecutorUring<SysWrapperT>::initRing() noexcept
+{
+    // ring is created lazily so that constructing Context which never gets
+    // any sockets doesn't consume a descriptor and locked memory
+    if (ringHandle_ != kInvalidSocket)
+    {
+        return true;
+    }
+
+    io_uring_params params{};
+    const int handle = SysWrapperT::io_uring_setup(kRingSize, &params);
+    if (handle == kSocketError)
+    {
+        return false;
+    }
+    ringHandle_ = handle;
+    if (!(params.features & IORING_FEAT_EXT_ARG))
+    {
+        releaseRing();
+        errno = ENOSYS;
+        return false;
+    }
+
+    sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize_ =
+        params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool isSingleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (isSingleMmap)
+    {
+        sqRingSize_ = cqRingSize_ = std::max(sqRingSize_, cqRingSize_);
+    }
+    sqRingPtr_ =
+        SysWrapperT::mmap(nullptr, sqRingSize_, PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_POPULATE, ringHandle_,
+                          static_cast<off_t>(IORING_OFF_SQ_RING));
+    if (sqRingPtr_ == MAP_FAILED)
+    {
+        sqRingPtr_ = nullptr;
+        releaseRing();
+        return false;
+    }
+    if (isSingleMmap)
+    {
+        cqRingPtr_ = sqRingPtr_;
+    }
+    else
+    {
+        cqRingPtr_ =
+            SysWrapperT::mmap(nullptr, cqRingSize_, PROT_READ | PROT_WRITE,
+                              MAP_SHARED | MAP_POPULATE, ringHandle_,
+                              static_cast<off_t>(IORING_OFF_CQ_RING));
+        if (cqRingPtr_ == MAP_FAILED)
+        {
+            cqRingPtr_ = nullptr;
+            releaseRing();
+            return false;
+        }
+    }
+    sqesSize_ = params.sq_entries * sizeof(io_uring_sqe);
+    void *sqes =
+        SysWrapperT::mmap(nullptr, sqesSize_, PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_POPULATE, ringHandle_,
+                          static_cast<off_t>(IORING_OFF_SQES));
+    if (sqes == MAP_FAILED)
+    {
+        releaseRing();
+        return false;
+    }
+    sqes_ = static_cast<io_uring_sqe *>(sqes);
+
+    char *sq = static_cast<char *>(sqRingPtr_);
+    sqHead_ = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+    sqTail_ = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    sqMask_ = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    sqEntries_ = params.sq_entries;
+    sqeTail_ = *sqTail_;
+    // submission queue entries are always used in order, so the indirection
+    // array is filled once
+    unsigned *sqArray = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    for (unsigned i = 0; i < sqEntries_; ++i)
+    {
+        sqArray[i] = i;
+    }
+
+    char *cq = static_cast<char *>(cqRingPtr_);
+    cqHead_ = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    cqTail_ = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    cqMask_ = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+
+    if (!initBufferRing())
+    {
+        const int errorCode = SysWrapperT::lastErrorCode();
+        releaseRing();
+        errno = errorCode;
+        return false;
+    }
+
+    sendSlots_.resize(kSendSlotCount);
+    freeSendSlots_.reserve(kSendSlotCount);
+    for (std::size_t i = kSendSlotCount; i > 0; --i)
+    {
+        freeSendSlots_.push_back(static_cast<uint32_t>(i - 1));
+    }
+    return true;
+}
+
+template <typename SysWrapperT>
+bool ExecutorUring<SysWrapperT>::initBufferRing() noexcept
+{
+    bufRingSize_ = kRecvBufferCount * sizeof(io_uring_buf);
+    void *bufRing =
+        SysWrapperT::mmap(nullptr, bufRingSize_, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (bufRing == MAP_FAILED)
+    {
+        return false;
+    }
+    bufRing_ = static_cast<io_uring_buf_ring *>(bufRing);
+
+    io_uring_buf_reg reg{};
+    reg.ring_addr = reinterpret_cast<uint64_t>(bufRing_);
+    reg.ring_entries = kRecvBufferCount;
+    reg.bgid = kBufferGroup;
+    if (SysWrapperT::io_uring_register(ringHandle_, IORING_REGISTER_PBUF_RING,
+                                       &reg, 1) == kSocketError)
+    {
+        return false;
+    }
+
+    recvBuffers_.resize(kRecvBufferCount * kRecvBufferSize);
+    bufRingTail_ = 0;
+    for (uint16_t i = 0; i < kRecvBufferCount; ++i)
+    {
+        recycleBuffer(i);
+    }
+    __atomic_store_n(&bufRing_->tail, bufRingTail_, __ATOMIC_RELEASE);
+    return true;
+}
+
+template <typename SysWrapperT>
+void ExecutorUring<SysWrapperT>::releaseRing() noexcept
+{
+    // closing ring cancels all requests which are still in flight
+    if (ringHandle_ != kInvalidSocket)
+    {
+        SysWrapperT::close(ringHandle_);
+        ringHandle_ = kInvalidSocket;
+    }
+    if (bufRing_)
+    {
+        SysWrapperT::munmap(bufRing_, bufRingSize_);
+        bufRing_ = nullptr;
+    }
+    if (sqes_)
+    {
+        SysWrapperT::munmap(sqes_, sqesSize_);
+        sqes_ = nullptr;
+    }
+    if (cqRingPtr_ && (cqRingPtr_ != sqRingPtr_))
+    {
+        SysWrapperT::munmap(cqRingPtr_, cqRingSize_);
+    }
+    cqRingPtr_ = nullptr;
+    if (sqRingPtr_)
+    {
+        SysWrapperT::munmap(sqRingPtr_, sqRingSize_);
+        sqRingPtr_ = nullptr;
+    }
+}
+
+template <typename SysWrapperT>
+io_uring_sqe *ExecutorUring<SysWrapperT>::getSqe() noexcept
+{
+    if (sqeTail_ - __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE) >= sqEntries_)
+    {
+        // submission ring is full, hand collected requests to the kernel
+        if ((submit(0, 0, nullptr, 0) == kSocketError) ||
+            (sqeTail_ - __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE) >=
+             sqEntries_))
+        {
+            return nullptr;
+        }
+    }
+    io_uring_sqe *sqe = &sqes_[sqeTail_ & sqMask_];
+    std::memset(sqe, 0, sizeof(io_uring_sqe));
+    ++sqeTail_;
+    return sqe;
+}
+
+template <typename SysWrapperT>
+int ExecutorUring<SysWrapperT>::submit(const unsigned aMinComplete,
+                                       const unsigned aFlags, const void *aArg,
+                                       const std::size_t aArgSize) noexcept
+{
+    __atomic_store_n(sqTail_, sqeTail_, __ATOMIC_RELEASE);
+    const unsigned toSubmit =
+        sqeTail_ - __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE);
+    if ((toSubmit == 0) && !(aFlags & IORING_ENTER_GETEVENTS))
+    {
+        return 0;
+    }
+    return SysWrapperT::io_uring_enter(ringHandle_, toSubmit, aMinComplete,
+                                       aFlags, aArg, aArgSize);
+}
+
+template <typename SysWrapperT>
+unsigned ExecutorUring<SysWrapperT>::readyCompletions() const noexcept
+{
+    return __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE) - *cqHead_;
+}
+
+template <typename SysWrapperT>
+int ExecutorUring<SysWrapperT>::waitImpl() noexcept
+{
+    if (!initRing())
+    {
+        return kSocketError;
+    }
+
+    // pending completions or edge-triggered sockets with pending data
+    // mustn't wait, but queued requests are submitted anyway
+    const bool mustWait = (readyCompletions() == 0) &&
+                          pendingReads_.empty() && carried_.empty();
+    int result = 0;
+    if (mustWait)
+    {
+        __kernel_timespec ts{};
+        io_uring_getevents_arg arg{};
+        arg.sigmask_sz = _NSIG / 8;
+        if (timeval const *timeout = BaseT::waitTimeout(); timeout)
+        {
+            ts.tv_sec = timeout->tv_sec;
+            ts.tv_nsec = static_cast<long long>(timeout->tv_usec) * 1000;
+            arg.ts = reinterpret_cast<uint64_t>(&ts);
+        }
+        result = submit(1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG,
+                        &arg, sizeof(arg));
+    }
+    else
+    {
+        result = submit(0, 0, nullptr, 0);
+    }
+
+    if (result == kSocketError)
+    {
+        const int errorCode = SysWrapperT::lastErrorCode();
+        // ETIME means timeout, EINTR and EBUSY (completion ring overflowed)
+        // are resolved by reaping completions
+        if ((errorCode != ETIME) && (errorCode != EINTR) &&
+            (errorCode != EBUSY))
+        {
+            return kSocketError;
+        }
+    }
+    return static_cast<int>(readyCompletions() + pendingReads_.size() +
+                            carried_.size());
+}
+
+template <typename SysWrapperT>
+void ExecutorUring<SysWrapperT>::dispatchImpl(const int)
+{
+    drainingReads_.swap(pendingReads_);
+    for (const PendingRead &pending: drainingReads_)
+    {
+        io_uring_cqe cqe{};
+        cqe.user_data = userData(kPendingRead, pending.generation,
+                                 static_cast<uint32_t>(pending.handle));
+        collect(cqe);
+    }
+    for (const io_uring_cqe &cqe: carried_)
+    {
+        collect(cqe);
+    }
+    carried_.clear();
+
+    // handlers may add requests and even submit them, so only completions
+    // which are ready at this point are handled
+    unsigned head = *cqHead_;
+    const unsigned tail = __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE);
+    while (head != tail)
+    {
+        // copy completion and release its slot before calling handler
+        const io_uring_cqe cqe = cqes_[head & cqMask_];
+        ++head;
+        __atomic_store_n(cqHead_, head, __ATOMIC_RELEASE);
+        collect(cqe);
+    }
+
+    ready_.drain([this](const ePriority aPriority, const io_uring_cqe &aCqe) {
+        handleReady(aPriority, aCqe);
+    });
+    drainingReads_.clear();
+    // make recycled buffers visible to the kernel
+    __atomic_store_n(&bufRing_->tail, bufRingTail_, __ATOMIC_RELEASE);
+}
+
+template <typename SysWrapperT>
+void ExecutorUring<SysWrapperT>::collect(const io_uring_cqe &aCqe)
+{
+    switch (kind(aCqe.user_data))
+    {
+        case kRecv:
+        case kPoll:
+        case kPendingRead:
+            if (Entry *e = entry(static_cast<sock_t>(index(aCqe.user_data)),
+                                 generation(aCqe.user_data));
+                e)
+            {
+                ready_.push(e->socket->priority(), aCqe);
+            }
+            else if (kind(aCqe.user_data) == kRecv)
+            {
+                // buffer of removed socket is recycled
+                handleRecv(aCqe);
+            }
+            break;
+        case kSend:
+            handleSend(aCqe);
+            break;
+        case kCancel:
+            break;
+        case kWakeup:
+            BaseT::waker_.drain();
+            if (aCqe.res >= 0)
+            {
+                armWakeup(static_cast<sock_t>(index(aCqe.user_data)));
+            }
+            break;
+    }
+}
+
+template <typename SysWrapperT>
+void ExecutorUring<SysWrapperT>::handleReady(const ePriority aPriority,
+                                             const io_uring_cqe &aCqe)
+{
+    if (BaseT::isLimitReached(aPriority))
+    {
+        // completions left because of limits are handled by the next
+        // iteration, which doesn't wait while there are any
+        if (kind(aCqe.user_data) == kPendingRead)
+        {
+            pendingReads_.push_back(
+                {static_cast<sock_t>(index(aCqe.user_data)),
+                 generation(aCqe.user_data)});
+        }
+        else
+        {
+            carried_.push_back(aCqe);
+        }
+        return;
+    }
+    switch (kind(aCqe.user_data))
+    {
+        case kRecv:
+            handleRecv(aCqe);
+            break;
+        case kPoll:
+            handlePoll(aCqe);
+            break;
+        case kPendingRead:
+            handlePendingRead(aCqe);
+            break;
+        default:
+            break;
+    }
+}
+
+template <typename SysWrapperT>
+void ExecutorUring<SysWrapperT>::handleRecv(const io_uring_cqe &aCqe)
+{
+    const auto handle = static_cast<sock_t>(index(aCqe.user_data));
+    const uint32_t gen = generation(aCqe.user_data);
+    const bool hasBuffer = aCqe.flags & IORING_CQE_F_BUFFER;
+    const auto bufferId =
+        static_cast<uint16_t>(aCqe.flags >> IORING_CQE_BUFFER_SHIFT);
+
+    Entry *e = entry(handle, gen);
+    if (e && (aCqe.res >= 0) && hasBuffer)
+    {
+        char *buf = &recvBuffers_[bufferId * kRecvBufferSize];
+        const auto *out = reinterpret_cast<io_uring_recvmsg_out *>(buf);
+        const std::size_t nameOffset = sizeof(io_uring_recvmsg_out);
+        const std::size_t payloadOffset = nameOffset + recvMsg_.msg_namelen;
+        const auto bufferLength = static_cast<std::size_t>(aCqe.res);
+        if (out->flags & MSG_TRUNC)
+        {
+            // datagram doesn't fit into kRecvBufferSize and is dropped
+            BaseT::reportError(EMSGSIZE);
+        }
+        else if (bufferLength >= payloadOffset)
+        {
+            // unnamed peer e.g. unbound AF_UNIX socket is reported as default
+            // address, as recvFrom does
+            Address sender;
+            if (out->namelen > 0)
+            {
+                sa_u name;
+                std::memset(&name, 0, sizeof(name));
+                std::memcpy(&name, buf + nameOffset,
+                            std::min<std::size_t>(out->namelen,
+                                                  recvMsg_.msg_namelen));
+                sender = Address(name.sa);
+            }
+            BaseT::dispatchDatagram(e->socket, sender,
+                                    CBuffer(buf + payloadOffset,
+                                            bufferLength - payloadOffset));
+        }
+    }
+    else if (e && (aCqe.res < 0) && (aCqe.res != -ENOBUFS) &&
+             (aCqe.res != -ECANCELED))
+    {
+        BaseT::reportError(-aCqe.res);
+    }
+
+    if (hasBuffer)
+    {
+        recycleBuffer(bufferId);
+    }
+    // multishot request is terminated by kernel e.g. when buffer ring runs
+    // out of buffers, re-arm it if socket is still in executor, is read and
+    // request can succeed at all. Request cancelled because reading was
+    // paused is re-armed too if reading was resumed meanwhile.
+    const bool isFatal = (aCqe.res == -EINVAL) ||
+                         (aCqe.res == -EOPNOTSUPP) || (aCqe.res == -EBADF) ||
+                         (aCqe.res == -ENOTSOCK);
+    e = entry(handle, gen);
+    if (!(aCqe.flags & IORING_CQE_F_MORE) && e)
+    {
+        e->isRecvArmed = false;
+        if (!isFatal && (e->socket->eventMask() & BaseT::EventsT::kRecv))
+        {
+            armRecv(handle, gen);
+        }
+    }
+}
+
+template <typename SysWrapperT>
+void ExecutorUring<SysWrapperT>::handlePoll(const io_uring_cqe &aCqe)
+{
+    const auto handle = static_cast<sock_t>(index(aCqe.user_data));
+    const uint32_t gen = generation(aCqe.user_data);
+    Entry *e = entry(handle, gen);
+    if (!e)
+    {
+        return;
+    }
+    e->pollEvents = 0;
+    if (aCqe.res < 0)
+    {
+        if (aCqe.res != -ECANCELED)
+        {
+            BaseT::reportError(-aCqe.res);
+        }
+        return;
+    }
+
+    // poll is one-shot, so it is level-triggered like select
+    if (BaseT::dispatch(e->socket,
+                        events(static_cast<uint32_t>(aCqe.res), *e->socket)))
+    {
+        pendingReads_.push_back({handle, gen});
+    }
+    else
+    {
+        rearmPoll(handle, gen);
+    }
+}
+
+template <typename SysWrapperT>
+void ExecutorUring<SysWrapperT>::handlePendingRead(const io_uring_cqe &aCqe)
+{
+    const auto handle = static_cast<sock_t>(index(aCqe.user_data));
+    const uint32_t gen = generation(aCqe.user_data);
+    Entry *e = entry(handle, gen);
+    if (!e)
+    {
+        return;
+    }
+    if (BaseT::dispatch(e->socket, BaseT::EventsT::kRead))
+    {
+        pendingReads_.push_back({handle, gen});
+    }
+    else
+    {
+        rearmPoll(handle, gen);
+    }
+}
+
+template <typename SysWrapperT>
+void ExecutorUring<SysWrapperT>::handleSend(const io_uring_cqe &aCqe)
+{
+    freeSendSlots_.push_back(index(aCqe.user_data));
+    // sends are cancelled together with other requests of removed socket
+    if ((aCqe.res < 0) && (aCqe.res != -ECANCELED))
+    {
+        BaseT::reportError(-aCqe.res);
+    }
+}
+
+template <typename SysWrapperT>
+void ExecutorUring<SysWrapperT>::recycleBuffer(
+    const uint16_t aBufferId) noexcept
+{
+    // bufs member of io_uring_buf_ring is declared via __DECLARE_FLEX_ARRAY
+    // which has non-zero offset in C++, so buffers are addressed directly
+    io_uring_buf &buf = reinterpret_cast<io_uring_buf *>(
+        bufRing_)[bufRingTail_ & (kRecvBufferCount - 1)];
+    buf.addr = reinterpret_cast<uint64_t>(
+        &recvBuffers_[aBufferId * kRecvBufferSize]);
+    buf.len = static_cast<uint32_t>(kRecvBufferSize);
+    buf.bid = aBufferId;
+    ++bufRingTail_;
+}
+
+template <typename SysWrapperT>
+void ExecutorUring<SysWrapperT>::registerSocketImpl(
+    SocketBase<SysWrapperT> *aSocket)
+{
+    if (!initRing())
+    {
+        BaseT::reportError(SysWrapperT::lastErrorCode());
+        return;
+    }
+
+    const auto handle = aSocket->nativeHandle();
+    const auto index = static_cast<std::size_t>(handle);
+    if (index >= entries_.size())
+    {
+        entries_.resize(index + 1);
+    }
+    if (entries_[index].socket)
+    {
+        // handler is replaced, its requests could be for different events
+        delEntry(handle);
+    }
+
+    Entry &e = entries_[index];
+    e.socket = aSocket;
+    const uint8_t eventMask = aSocket->eventMask();
+    if (eventMask & BaseT::EventsT::kRecv)
+    {
+        armRecv(handle, e.generation);
+    }
+    rearmPoll(handle, e.generation);
+}
+
+template <typename SysWrapperT>
+void ExecutorUring<SysWrapperT>::updateSocketImpl(
+    SocketBase<SysWrapperT> *aSocket)
+{
+    const auto handle = aSocket->nativeHandle();
+    const auto index = static_cast<std::size_t>(handle);
+    if ((index >= entries_.size()) || (entries_[index].socket != aSocket))
+    {
+        registerSocketImpl(aSocket);
+        return;
+    }
+    Entry &e = entries_[index];
+    // multishot recv can't be paused, it is cancelled instead. Completions
+    // which are already queued are still dispatched.
+    const bool isRecv = aSocket->eventMask() & BaseT::EventsT::kRecv;
+    if (isRecv && !e.isRecvArmed)
+    {
+        armRecv(handle, e.generation);
+    }
+    else if (!isRecv && e.isRecvArmed)
+    {
+        cancelRecv(handle, e.generation);
+    }
+    // socket whose readiness is being handled is re-armed with new events
+    // once it is handled
+    if (e.pollEvents || !isReadPending(handle))
+    {
+        rearmPoll(handle, e.generation);
+    }
+}
+
+template <typename SysWrapperT>
+void ExecutorUring<SysWrapperT>::unregisterSocketImpl(
+    SocketBase<SysWrapperT> const *aSocket)
+{
+    delEntry(aSocket->nativeHandle());
+}
+
+template <typename SysWrapperT>
+void ExecutorUring<SysWrapperT>::delEntry(const sock_t aHandle)
+{
+    const auto index = static_cast<std::size_t>(aHandle);
+    if ((index >= entries_.size()) || !entries_[index].socket)
+    {
+        return;
+    }
+    Entry &e = entries_[index];
+    e.socket = nullptr;
+    e.generation = (e.generation + 1) & kGenerationMask;
+    e.pollEvents = 0;
+    e.isRecvArmed = false;
+    cancel(aHandle);
+}
+
+template <typename SysWrapperT>
+void ExecutorUring<SysWrapperT>::armRecv(const sock_t aHandle,
+                                         const uint32_t aGeneration)
+{
+    io_uring_sqe *sqe = getSqe();
+    if (!sqe)
+    {
+        BaseT::reportError(EBUSY);
+        return;
+    }
+    sqe->opcode = IORING_OP_RECVMSG;
+    sqe->fd = aHandle;
+    sqe->addr = reinterpret_cast<uint64_t>(&recvMsg_);
+    sqe->len = 1;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = kBufferGroup;
+    sqe->user_data =
+        userData(kRecv, aGeneration, static_cast<uint32_t>(aHandle));
+    entries_[static_cast<std::size_t>(aHandle)].isRecvArmed = true;
+}
+
+template <typename SysWrapperT>
+void ExecutorUring<SysWrapperT>::armPoll(const sock_t aHandle,
+                                         const uint32_t aGeneration,
+                                         const uint32_t aNativeEvents)
+{
+    io_uring_sqe *sqe = getSqe();
+    if (!sqe)
+    {
+        BaseT::reportError(EBUSY);
+        return;
+    }
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = aHandle;
+    sqe->poll32_events = aNativeEvents;
+    sqe->user_data =
+        userData(kPoll, aGeneration, static_cast<uint32_t>(aHandle));
+    entries_[static_cast<std::size_t>(aHandle)].pollEvents = aNativeEvents;
+}
+
+template <typename SysWrapperT>
+void ExecutorUring<SysWrapperT>::updatePoll(const sock_t aHandle,
+                                            const uint32_t aGeneration,
+                                            const uint32_t aNativeEvents)
+{
+    io_uring_sqe *sqe = getSqe();
+    if (!sqe)
+    {
+        BaseT::reportError(EBUSY);
+        return;
+    }
+    // request in flight is modified or removed in place. If it has already
+    // completed the update fails, completion is handled as usual and
+    // request is re-armed with new events.
+    sqe->opcode = IORING_OP_POLL_REMOVE;
+    sqe->fd = -1;
+    sqe->addr = userData(kPoll, aGeneration, static_cast<uint32_t>(aHandle));
+    if (aNativeEvents)
+    {
+        sqe->len = IORING_POLL_UPDATE_EVENTS;
+        sqe->poll32_events = aNativeEvents;
+    }
+    sqe->user_data = userData(kCancel, 0, static_cast<uint32_t>(aHandle));
+    entries_[static_cast<std::size_t>(aHandle)].pollEvents = aNativeEvents;
+}
+
+template <typename SysWrapperT>
+void ExecutorUring<SysWrapperT>::rearmPoll(const sock_t aHandle,
+                                           const uint32_t aGeneration)
+{
+    Entry *e = entry(aHandle, aGeneration);
+    if (!e || !e->socket->handler())
+    {
+        return;
+    }
+    const uint32_t nativeEvents = pollEvents(e->socket->eventMask());
+    if (nativeEvents == e->pollEvents)
+    {
+        return;
+    }
+    if (e->pollEvents)
+    {
+        updatePoll(aHandle, aGeneration, nativeEvents);
+    }
+    else
+    {
+        armPoll(aHandle, aGeneration, nativeEvents);
+    }
+}
+
+template <typename SysWrapperT>
+bool ExecutorUring<SysWrapperT>::isReadPending(
+    const sock_t aHandle) const noexcept
+{
+    // drained sockets are few, usually none
+    const auto isSame = [aHandle](const PendingRead &aRead) {
+        return aRead.handle == aHandle;
+    };
+    return std::any_of(pendingReads_.begin(), pendingReads_.end(), isSame) ||
+           std::any_of(drainingReads_.begin(), drainingReads_.end(), isSame);
+}
+
+template <typename SysWrapperT>
+void ExecutorUring<SysWrapperT>::armWakeup(const sock_t aHandle) noexcept
+{
+    io_uring_sqe *sqe = getSqe();
+    if (!sqe)
+    {
+        BaseT::reportError(EBUSY);
+        return;
+    }
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = aHandle;
+    sqe->poll32_events = POLLIN;
+    sqe->user_data = userData(kWakeup, 0, static_cast<uint32_t>(aHandle));
+}
+
+template <typename SysWrapperT>
+void ExecutorUring<SysWrapperT>::cancel(const sock_t aHandle)
+{
+    io_uring_sqe *sqe = getSqe();
+    if (!sqe)
+    {
+        BaseT::reportError(EBUSY);
+        return;
+    }
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = aHandle;
+    sqe->cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+    sqe->user_data = userData(kCancel, 0, static_cast<uint32_t>(aHandle));
+    // socket is usually closed right after it is removed from executor, so
+    // cancel requests while descriptor still refers to it
+    if (submit(0, 0, nullptr, 0) == kSocketError)
+    {
+        BaseT::reportError(SysWrapperT::lastErrorCode());
+    }
+}
+
+template <typename SysWrapperT>
+void ExecutorUring<SysWrapperT>::cancelRecv(const sock_t aHandle,
+                                            const uint32_t aGeneration)
+{
+    io_uring_sqe *sqe = getSqe();
+    if (!sqe)
+    {
+        BaseT::reportError(EBUSY);
+        return;
+    }
+    // only recvmsg request is cancelled, poll request of socket stays
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = userData(kRecv, aGeneration, static_cast<uint32_t>(aHandle));
+    sqe->user_data = userData(kCancel, 0, static_cast<uint32_t>(aHandle));
+}
+
+template <typename SysWrapperT>
+void ExecutorUring<SysWrapperT>::postSendToImpl(
+    SocketBase<SysWrapperT> &aSocket, const Address &aDst, CBuffer aBuf,
+    std::error_code &aEc)
+{
+    if (!aSocket.isOpen() || !initRing() || freeSendSlots_.empty())
+    {
+        aSocket.sendTo(aDst, aBuf, aEc);
+        return;
+    }
+    io_uring_sqe *sqe = getSqe();
+    if (!sqe)
+    {
+        aSocket.sendTo(aDst, aBuf, aEc);
+        return;
+    }
+
+    const uint32_t slotIndex = freeSendSlots_.back();
+    freeSendSlots_.pop_back();
+    SendSlot &slot = sendSlots_[slotIndex];
+    slot.data.assign(static_cast<char const *>(aBuf.data()),
+                     static_cast<char const *>(aBuf.data()) + aBuf.size());
+    std::memcpy(&slot.addr, aDst.nativeDataConst(), aDst.capacity());
+    slot.iov.iov_base = slot.data.data();
+    slot.iov.iov_len = slot.data.size();
+    std::memset(&slot.msg, 0, sizeof(slot.msg));
+    slot.msg.msg_name = &slot.addr;
+    slot.msg.msg_namelen = static_cast<socklen_t>(aDst.capacity());
+    slot.msg.msg_iov = &slot.iov;
+    slot.msg.msg_iovlen = 1;
+
+    sqe->opcode = IORING_OP_SENDMSG;
+    sqe->fd = aSocket.nativeHandle();
+    sqe->addr = reinterpret_cast<uint64_t>(&slot.msg);
+    sqe->len = 1;
+    sqe->user_data = userData(kSend, 0, slotIndex);
+}
+
+template <typename SysWrapperT>
+void ExecutorUring<SysWrapperT>::watchWakeupImpl(const sock_t aHandle) noexcept
+{
+    if (!initRing())
+    {
+        BaseT::reportError(SysWrapperT::lastErrorCode());
+        return;
+    }
+    armWakeup(aHandle);
+}
+
+template <typename SysWrapperT>
+void ExecutorUring<SysWrapperT>::flushImpl() noexcept
+{
+    if ((ringHandle_ != kInvalidSocket) &&
+        (submit(0, 0, nullptr, 0) == kSocketError))
+    {
+        BaseT::reportError(SysWrapperT::lastErrorCode());
+    }
+}
+
+template <typename SysWrapperT>
+typename ExecutorUring<SysWrapperT>::Entry *ExecutorUring<SysWrapperT>::entry(
+    const sock_t aHandle, const uint32_t aGeneration) noexcept
+{
+    const auto index = static_cast<std::size_t>(aHandle);
+    if ((index < entries_.size()) && entries_[index].socket &&
+        (entries_[index].generation == aGeneration))
+    {
+        return &entries_[index];
+    }
+    return nullptr;
+}
+
+template <typename SysWrapperT>
+uint32_t ExecutorUring<SysWrapperT>::pollEvents(
+    const uint8_t aEventMask) noexcept
+{
+    uint32_t result = 0;
+    // reading of recv sockets is done by recvmsg request
+    if ((aEventMask & BaseT::EventsT::kRead) &&
+        !(aEventMask & BaseT::EventsT::kRecv))
+    {
+        result |= POLLIN;
+    }
+    if (aEventMask & BaseT::EventsT::kWrite)
+    {
+        result |= POLLOUT;
+    }
+    if (aEventMask & BaseT::EventsT::kExceptCond)
+    {
+        result |= POLLPRI;
+    }
+    return result;
+}
+
+template <typename SysWrapperT>
+uint8_t ExecutorUring<SysWrapperT>::events(
+    const uint32_t aNativeEvents,
+    const SocketBase<SysWrapperT> &aSocket) noexcept
+{
+    uint8_t result = BaseT::EventsT::kNone;
+    // error queue with completions of zero-copy sends isn't readability
+    const uint32_t readEvents =
+        (aSocket.zeroCopyPendingCount() > 0)
+            ? (POLLIN | POLLHUP)
+            : (POLLIN | POLLERR | POLLHUP);
+    if (aNativeEvents & readEvents)
+    {
+        result |= BaseT::EventsT::kRead;
+    }
+    if (aNativeEvents & POLLOUT)
+    {
+        result |= BaseT::EventsT::kWrite;
+    }
+    // error queue, e.g. completions of zero-copy sends, is handled as
+    // exception condition as well
+    if (aNativeEvents & (POLLPRI | POLLERR))
+    {
+        result |= BaseT::EventsT::kExceptCond;
+    }
+    return result;
+}
+
+template <typename SysWrapperT>
+uint64_t ExecutorUring<SysWrapperT>::userData(const eRequestKind aKind,
+                                              const uint32_t aGeneration,
+                                              const uint32_t aIndex) noexcept
+{
+    return (static_cast<uint64_t>(aKind) << 56) |
+           (static_cast<uint64_t>(aGeneration & kGenerationMask) << 32) |
+           aIndex;
+}
+
+template <typename SysWrapperT>
+typename ExecutorUring<SysWrapperT>::eRequestKind
+ExecutorUring<SysWrapperT>::kind(const uint64_t aUserData) noexcept
+{
+    return static_cast<eRequestKind>(aUserData >> 56);
+}
+
+template <typename SysWrapperT>
+uint32_t ExecutorUring<SysWrapperT>::generation(
+    const uint64_t aUserData) noexcept
+{
+    return static_cast<uint32_t>(aUserData >> 32) & kGenerationMask;
+}
+
+template <typename SysWrapperT>
+uint32_t ExecutorUring<SysWrapperT>::index(const uint64_t aUserData) noexcept
+{
+    return static_cast<uint32_t>(aUserData);
+}
+}  // namespace ndt
+
+#endif /* ndt_executor_uring_impl_h */
@@ -0,0 +1,93 @@
+#ifndef ndt_waker_impl_h
+#define ndt_waker_impl_h
+
+#include <atomic>
+#include <cstdint>
+
+#include "../../common.h"
+#include "../../useful_base_types.h"
+
+namespace ndt
+{
+/*! \class Waker
+    \brief Descriptor which becomes readable when notify is called from any
+   thread, executors watch it to interrupt blocking wait. Backed by eventfd, so
+   any number of notifications is drained by a single read.
+ */
+template <typename SysWrapperT>
+class Waker final
+    : private NoCopyAble
+    , private NoMoveAble
+{
+   public:
+    ~Waker();
+    Waker() noexcept;
+
+    // must be called from executor's thread
+    bool open() noexcept;
+    bool isOpen() const noexcept;
+    sock_t nativeHandle() const noexcept;
+    void drain() noexcept;
+
+    // can be called from any thread, does nothing until waker is open
+    void notify() noexcept;
+
+   private:
+    std::atomic_bool isOpen_ = false;
+    sock_t handle_ = kInvalidSocket;
+};
+
+template <typename SysWrapperT>
+Waker<SysWrapperT>::~Waker()
+{
+    if (handle_ != kInvalidSocket)
+    {
+        SysWrapperT::close(handle_);
+    }
+}
+
+template <typename SysWrapperT>
+Waker<SysWrapperT>::Waker() noexcept = default;
+
+template <typename SysWrapperT>
+bool Waker<SysWrapperT>::open() noexcept
+{
+    if (handle_ == kInvalidSocket)
+    {
+        handle_ = SysWrapperT::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        isOpen_ = (handle_ != kInvalidSocket);
+    }
+    return handle_ != kInvalidSocket;
+}
+
+template <typename SysWrapperT>
+bool Waker<SysWrapperT>::isOpen() const noexcept
+{
+    return handle_ != kInvalidSocket;
+}
+
+template <typename SysWrapperT>
+sock_t Waker<SysWrapperT>::nativeHandle() const noexcept
+{
+    return handle_;
+}
+
+template <typename SysWrapperT>
+void Waker<SysWrapperT>::drain() noexcept
+{
+    uint64_t value = 0;
+    SysWrapperT::read(handle_, &value, sizeof(value));
+}
+
+template <typename SysWrapperT>
+void Waker<SysWrapperT>::notify() noexcept
+{
+    if (isOpen_)
+    {
+        const uint64_t value = 1;
+        SysWrapperT::write(handle_, &value, sizeof(value));
+    }
+}
+}  // namespace ndt
+
+#endif /* ndt_waker_impl_h */
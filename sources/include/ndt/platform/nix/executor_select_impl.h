@@ -1,6 +1,9 @@
 #ifndef ndt_executor_select_impl_h
 #define ndt_executor_select_impl_h
 
+#include <array>
+#include <climits>
+
 #include "../../common.h"
 #include "../../executor_select_base.h"
 
@@ -20,7 +23,9 @@ class ExecutorSelect
    private:
     inline int selectImpl() noexcept
     {
-        return SysWrapperT::select(numfds_, &(BaseT::readfds_),
+        // waker descriptor isn't counted in numfds_, it is not in master sets
+        const int numfds = std::max(numfds_, BaseT::waker_.nativeHandle() + 1);
+        return SysWrapperT::select(numfds, &(BaseT::readfds_),
                                    &(BaseT::writefds_), &(BaseT::exceptfds_),
                                    BaseT::timeoutPtr_);
     }
@@ -31,12 +36,19 @@ class ExecutorSelect
 
     void addSocketImpl(SocketBase<SysWrapperT>* aSocket) noexcept;
     void delNativeHandleImpl(const sock_t aHandle) noexcept;
-    void delHandlerImpl(HandlerSelectBase<SysWrapperT>* aHandler) noexcept;
 
-    static sock_t numDescrs(const sock_t aCurrentMax, fd_set const* aFDs);
-    void updateNumfds() noexcept;
+    // highest registered descriptor, -1 if there is none
+    sock_t maxHandle() const noexcept;
+
+    using WordT = unsigned long long;
+    static constexpr std::size_t kWordBits = sizeof(WordT) * CHAR_BIT;
+    static constexpr std::size_t kWordCount =
+        (BaseT::kMaxFDCount + kWordBits - 1) / kWordBits;
 
     int numfds_ = 0;
+    // bit per registered descriptor, so that new numfds_ is found by
+    // checking a few words instead of every descriptor
+    std::array<WordT, kWordCount> registered_{};
 };
 
 template <typename SysWrapperT>
@@ -46,28 +58,18 @@ template <typename SysWrapperT>
 ExecutorSelect<SysWrapperT>::ExecutorSelect() noexcept = default;
 
 template <typename SysWrapperT>
-sock_t ExecutorSelect<SysWrapperT>::numDescrs(const sock_t aCurrentMax,
-                                              const fd_set* aFDs)
+sock_t ExecutorSelect<SysWrapperT>::maxHandle() const noexcept
 {
-    sock_t maxDescr = 0;
-    for (int i = aCurrentMax - 2; i >= 0; --i)
+    for (std::size_t i = kWordCount; i > 0; --i)
     {
-        if (FD_ISSET(i, aFDs))
+        if (const WordT word = registered_[i - 1])
         {
-            maxDescr = i + 1;
-            break;
+            const auto highestBit = kWordBits - 1 -
+                static_cast<std::size_t>(__builtin_clzll(word));
+            return static_cast<sock_t>((i - 1) * kWordBits + highestBit);
         }
     }
-    return maxDescr;
-}
-
-template <typename SysWrapperT>
-void ExecutorSelect<SysWrapperT>::updateNumfds() noexcept
-{
-    const auto numReadFDs = numDescrs(numfds_, &(BaseT::masterReadFDs_));
-    const auto numWriteFDs = numDescrs(numfds_, &(BaseT::masterWriteFDs_));
-    const auto numExceptFDs = numDescrs(numfds_, &(BaseT::masterExceptFDs_));
-    numfds_ = std::max(std::max(numReadFDs, numWriteFDs), numExceptFDs);
+    return -1;
 }
 
 template <typename SysWrapperT>
@@ -79,42 +81,21 @@ void ExecutorSelect<SysWrapperT>::addSocketImpl(
     {
         numfds_ = kHandle + 1;
     }
-    BaseT::fdInfos_[static_cast<std::size_t>(kHandle)] = aSocket;
+    const auto index = static_cast<std::size_t>(kHandle);
+    BaseT::fdInfos_[index] = aSocket;
+    registered_[index / kWordBits] |= WordT{1} << (index % kWordBits);
 }
 
 template <typename SysWrapperT>
 void ExecutorSelect<SysWrapperT>::delNativeHandleImpl(
     const sock_t aHandle) noexcept
 {
+    const auto index = static_cast<std::size_t>(aHandle);
+    BaseT::fdInfos_[index] = nullptr;
+    registered_[index / kWordBits] &= ~(WordT{1} << (index % kWordBits));
     if (aHandle == numfds_ - 1)
     {
-        updateNumfds();
-    }
-
-    BaseT::fdInfos_[static_cast<std::size_t>(aHandle)] = nullptr;
-}
-
-template <typename SysWrapperT>
-void ExecutorSelect<SysWrapperT>::delHandlerImpl(
-    HandlerSelectBase<SysWrapperT>* aHandler) noexcept
-{
-    const std::size_t kNumFDs = static_cast<std::size_t>(numfds_);
-    int maxDeletedHandle = -1;
-    for (std::size_t i = 0; i < kNumFDs; ++i)
-    {
-        if (BaseT::fdInfos_[i] && (BaseT::fdInfos_[i]->handler() == aHandler))
-        {
-            maxDeletedHandle = static_cast<int>(i);
-            BaseT::setFlag(maxDeletedHandle, false, &(BaseT::masterReadFDs_));
-            BaseT::setFlag(maxDeletedHandle, false, &(BaseT::masterWriteFDs_));
-            BaseT::setFlag(maxDeletedHandle, false, &(BaseT::masterExceptFDs_));
-            BaseT::fdInfos_[i]->handler_ = nullptr;
-            BaseT::fdInfos_[i] = nullptr;
-        }
-    }
-    if (maxDeletedHandle == numfds_ - 1)
-    {
-        updateNumfds();
+        numfds_ = maxHandle() + 1;
     }
 }
 }  // namespace ndt
@@ -0,0 +1,128 @@
+#ifndef ndt_waker_impl_h
+#define ndt_waker_impl_h
+
+#include <array>
+#include <atomic>
+
+#include "../../common.h"
+#include "../../useful_base_types.h"
+
+namespace ndt
+{
+/*! \class Waker
+    \brief Descriptor which becomes readable when notify is called from any
+   thread, executors watch it to interrupt blocking wait. Backed by
+   non-blocking pipe, full pipe means that wakeup is already pending.
+ */
+template <typename SysWrapperT>
+class Waker final
+    : private NoCopyAble
+    , private NoMoveAble
+{
+   public:
+    ~Waker();
+    Waker() noexcept;
+
+    // must be called from executor's thread
+    bool open() noexcept;
+    bool isOpen() const noexcept;
+    sock_t nativeHandle() const noexcept;
+    void drain() noexcept;
+
+    // can be called from any thread, does nothing until waker is open
+    void notify() noexcept;
+
+   private:
+    static bool makeNonBlocking(const int aHandle) noexcept;
+    void closeHandles() noexcept;
+
+    std::atomic_bool isOpen_ = false;
+    std::array<int, 2> handles_ = {kInvalidSocket, kInvalidSocket};
+};
+
+template <typename SysWrapperT>
+Waker<SysWrapperT>::~Waker()
+{
+    closeHandles();
+}
+
+template <typename SysWrapperT>
+Waker<SysWrapperT>::Waker() noexcept = default;
+
+template <typename SysWrapperT>
+bool Waker<SysWrapperT>::open() noexcept
+{
+    if (handles_[0] != kInvalidSocket)
+    {
+        return true;
+    }
+    std::array<int, 2> handles;
+    if (SysWrapperT::pipe(handles.data()) == kSocketError)
+    {
+        return false;
+    }
+    handles_ = handles;
+    if (!makeNonBlocking(handles_[0]) || !makeNonBlocking(handles_[1]))
+    {
+        closeHandles();
+        return false;
+    }
+    isOpen_ = true;
+    return true;
+}
+
+template <typename SysWrapperT>
+bool Waker<SysWrapperT>::isOpen() const noexcept
+{
+    return handles_[0] != kInvalidSocket;
+}
+
+template <typename SysWrapperT>
+sock_t Waker<SysWrapperT>::nativeHandle() const noexcept
+{
+    return handles_[0];
+}
+
+template <typename SysWrapperT>
+void Waker<SysWrapperT>::drain() noexcept
+{
+    char data[64];
+    while (SysWrapperT::read(handles_[0], data, sizeof(data)) > 0)
+    {
+    }
+}
+
+template <typename SysWrapperT>
+void Waker<SysWrapperT>::notify() noexcept
+{
+    if (isOpen_)
+    {
+        const char value = 1;
+        SysWrapperT::write(handles_[1], &value, sizeof(value));
+    }
+}
+
+template <typename SysWrapperT>
+bool Waker<SysWrapperT>::makeNonBlocking(const int aHandle) noexcept
+{
+    const int flags = SysWrapperT::fcntl(aHandle, F_GETFL, 0);
+    return (flags != kSocketError) &&
+           (SysWrapperT::fcntl(aHandle, F_SETFL, flags | O_NONBLOCK) !=
+            kSocketError);
+}
+
+template <typename SysWrapperT>
+void Waker<SysWrapperT>::closeHandles() noexcept
+{
+    for (auto &handle: handles_)
+    {
+        if (handle != kInvalidSocket)
+        {
+            SysWrapperT::close(handle);
+            handle = kInvalidSocket;
+        }
+    }
+}
+}  // namespace ndt
+
+#endif /* ndt_waker_impl_h */
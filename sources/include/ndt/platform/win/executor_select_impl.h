@@ -29,7 +29,6 @@ class ExecutorSelect
     }
     void addSocketImpl(SocketBase<SysWrapperT>* aSocket) noexcept;
     void delNativeHandleImpl(const sock_t aHandle) noexcept;
-    void delHandlerImpl(HandlerSelectBase<SysWrapperT>* aHandler) noexcept;
 
     std::size_t infoIndex(const sock_t aHandle) const noexcept;
     std::size_t firstVacantIndex() const noexcept;
@@ -101,38 +100,6 @@ void ExecutorSelect<SysWrapperT>::delNativeHandleImpl(
         BaseT::fdInfos_[index] = nullptr;
     }
 }
-
-template <typename SysWrapperT>
-void ExecutorSelect<SysWrapperT>::delHandlerImpl(
-    HandlerSelectBase<SysWrapperT>* aHandler) noexcept
-{
-    for (std::size_t i = 0; i < numfds_;)
-    {
-        if (BaseT::fdInfos_[i] && (BaseT::fdInfos_[i]->handler() == aHandler))
-        {
-            const auto handleToDelete = BaseT::fdInfos_[i]->nativeHandle();
-            BaseT::setFlag(handleToDelete, false, &(BaseT::masterReadFDs_));
-            BaseT::setFlag(handleToDelete, false, &(BaseT::masterWriteFDs_));
-            BaseT::setFlag(handleToDelete, false, &(BaseT::masterExceptFDs_));
-            if (i + 1 < numfds_)
-            {
-                BaseT::fdInfos_[i]->handler_ = nullptr;
-                BaseT::fdInfos_[i] = BaseT::fdInfos_[numfds_ - 1];
-                BaseT::fdInfos_[numfds_ - 1] = nullptr;
-            }
-            else
-            {
-                BaseT::fdInfos_[i]->handler_ = nullptr;
-                BaseT::fdInfos_[i] = nullptr;
-            }
-            --numfds_;
-        }
-        else
-        {
-            ++i;
-        }
-    }
-}
 }  // namespace ndt
 
 #endif /* ndt_executor_select_impl_h */
\ No newline at end of file
@@ -0,0 +1,128 @@
+#ifndef ndt_waker_impl_h
+#define ndt_waker_impl_h
+
+#include <atomic>
+
+#include "../../common.h"
+#include "../../useful_base_types.h"
+
+namespace ndt
+{
+/*! \class Waker
+    \brief Descriptor which becomes readable when notify is called from any
+   thread, executors watch it to interrupt blocking wait. select on Windows
+   accepts sockets only, so it is a non-blocking UDP socket bound to loopback
+   which sends datagrams to itself.
+ */
+template <typename SysWrapperT>
+class Waker final
+    : private NoCopyAble
+    , private NoMoveAble
+{
+   public:
+    ~Waker();
+    Waker() noexcept;
+
+    // must be called from executor's thread
+    bool open() noexcept;
+    bool isOpen() const noexcept;
+    sock_t nativeHandle() const noexcept;
+    void drain() noexcept;
+
+    // can be called from any thread, does nothing until waker is open
+    void notify() noexcept;
+
+   private:
+    void closeHandle() noexcept;
+
+    std::atomic_bool isOpen_ = false;
+    sock_t handle_ = kInvalidSocket;
+    sockaddr_in address_ = {};
+};
+
+template <typename SysWrapperT>
+Waker<SysWrapperT>::~Waker()
+{
+    closeHandle();
+}
+
+template <typename SysWrapperT>
+Waker<SysWrapperT>::Waker() noexcept = default;
+
+template <typename SysWrapperT>
+bool Waker<SysWrapperT>::open() noexcept
+{
+    if (handle_ != kInvalidSocket)
+    {
+        return true;
+    }
+    handle_ = SysWrapperT::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (handle_ == kInvalidSocket)
+    {
+        return false;
+    }
+    address_.sin_family = AF_INET;
+    address_.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address_.sin_port = 0;
+    salen_t addressLen = sizeof(address_);
+    u_long isNonBlocking = 1;
+    auto *address = reinterpret_cast<sockaddr *>(&address_);
+    if ((SysWrapperT::bind(handle_, address, addressLen) == kSocketError) ||
+        (SysWrapperT::getsockname(handle_, address, &addressLen) ==
+         kSocketError) ||
+        (SysWrapperT::ioctlsocket(handle_, FIONBIO, &isNonBlocking) ==
+         kSocketError))
+    {
+        closeHandle();
+        return false;
+    }
+    isOpen_ = true;
+    return true;
+}
+
+template <typename SysWrapperT>
+bool Waker<SysWrapperT>::isOpen() const noexcept
+{
+    return handle_ != kInvalidSocket;
+}
+
+template <typename SysWrapperT>
+sock_t Waker<SysWrapperT>::nativeHandle() const noexcept
+{
+    return handle_;
+}
+
+template <typename SysWrapperT>
+void Waker<SysWrapperT>::drain() noexcept
+{
+    char data[64];
+    while (SysWrapperT::recvfrom(handle_, data, sizeof(data), 0, nullptr,
+                                 nullptr) > 0)
+    {
+    }
+}
+
+template <typename SysWrapperT>
+void Waker<SysWrapperT>::notify() noexcept
+{
+    if (isOpen_)
+    {
+        const char value = 1;
+        SysWrapperT::sendto(handle_, &value, sizeof(value), 0,
+                            reinterpret_cast<const sockaddr *>(&address_),
+                            sizeof(address_));
+    }
+}
+
+template <typename SysWrapperT>
+void Waker<SysWrapperT>::closeHandle() noexcept
+{
+    if (handle_ != kInvalidSocket)
+    {
+        SysWrapperT::close(handle_);
+        handle_ = kInvalidSocket;
+    }
+}
+}  // namespace ndt
+
+#endif /* ndt_waker_impl_h */
@@ -0,0 +1,287 @@
+#ifndef ndt_send_queue_h
+#define ndt_send_queue_h
+
+#include <cassert>
+#include <cstdint>
+#include <system_error>
+#include <vector>
+
+#include "address.h"
+#include "buffer.h"
+#include "exception.h"
+#include "socket.h"
+#include "useful_base_types.h"
+
+namespace ndt
+{
+/*! \enum eDropPolicy
+    \brief What SendQueue drops when datagram doesn't fit into it:
+   - kDropNewest - the datagram being queued;
+   - kDropOldest - as many of the oldest queued datagrams as needed.
+ */
+enum class eDropPolicy : uint8_t
+{
+    kDropNewest = 0,
+    kDropOldest
+};
+
+/*! \class SendQueue
+    \brief Outbound datagrams of non-blocking socket which were not accepted
+   because socket's send buffer was full. Queue keeps socket's write interest
+   on only while it isn't empty, so handler of the socket must define
+   writeHandlerImpl and call flush from it. Memory is bounded by number of
+   datagrams and by their total size, buffers of slots are reused, so warmed
+   up queue doesn't allocate. Socket must outlive the queue.
+ */
+template <typename SysWrapperT>
+class SendQueue final
+    : private NoCopyAble
+    , private NoMoveAble
+{
+   public:
+    static constexpr std::size_t kDefaultMaxCount = 1024;
+    static constexpr std::size_t kDefaultMaxBytes = 1 << 20;
+
+    ~SendQueue();
+    explicit SendQueue(SocketBase<SysWrapperT> &aSocket,
+                       const std::size_t aMaxCount = kDefaultMaxCount,
+                       const std::size_t aMaxBytes = kDefaultMaxBytes,
+                       const eDropPolicy aPolicy = eDropPolicy::kDropNewest);
+
+    // sends datagram right away if nothing is queued and socket accepts it,
+    // queues it otherwise; fails with no_buffer_space if datagram is dropped
+    void sendTo(const Address &aDst, CBuffer aBuf);
+    void sendTo(const Address &aDst, CBuffer aBuf, std::error_code &aEc);
+    // sends queued datagrams until socket's send buffer is full again.
+    // Datagram which fails with other error is dropped and error is
+    // reported.
+    void flush();
+    void flush(std::error_code &aEc);
+    void clear();
+
+    bool empty() const noexcept;
+    std::size_t size() const noexcept;
+    std::size_t bytes() const noexcept;
+    std::size_t maxCount() const noexcept;
+    std::size_t maxBytes() const noexcept;
+    eDropPolicy dropPolicy() const noexcept;
+    // number of datagrams dropped since the queue was created
+    std::size_t droppedCount() const noexcept;
+
+   private:
+    struct Slot
+    {
+        Address dst_;
+        std::vector<char> data_;
+    };
+
+    bool push(const Address &aDst, CBuffer aBuf);
+    void pop() noexcept;
+    void updateInterest();
+
+    SocketBase<SysWrapperT> &socket_;
+    const std::size_t maxCount_;
+    const std::size_t maxBytes_;
+    const eDropPolicy dropPolicy_;
+    // ring of maxCount_ slots allocated on first push
+    std::vector<Slot> slots_;
+    std::size_t head_ = 0;
+    std::size_t size_ = 0;
+    std::size_t bytes_ = 0;
+    std::size_t droppedCount_ = 0;
+};
+
+template <typename SysWrapperT>
+SendQueue<SysWrapperT>::~SendQueue()
+{
+    if (!empty())
+    {
+        socket_.writeInterest(false);
+    }
+}
+
+template <typename SysWrapperT>
+SendQueue<SysWrapperT>::SendQueue(SocketBase<SysWrapperT> &aSocket,
+                                  const std::size_t aMaxCount,
+                                  const std::size_t aMaxBytes,
+                                  const eDropPolicy aPolicy)
+    : socket_(aSocket)
+    , maxCount_(aMaxCount)
+    , maxBytes_(aMaxBytes)
+    , dropPolicy_(aPolicy)
+{
+    assert(aMaxCount > 0 && "Error: queue must fit at least one datagram");
+    socket_.writeInterest(false);
+}
+
+template <typename SysWrapperT>
+void SendQueue<SysWrapperT>::sendTo(const Address &aDst, CBuffer aBuf)
+{
+    std::error_code ec;
+    SendQueue::sendTo(aDst, aBuf, ec);
+    throw_if_error(ec);
+}
+
+template <typename SysWrapperT>
+void SendQueue<SysWrapperT>::sendTo(const Address &aDst, CBuffer aBuf,
+                                    std::error_code &aEc)
+{
+    if (empty())
+    {
+        std::error_code ec;
+        socket_.sendTo(aDst, aBuf, ec);
+        if (ec != std::errc::operation_would_block)
+        {
+            if (ec)
+            {
+                aEc = ec;
+            }
+            return;
+        }
+    }
+    // queued datagrams go first, so that order is preserved
+    if (!push(aDst, aBuf))
+    {
+        ++droppedCount_;
+        aEc = std::make_error_code(std::errc::no_buffer_space);
+        return;
+    }
+    updateInterest();
+}
+
+template <typename SysWrapperT>
+void SendQueue<SysWrapperT>::flush()
+{
+    std::error_code ec;
+    SendQueue::flush(ec);
+    throw_if_error(ec);
+}
+
+template <typename SysWrapperT>
+void SendQueue<SysWrapperT>::flush(std::error_code &aEc)
+{
+    while (!empty())
+    {
+        const Slot &slot = slots_[head_];
+        const CBuffer data(slot.data_.data(), slot.data_.size());
+        std::error_code ec;
+        socket_.sendTo(slot.dst_, data, ec);
+        if (ec == std::errc::operation_would_block)
+        {
+            break;
+        }
+        pop();
+        if (ec)
+        {
+            ++droppedCount_;
+            aEc = ec;
+            break;
+        }
+    }
+    updateInterest();
+}
+
+template <typename SysWrapperT>
+void SendQueue<SysWrapperT>::clear()
+{
+    while (!empty())
+    {
+        pop();
+    }
+    updateInterest();
+}
+
+template <typename SysWrapperT>
+bool SendQueue<SysWrapperT>::empty() const noexcept
+{
+    return size_ == 0;
+}
+
+template <typename SysWrapperT>
+std::size_t SendQueue<SysWrapperT>::size() const noexcept
+{
+    return size_;
+}
+
+template <typename SysWrapperT>
+std::size_t SendQueue<SysWrapperT>::bytes() const noexcept
+{
+    return bytes_;
+}
+
+template <typename SysWrapperT>
+std::size_t SendQueue<SysWrapperT>::maxCount() const noexcept
+{
+    return maxCount_;
+}
+
+template <typename SysWrapperT>
+std::size_t SendQueue<SysWrapperT>::maxBytes() const noexcept
+{
+    return maxBytes_;
+}
+
+template <typename SysWrapperT>
+eDropPolicy SendQueue<SysWrapperT>::dropPolicy() const noexcept
+{
+    return dropPolicy_;
+}
+
+template <typename SysWrapperT>
+std::size_t SendQueue<SysWrapperT>::droppedCount() const noexcept
+{
+    return droppedCount_;
+}
+
+template <typename SysWrapperT>
+bool SendQueue<SysWrapperT>::push(const Address &aDst, CBuffer aBuf)
+{
+    if (aBuf.size() > maxBytes_)
+    {
+        return false;
+    }
+    const auto isFull = [this, &aBuf]() {
+        return (size_ == maxCount_) || (bytes_ + aBuf.size() > maxBytes_);
+    };
+    if (isFull())
+    {
+        if (dropPolicy_ == eDropPolicy::kDropNewest)
+        {
+            return false;
+        }
+        while (isFull())
+        {
+            pop();
+            ++droppedCount_;
+        }
+    }
+    if (slots_.empty())
+    {
+        slots_.resize(maxCount_);
+    }
+    Slot &slot = slots_[(head_ + size_) % maxCount_];
+    slot.dst_ = aDst;
+    const char *data = aBuf.data<char>();
+    slot.data_.assign(data, data + aBuf.size());
+    ++size_;
+    bytes_ += aBuf.size();
+    return true;
+}
+
+template <typename SysWrapperT>
+void SendQueue<SysWrapperT>::pop() noexcept
+{
+    // capacity of slot's buffer is kept for the next datagram
+    bytes_ -= slots_[head_].data_.size();
+    head_ = (head_ + 1) % maxCount_;
+    --size_;
+}
+
+template <typename SysWrapperT>
+void SendQueue<SysWrapperT>::updateInterest()
+{
+    socket_.writeInterest(!empty());
+}
+}  // namespace ndt
+
+#endif /* ndt_send_queue_h */
@@ -0,0 +1,597 @@
+#ifndef ndt_shm_ring_h
+#define ndt_shm_ring_h
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+#include "address.h"
+#include "buffer.h"
+#include "common.h"
+#include "exception.h"
+#include "socket.h"
+
+#if defined(__linux__)
+namespace ndt
+{
+/*! \class ShmRing
+    \brief Flags of shared memory transport between two processes of the same
+   host. Socket<ShmRing> has sendTo/recvFrom of UDP socket, but messages are
+   copied through lock-free rings in memfd segment without system calls while
+   receiver is busy.
+
+   Creating side makes segment and wakeup descriptors on open, its handles()
+   are passed to the other process by fork or SCM_RIGHTS, which opens socket
+   with ShmRing::Attach of them. Each side has eventfd which becomes readable
+   when its ring gets messages after it was found empty, executor watches it
+   as socket descriptor. Addresses aren't used: destination of sendTo is
+   ignored and sender reported by recvFrom is unspecified. Methods of
+   SocketBase which need network socket fail with ENOTSOCK.
+ */
+class ShmRing final
+{
+   public:
+    using Socket = ndt::Socket<ShmRing, SocketOps>;
+
+    struct Handles
+    {
+        int memory_ = kInvalidSocket;
+        int creatorWakeup_ = kInvalidSocket;
+        int attacherWakeup_ = kInvalidSocket;
+    };
+
+    static constexpr uint32_t kDefaultSlotCount = 1024;
+    static constexpr uint32_t kDefaultSlotSize = 2048;
+
+    // aSlotCount is number of messages each ring holds, it must be power of
+    // 2, aSlotSize is max size of message
+    static ShmRing Create(const uint32_t aSlotCount = kDefaultSlotCount,
+                          const uint32_t aSlotSize = kDefaultSlotSize) noexcept;
+    // socket duplicates aHandles, caller keeps ownership of them
+    static ShmRing Attach(const Handles &aHandles) noexcept;
+
+    bool isCreator() const noexcept;
+    uint32_t slotCount() const noexcept;
+    uint32_t slotSize() const noexcept;
+    const Handles &handles() const noexcept;
+
+    friend bool operator==(const ShmRing &aVal1, const ShmRing &aVal2);
+    friend bool operator!=(const ShmRing &aVal1, const ShmRing &aVal2);
+
+   private:
+    template <typename FlagsT, typename SysWrapperT>
+    friend class ndt::Socket;
+
+    ShmRing(const bool aIsCreator, const uint32_t aSlotCount,
+            const uint32_t aSlotSize, const Handles &aHandles) noexcept;
+    bool _isCreator;
+    uint32_t _slotCount;
+    uint32_t _slotSize;
+    Handles _handles;
+};
+
+namespace details
+{
+inline constexpr std::size_t kShmCacheLineSize = 64;
+
+// atomics are shared by processes, so they must not be implemented by locks
+static_assert(std::atomic<uint64_t>::is_always_lock_free &&
+                  std::atomic<uint32_t>::is_always_lock_free,
+              "Error: shared memory rings require lock-free atomics");
+
+struct ShmRingSlot
+{
+    std::atomic<uint64_t> sequence_;
+    uint32_t size_;
+};
+
+struct ShmRingQueue
+{
+    alignas(kShmCacheLineSize) std::atomic<uint64_t> enqueuePos_;
+    alignas(kShmCacheLineSize) std::atomic<uint64_t> dequeuePos_;
+    // consumer found ring empty and waits for wakeup
+    alignas(kShmCacheLineSize) std::atomic<uint32_t> isConsumerWaiting_;
+};
+
+// beginning of segment, slots of the rings follow it
+struct ShmRingSegment
+{
+    static constexpr uint64_t kMagic = 0x676e69726d68746eULL;
+
+    uint64_t magic_;
+    uint32_t slotCount_;
+    uint32_t slotSize_;
+    // the first ring carries messages from creator to attacher
+    ShmRingQueue queues_[2];
+};
+
+/*! \class ShmRingView
+    \brief Bounded queue of D. Vyukov over slots of one ring of the segment.
+   Any number of producers and consumers can use it concurrently, sequence
+   of a slot tells whose turn it is.
+ */
+class ShmRingView final
+{
+   public:
+    ShmRingView() noexcept = default;
+    ShmRingView(ShmRingSegment *aSegment, const std::size_t aIndex) noexcept;
+
+    static std::size_t slotStride(const uint32_t aSlotSize) noexcept;
+    static std::size_t segmentSize(const uint32_t aSlotCount,
+                                   const uint32_t aSlotSize) noexcept;
+    // constructs header and rings in zeroed memory of segmentSize bytes
+    static ShmRingSegment *init(void *aMemory, const uint32_t aSlotCount,
+                                const uint32_t aSlotSize) noexcept;
+
+    // returns false if ring is full
+    bool push(CBuffer aData) noexcept;
+    // Returns false if ring is empty. Message which doesn't fit into aBuf is
+    // truncated, aBuf is resized to the copied part.
+    bool pop(Buffer &aBuf) noexcept;
+    // producer wakes consumer if it is waiting, returns true then
+    bool takeWaiting() noexcept;
+    void setWaiting() noexcept;
+
+   private:
+    ShmRingSlot *slot(const uint64_t aPos) noexcept;
+
+    ShmRingQueue *queue_ = nullptr;
+    char *slots_ = nullptr;
+    std::size_t stride_ = 0;
+    uint64_t mask_ = 0;
+    uint32_t slotSize_ = 0;
+};
+}  // namespace details
+
+template <typename SysWrapperT>
+class Socket<ShmRing, SysWrapperT> final : public SocketBase<SysWrapperT>
+{
+   public:
+    typedef ShmRing SocketT;
+    typedef SysWrapperT SysCallsT;
+    ~Socket();
+    Socket() = delete;
+    Socket(Socket &&) noexcept;
+    Socket &operator=(Socket &&) noexcept;
+    Socket(Context<SysWrapperT> &aContext, const ShmRing &aFlags) noexcept;
+
+    void open();
+    void open(std::error_code &aEc);
+    void close();
+    void close(std::error_code &aEc);
+    using SocketBase<SysWrapperT>::handler;
+    // executor must not wait for wakeup in recv, so socket is switched to
+    // non-blocking mode when it gets handler
+    void handler(HandlerSelectBase<SysWrapperT> *aHandler);
+    // descriptors which other process passes to ShmRing::Attach
+    ShmRing::Handles handles() const noexcept;
+    // Copies aBuf into peer's ring, fails with no_buffer_space if it is full
+    // and with message_size if aBuf is longer than slot. aDst is ignored.
+    std::size_t sendTo(const Address &aDst, CBuffer aBuf);
+    std::size_t sendTo(const Address &aDst, CBuffer aBuf, std::error_code &aEc);
+    // Blocking socket waits for message, non-blocking one fails with
+    // operation_would_block when ring is empty.
+    std::size_t recvFrom(Buffer &aBuf, Address &aSender);
+    std::size_t recvFrom(Buffer &aBuf, Address &aSender, std::error_code &aEc);
+    std::size_t send(CBuffer aBuf);
+    std::size_t send(CBuffer aBuf, std::error_code &aEc);
+    std::size_t recv(Buffer &aBuf);
+    std::size_t recv(Buffer &aBuf, std::error_code &aEc);
+    ShmRing flags() const noexcept;
+
+   private:
+    void create(std::error_code &aEc);
+    void attach(std::error_code &aEc);
+    void map(const std::size_t aSize, std::error_code &aEc);
+    void release() noexcept;
+    void assignError(std::error_code &aEc) const;
+
+    ShmRing flags_;
+    void *memory_ = MAP_FAILED;
+    std::size_t memorySize_ = 0;
+    sock_t memoryHandle_ = kInvalidSocket;
+    // eventfd of peer, own one is socket handle
+    sock_t peerWakeup_ = kInvalidSocket;
+    details::ShmRingView inbound_;
+    details::ShmRingView outbound_;
+};
+
+template <typename SysWrapperT>
+Socket<ShmRing, SysWrapperT>::~Socket()
+{
+}
+
+template <typename SysWrapperT>
+Socket<ShmRing, SysWrapperT>::Socket(Socket &&aOther) noexcept
+    : SocketBase<SysWrapperT>(std::move(aOther))
+    , flags_(aOther.flags_)
+    , memory_(std::exchange(aOther.memory_, MAP_FAILED))
+    , memorySize_(std::exchange(aOther.memorySize_, 0))
+    , memoryHandle_(std::exchange(aOther.memoryHandle_, kInvalidSocket))
+    , peerWakeup_(std::exchange(aOther.peerWakeup_, kInvalidSocket))
+    , inbound_(std::exchange(aOther.inbound_, {}))
+    , outbound_(std::exchange(aOther.outbound_, {}))
+{
+}
+
+template <typename SysWrapperT>
+Socket<ShmRing, SysWrapperT> &Socket<ShmRing, SysWrapperT>::operator=(
+    Socket &&aOther) noexcept
+{
+    SocketBase<SysWrapperT>::operator=(std::move(aOther));
+    std::swap(aOther.flags_, flags_);
+    std::swap(aOther.memory_, memory_);
+    std::swap(aOther.memorySize_, memorySize_);
+    std::swap(aOther.memoryHandle_, memoryHandle_);
+    std::swap(aOther.peerWakeup_, peerWakeup_);
+    std::swap(aOther.inbound_, inbound_);
+    std::swap(aOther.outbound_, outbound_);
+    return *this;
+}
+
+template <typename SysWrapperT>
+Socket<ShmRing, SysWrapperT>::Socket(Context<SysWrapperT> &aContext,
+                                     const ShmRing &aFlags) noexcept
+    : SocketBase<SysWrapperT>(aContext), flags_(aFlags)
+{
+    // messages are read from rings, not from eventfd
+    this->isNativeRecv_ = false;
+}
+
+template <typename SysWrapperT>
+void Socket<ShmRing, SysWrapperT>::open()
+{
+    std::error_code ec;
+    Socket::open(ec);
+    throw_if_error(ec);
+}
+
+template <typename SysWrapperT>
+void Socket<ShmRing, SysWrapperT>::open(std::error_code &aEc)
+{
+    if (flags_.isCreator())
+    {
+        create(aEc);
+    }
+    else
+    {
+        attach(aEc);
+    }
+    if (aEc)
+    {
+        release();
+        return;
+    }
+    const bool isCreator = flags_.isCreator();
+    auto *segment = static_cast<details::ShmRingSegment *>(memory_);
+    inbound_ = details::ShmRingView(segment, isCreator ? 1 : 0);
+    outbound_ = details::ShmRingView(segment, isCreator ? 0 : 1);
+    if (this->handler_ != nullptr)
+    {
+        SocketBase<SysWrapperT>::nonBlocking(true, aEc);
+        if (aEc)
+        {
+            release();
+            return;
+        }
+    }
+    this->isOpen_ = true;
+    this->setIsSubscribed(true);
+}
+
+template <typename SysWrapperT>
+void Socket<ShmRing, SysWrapperT>::close()
+{
+    std::error_code ec;
+    Socket::close(ec);
+    throw_if_error(ec);
+}
+
+template <typename SysWrapperT>
+void Socket<ShmRing, SysWrapperT>::close(std::error_code &aEc)
+{
+    if (!this->isOpen_)
+    {
+        return;
+    }
+    // closes own eventfd
+    SocketBase<SysWrapperT>::close(aEc);
+    if (aEc)
+    {
+        return;
+    }
+    release();
+}
+
+template <typename SysWrapperT>
+void Socket<ShmRing, SysWrapperT>::handler(
+    HandlerSelectBase<SysWrapperT> *aHandler)
+{
+    if ((aHandler != nullptr) && this->isOpen_ && !this->isNonBlocking_)
+    {
+        SocketBase<SysWrapperT>::nonBlocking(true);
+    }
+    SocketBase<SysWrapperT>::handler(aHandler);
+}
+
+template <typename SysWrapperT>
+ShmRing::Handles Socket<ShmRing, SysWrapperT>::handles() const noexcept
+{
+    ShmRing::Handles result;
+    result.memory_ = memoryHandle_;
+    if (flags_.isCreator())
+    {
+        result.creatorWakeup_ = this->socketHandle_;
+        result.attacherWakeup_ = peerWakeup_;
+    }
+    else
+    {
+        result.creatorWakeup_ = peerWakeup_;
+        result.attacherWakeup_ = this->socketHandle_;
+    }
+    return result;
+}
+
+template <typename SysWrapperT>
+std::size_t Socket<ShmRing, SysWrapperT>::sendTo(const Address &aDst,
+                                                 CBuffer aBuf)
+{
+    std::error_code ec;
+    const auto bytesSent = Socket::sendTo(aDst, aBuf, ec);
+    throw_if_error(ec);
+    return bytesSent;
+}
+
+template <typename SysWrapperT>
+std::size_t Socket<ShmRing, SysWrapperT>::sendTo(const Address &, CBuffer aBuf,
+                                                 std::error_code &aEc)
+{
+    return Socket::send(aBuf, aEc);
+}
+
+template <typename SysWrapperT>
+std::size_t Socket<ShmRing, SysWrapperT>::recvFrom(Buffer &aBuf,
+                                                   Address &aSender)
+{
+    std::error_code ec;
+    const auto bytesReceived = Socket::recvFrom(aBuf, aSender, ec);
+    throw_if_error(ec);
+    return bytesReceived;
+}
+
+template <typename SysWrapperT>
+std::size_t Socket<ShmRing, SysWrapperT>::recvFrom(Buffer &aBuf,
+                                                   Address &aSender,
+                                                   std::error_code &aEc)
+{
+    aSender.reset();
+    return Socket::recv(aBuf, aEc);
+}
+
+template <typename SysWrapperT>
+std::size_t Socket<ShmRing, SysWrapperT>::send(CBuffer aBuf)
+{
+    std::error_code ec;
+    const auto bytesSent = Socket::send(aBuf, ec);
+    throw_if_error(ec);
+    return bytesSent;
+}
+
+template <typename SysWrapperT>
+std::size_t Socket<ShmRing, SysWrapperT>::send(CBuffer aBuf,
+                                               std::error_code &aEc)
+{
+    if (aBuf.size() > flags_.slotSize())
+    {
+        aEc = std::make_error_code(std::errc::message_size);
+        return 0;
+    }
+    if (!outbound_.push(aBuf))
+    {
+        aEc = std::make_error_code(std::errc::no_buffer_space);
+        return 0;
+    }
+    // pairs with fence of consumer: either it sees the message or we see
+    // that it waits
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (outbound_.takeWaiting())
+    {
+        const uint64_t value = 1;
+        SysWrapperT::write(peerWakeup_, reinterpret_cast<cbufp_t>(&value),
+                           sizeof(value));
+    }
+    return aBuf.size();
+}
+
+template <typename SysWrapperT>
+std::size_t Socket<ShmRing, SysWrapperT>::recv(Buffer &aBuf)
+{
+    std::error_code ec;
+    const auto bytesReceived = Socket::recv(aBuf, ec);
+    throw_if_error(ec);
+    return bytesReceived;
+}
+
+template <typename SysWrapperT>
+std::size_t Socket<ShmRing, SysWrapperT>::recv(Buffer &aBuf,
+                                               std::error_code &aEc)
+{
+    Buffer capacity = aBuf;
+    for (;;)
+    {
+        aBuf = capacity;
+        if (inbound_.pop(aBuf))
+        {
+            return aBuf.size();
+        }
+        uint64_t value = 0;
+        if (this->isNonBlocking_)
+        {
+            // readiness is cleared before consumer is marked as waiting, so
+            // that wakeup of the next message isn't lost
+            SysWrapperT::read(this->socketHandle_,
+                              reinterpret_cast<bufp_t>(&value), sizeof(value));
+        }
+        inbound_.setWaiting();
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        aBuf = capacity;
+        if (inbound_.pop(aBuf))
+        {
+            return aBuf.size();
+        }
+        if (this->isNonBlocking_)
+        {
+            aEc = std::make_error_code(std::errc::operation_would_block);
+            aBuf = Buffer(capacity.data(), 0);
+            return 0;
+        }
+        if ((SysWrapperT::read(this->socketHandle_,
+                              reinterpret_cast<bufp_t>(&value),
+                              sizeof(value)) == kSocketError) &&
+            (SysWrapperT::lastErrorCode() != EINTR))
+        {
+            assignError(aEc);
+            aBuf = Buffer(capacity.data(), 0);
+            return 0;
+        }
+    }
+}
+
+template <typename SysWrapperT>
+ShmRing Socket<ShmRing, SysWrapperT>::flags() const noexcept
+{
+    return flags_;
+}
+
+template <typename SysWrapperT>
+void Socket<ShmRing, SysWrapperT>::create(std::error_code &aEc)
+{
+    const uint32_t slotCount = flags_.slotCount();
+    if ((slotCount == 0) || (slotCount & (slotCount - 1)) ||
+        (flags_.slotSize() == 0))
+    {
+        aEc = std::make_error_code(std::errc::invalid_argument);
+        return;
+    }
+    const std::size_t size =
+        details::ShmRingView::segmentSize(slotCount, flags_.slotSize());
+    memoryHandle_ = SysWrapperT::memfd_create("ndt_shm_ring", MFD_CLOEXEC);
+    if ((memoryHandle_ == kInvalidSocket) ||
+        (SysWrapperT::ftruncate(memoryHandle_, static_cast<off_t>(size)) ==
+         kSocketError))
+    {
+        assignError(aEc);
+        return;
+    }
+    map(size, aEc);
+    if (aEc)
+    {
+        return;
+    }
+    // memfd is zero filled
+    details::ShmRingView::init(memory_, slotCount, flags_.slotSize());
+    this->socketHandle_ = SysWrapperT::eventfd(0, EFD_CLOEXEC);
+    peerWakeup_ = SysWrapperT::eventfd(0, EFD_CLOEXEC);
+    if ((this->socketHandle_ == kInvalidSocket) ||
+        (peerWakeup_ == kInvalidSocket))
+    {
+        assignError(aEc);
+    }
+}
+
+template <typename SysWrapperT>
+void Socket<ShmRing, SysWrapperT>::attach(std::error_code &aEc)
+{
+    const ShmRing::Handles &handles = flags_.handles();
+    memoryHandle_ = SysWrapperT::fcntl(handles.memory_, F_DUPFD_CLOEXEC, 0);
+    this->socketHandle_ =
+        SysWrapperT::fcntl(handles.attacherWakeup_, F_DUPFD_CLOEXEC, 0);
+    peerWakeup_ =
+        SysWrapperT::fcntl(handles.creatorWakeup_, F_DUPFD_CLOEXEC, 0);
+    struct stat info = {};
+    if ((memoryHandle_ == kInvalidSocket) ||
+        (this->socketHandle_ == kInvalidSocket) ||
+        (peerWakeup_ == kInvalidSocket) ||
+        (SysWrapperT::fstat(memoryHandle_, &info) == kSocketError))
+    {
+        assignError(aEc);
+        return;
+    }
+    const auto size = static_cast<std::size_t>(info.st_size);
+    if (size < sizeof(details::ShmRingSegment))
+    {
+        aEc = std::make_error_code(std::errc::invalid_argument);
+        return;
+    }
+    map(size, aEc);
+    if (aEc)
+    {
+        return;
+    }
+    const auto *segment = static_cast<details::ShmRingSegment *>(memory_);
+    const uint32_t slotCount = segment->slotCount_;
+    // ring masks positions with slotCount - 1
+    if ((segment->magic_ != details::ShmRingSegment::kMagic) ||
+        (slotCount == 0) || (slotCount & (slotCount - 1)) ||
+        (segment->slotSize_ == 0) ||
+        (details::ShmRingView::segmentSize(segment->slotCount_,
+                                           segment->slotSize_) != size))
+    {
+        aEc = std::make_error_code(std::errc::invalid_argument);
+        return;
+    }
+    // attacher learns sizes from creator
+    flags_ = ShmRing(false, segment->slotCount_, segment->slotSize_, handles);
+}
+
+template <typename SysWrapperT>
+void Socket<ShmRing, SysWrapperT>::map(const std::size_t aSize,
+                                       std::error_code &aEc)
+{
+    memory_ = SysWrapperT::mmap(nullptr, aSize, PROT_READ | PROT_WRITE,
+                                MAP_SHARED, memoryHandle_, 0);
+    if (memory_ == MAP_FAILED)
+    {
+        assignError(aEc);
+        return;
+    }
+    memorySize_ = aSize;
+}
+
+template <typename SysWrapperT>
+void Socket<ShmRing, SysWrapperT>::release() noexcept
+{
+    if (memory_ != MAP_FAILED)
+    {
+        SysWrapperT::munmap(memory_, memorySize_);
+        memory_ = MAP_FAILED;
+        memorySize_ = 0;
+    }
+    for (sock_t *handle: {&memoryHandle_, &peerWakeup_})
+    {
+        if (*handle != kInvalidSocket)
+        {
+            SysWrapperT::close(*handle);
+            *handle = kInvalidSocket;
+        }
+    }
+    // own eventfd is closed by SocketBase once socket is open
+    if (!this->isOpen_ && (this->socketHandle_ != kInvalidSocket))
+    {
+        SysWrapperT::close(this->socketHandle_);
+        this->socketHandle_ = kInvalidSocket;
+    }
+    inbound_ = {};
+    outbound_ = {};
+}
+
+template <typename SysWrapperT>
+void Socket<ShmRing, SysWrapperT>::assignError(std::error_code &aEc) const
+{
+    aEc.assign(SysWrapperT::lastErrorCode(), std::system_category());
+}
+}  // namespace ndt
+#endif
+
+#endif /* ndt_shm_ring_h */
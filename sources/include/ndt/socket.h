@@ -1,13 +1,22 @@
 #ifndef ndt_socket_h
 #define ndt_socket_h
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <chrono>
+#include <cstring>
+#include <deque>
 #include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "address.h"
 #include "buffer.h"
 #include "common.h"
 #include "exception.h"
+#include "socket_options.h"
 #include "useful_base_types.h"
 #include "utils.h"
 
@@ -19,33 +28,246 @@ class Context;
 template <typename SysWrapperT>
 class ExecutorSelect;
 
+template <typename SysWrapperT>
+class ExecutorEpoll;
+
+template <typename SysWrapperT>
+class ExecutorUring;
+
 template <typename SysWrapperT>
 class HandlerSelectBase;
 
+#if defined(NDT_COROUTINES)
+template <typename SocketT>
+class RecvFromAwaiter;
+
+template <typename SocketT>
+class SendToAwaiter;
+#endif
+
+/*! \struct IsDualStackFlags
+    \brief True for flags types with isDualStack(), Socket turns
+   IPV6_V6ONLY off on open when it returns true.
+ */
+template <typename FlagsT, typename = void>
+struct IsDualStackFlags : std::false_type
+{
+};
+
+template <typename FlagsT>
+struct IsDualStackFlags<
+    FlagsT, std::void_t<decltype(std::declval<const FlagsT &>().isDualStack())>>
+    : std::true_type
+{
+};
+
+/*! \enum eInterest
+    \brief Events of socket which executor watches, see SocketBase::interest.
+ */
+enum eInterest : uint8_t
+{
+    kInterestNone = 0,
+    kInterestRead = 1 << 0,
+    kInterestWrite = 1 << 1,
+    kInterestExceptCond = 1 << 2,
+    kInterestAll = kInterestRead | kInterestWrite | kInterestExceptCond
+};
+
+/*! \enum ePriority
+    \brief Priority class of socket. Every executor iteration dispatches
+   ready sockets of higher classes first, number of events served per class
+   can be limited, see ExecutorBase::setPriorityLimit.
+ */
+enum class ePriority : uint8_t
+{
+    kHigh = 0,
+    kNormal,
+    kLow
+};
+
+constexpr std::size_t kPriorityCount = 3;
+
+// time when datagram arrived to host, taken by kernel (CLOCK_REALTIME)
+using RecvTimeT = std::chrono::time_point<std::chrono::system_clock,
+                                          std::chrono::nanoseconds>;
+
 template <typename SysWrapperT>
 class SocketBase : private NoCopyAble
 {
+    template <typename ImplT, typename SysWrappersT>
+    friend class ExecutorBase;
+
     template <typename ImplT, typename SysWrappersT>
     friend class ExecutorSelectBase;
 
     template <typename SysWrappersT>
     friend class ExecutorSelect;
 
+    template <typename SysWrappersT>
+    friend class ExecutorEpoll;
+
+    template <typename SysWrappersT>
+    friend class ExecutorUring;
+
    public:
     sock_t nativeHandle() const noexcept;
     bool nonBlocking() const noexcept;
     bool isOpen() const noexcept;
     HandlerSelectBase<SysWrapperT> *handler() const noexcept;
     void handler(HandlerSelectBase<SysWrapperT> *aHandler);
+    // Mask of eInterest values. Event is watched only if it is in the mask
+    // and handler defines method for it, all events are in the mask by
+    // default. Changing the mask costs O(1) in executor and keeps socket
+    // registered, so reading can be paused while consumer of datagrams is
+    // behind and write readiness can be watched only while there is
+    // something to send. Events which were reported before the mask was
+    // changed aren't dispatched, except datagrams which io_uring executor
+    // has already received.
+    uint8_t interest() const noexcept;
+    void interest(const uint8_t aMask);
+    bool readInterest() const noexcept;
+    void readInterest(const bool aIsOn);
+    bool writeInterest() const noexcept;
+    void writeInterest(const bool aIsOn);
+    // max number of datagrams which recvBatch and sendBatch pass to a single
+    // system call
+    static constexpr std::size_t kMaxBatchSize = 64;
+
+    // kNormal by default, takes effect from the next executor iteration
+    ePriority priority() const noexcept;
+    void priority(const ePriority aPriority) noexcept;
 
     std::size_t sendTo(const Address &aDst, CBuffer aBuf);
     std::size_t sendTo(const Address &aDst, CBuffer aBuf, std::error_code &aEc);
+    void postSendTo(const Address &aDst, CBuffer aBuf);
+    void postSendTo(const Address &aDst, CBuffer aBuf, std::error_code &aEc);
     std::size_t recvFrom(Buffer &aBuf, Address &aSender);
     std::size_t recvFrom(Buffer &aBuf, Address &aSender, std::error_code &aEc);
+    // Besides datagram returns its arrival time if opt::RecvTimestamp is on
+    // (Linux), so time spent in socket's queue and executor's wait can be
+    // told apart from network latency. aTime is zero if kernel didn't
+    // provide it.
+    std::size_t recvFrom(Buffer &aBuf, Address &aSender, RecvTimeT &aTime);
+    std::size_t recvFrom(Buffer &aBuf, Address &aSender, RecvTimeT &aTime,
+                         std::error_code &aEc);
+    // Batch counterparts of sendTo and recvFrom, a single system call moves
+    // up to kMaxBatchSize datagrams on Linux (sendmmsg and recvmmsg), other
+    // platforms send and receive datagrams one by one.
+    // recvBatch receives datagrams which are already queued, sizes of
+    // aBufs[i] are set to sizes of received datagrams. It fails only if no
+    // datagram is received.
+    // sendBatch returns number of sent datagrams, if it is less than aCount
+    // aEc is error of datagram aDsts[result], e.g. operation_would_block.
+    // Versions without aEc throw on error, partial result is lost then.
+    std::size_t recvBatch(Buffer *aBufs, Address *aSenders,
+                          const std::size_t aCount);
+    std::size_t recvBatch(Buffer *aBufs, Address *aSenders,
+                          const std::size_t aCount, std::error_code &aEc);
+    // aTimes[i] is arrival time of datagram aBufs[i], see recvFrom
+    std::size_t recvBatch(Buffer *aBufs, Address *aSenders, RecvTimeT *aTimes,
+                          const std::size_t aCount);
+    std::size_t recvBatch(Buffer *aBufs, Address *aSenders, RecvTimeT *aTimes,
+                          const std::size_t aCount, std::error_code &aEc);
+    std::size_t sendBatch(const Address *aDsts, const CBuffer *aBufs,
+                          const std::size_t aCount);
+    std::size_t sendBatch(const Address *aDsts, const CBuffer *aBufs,
+                          const std::size_t aCount, std::error_code &aEc);
+    // Connected mode for sockets which talk to a single peer: kernel caches
+    // route to aPeer, send and recv don't pass addresses and datagrams from
+    // other peers aren't received. Datagrams can still be sent to other
+    // addresses by sendTo. disconnect returns socket to unconnected mode.
+    void connect(const Address &aPeer);
+    void connect(const Address &aPeer, std::error_code &aEc);
+    void disconnect();
+    void disconnect(std::error_code &aEc);
+    bool isConnected() const noexcept;
+    std::size_t send(CBuffer aBuf);
+    std::size_t send(CBuffer aBuf, std::error_code &aEc);
+    std::size_t recv(Buffer &aBuf);
+    std::size_t recv(Buffer &aBuf, std::error_code &aEc);
+    std::size_t sendBatch(const CBuffer *aBufs, const std::size_t aCount);
+    std::size_t sendBatch(const CBuffer *aBufs, const std::size_t aCount,
+                          std::error_code &aEc);
+    std::size_t recvBatch(Buffer *aBufs, const std::size_t aCount);
+    std::size_t recvBatch(Buffer *aBufs, const std::size_t aCount,
+                          std::error_code &aEc);
+    // Sends aBuf as datagrams of aSegmentSize bytes (the last one may be
+    // shorter). With UDP GSO (Linux, UDP_SEGMENT) large chunks of aBuf pass
+    // the stack once and are split late, otherwise datagrams are sent one by
+    // one. Returns number of sent bytes, it is less than size of aBuf only
+    // on error.
+    std::size_t sendSegmented(const Address &aDst, CBuffer aBuf,
+                              const std::size_t aSegmentSize);
+    std::size_t sendSegmented(const Address &aDst, CBuffer aBuf,
+                              const std::size_t aSegmentSize,
+                              std::error_code &aEc);
+    // Receives datagram or, if UDP GRO is on, several datagrams of the same
+    // flow coalesced by kernel, aBuf should fit 64 KiB then. Returned view
+    // splits aBuf into received datagrams.
+    Segments recvSegmented(Buffer &aBuf, Address &aSender);
+    Segments recvSegmented(Buffer &aBuf, Address &aSender,
+                           std::error_code &aEc);
+    // UDP_GRO, stays off without error if kernel doesn't support it
+    bool gro() const noexcept;
+    void gro(const bool aIsOn);
+    void gro(const bool aIsOn, std::error_code &aEc) noexcept;
+    // SO_ZEROCOPY (Linux 5.0+ for UDP), stays off without error if kernel
+    // doesn't support it. Handler of socket which is run by executor must
+    // implement exceptionConditionHandlerImpl and call
+    // readZeroCopyCompletions from it: while sends are pending, error queue
+    // is reported only as exception condition.
+    bool zeroCopy() const noexcept;
+    void zeroCopy(const bool aIsOn);
+    void zeroCopy(const bool aIsOn, std::error_code &aEc) noexcept;
+    // shorter datagrams are copied, pinning pages costs more than copying them
+    std::size_t zeroCopyThreshold() const noexcept;
+    void zeroCopyThreshold(const std::size_t aSize) noexcept;
+    // Sends aBuf with MSG_ZEROCOPY if zero-copy is on and aBuf isn't shorter
+    // than zeroCopyThreshold(), returns true then. aBuf must stay unchanged
+    // until it is passed to callback of readZeroCopyCompletions. Returns
+    // false if aBuf was copied and can be reused right away.
+    bool sendToZeroCopy(const Address &aDst, CBuffer aBuf);
+    bool sendToZeroCopy(const Address &aDst, CBuffer aBuf,
+                        std::error_code &aEc);
+    // Reads completions of zero-copy sends from socket's error queue and
+    // calls aCallback(CBuffer) for every buffer which kernel doesn't
+    // reference anymore. Executor reports the error queue as exception
+    // condition, so it is called from exceptionConditionHandlerImpl. Returns
+    // number of released buffers. Buffers which are pending when socket is
+    // closed aren't reported.
+    template <typename CallbackT>
+    std::size_t readZeroCopyCompletions(CallbackT &&aCallback);
+    template <typename CallbackT>
+    std::size_t readZeroCopyCompletions(CallbackT &&aCallback,
+                                        std::error_code &aEc);
+    // number of zero-copy sends whose buffers kernel still references
+    std::size_t zeroCopyPendingCount() const noexcept;
+    // number of zero-copy sends socket keeps track of, sends completed out of
+    // order stay tracked until all older ones are completed
+    std::size_t zeroCopyTrackedCount() const noexcept;
     void close();
     void close(std::error_code &aEc);
     void nonBlocking(const bool isNonBlocking);
     void nonBlocking(const bool isNonBlocking, std::error_code &aEc) noexcept;
+    // Typed socket options, see opt namespace. get returns value which
+    // kernel actually uses.
+    template <typename OptionT>
+    void set(const typename OptionT::ValueType aValue);
+    template <typename OptionT>
+    void set(const typename OptionT::ValueType aValue,
+             std::error_code &aEc) noexcept;
+    template <typename OptionT>
+    typename OptionT::ValueType get() const;
+    template <typename OptionT>
+    typename OptionT::ValueType get(std::error_code &aEc) const noexcept;
+    void reusePort(const bool aIsReusePort);
+    void reusePort(const bool aIsReusePort, std::error_code &aEc) noexcept;
+    // SO_BUSY_POLL: blocking reads and polls of the socket spin on the
+    // device queue for up to aDuration before sleeping (Linux only, values
+    // above net.core.busy_poll require CAP_NET_ADMIN)
+    void busyPoll(const std::chrono::microseconds aDuration);
+    void busyPoll(const std::chrono::microseconds aDuration,
+                  std::error_code &aEc) noexcept;
 
    protected:
     ~SocketBase();
@@ -60,14 +282,78 @@ class SocketBase : private NoCopyAble
     void open(int socket_family, int socket_type, int protocol,
               std::error_code &aEc);
 
+    void bind(const Address &aLocal, std::error_code &aEc);
     void bind(const uint8_t socket_family, const uint16_t aPort,
               std::error_code &aEc);
 
+    // events of handler which executor currently watches
+    uint8_t eventMask() const noexcept;
+
+    // Executor keeps registered sockets in intrusive list of their handler,
+    // so sockets of destroyed handler are found without scanning all
+    // descriptors.
+    void linkHandler() noexcept;
+    void unlinkHandler() noexcept;
+
+    static constexpr std::size_t kDefaultZeroCopyThreshold = 10 * 1024;
+
+    struct ZeroCopyState
+    {
+        struct Send
+        {
+            CBuffer buf_;
+            bool isPending_;
+        };
+
+        // kernel numbers zero-copy sends of socket from 0, send with index i
+        // has number base_ + i. Completed sends are removed from the front,
+        // so only sends since the oldest pending one are kept.
+        std::deque<Send> sends_;
+        uint32_t base_ = 0;
+        std::size_t pendingCount_ = 0;
+        std::size_t threshold_ = kDefaultZeroCopyThreshold;
+        bool isOn_ = false;
+    };
+
+    // max number of segments and bytes kernel accepts in one GSO send
+    static constexpr std::size_t kMaxGsoSegments = 64;
+    static constexpr std::size_t kMaxGsoBytes = 65000;
+
+    enum class eSupport : uint8_t
+    {
+        kUnknown = 0,
+        kSupported,
+        kUnsupported
+    };
+
+    bool isGsoSupported() noexcept;
+#if defined(SCM_TIMESTAMPNS)
+    // room for arrival time in control data of received message
+    static constexpr std::size_t kRecvTimeControlSize =
+        CMSG_SPACE(sizeof(timespec));
+    static RecvTimeT recvTime(msghdr &aMsg) noexcept;
+#endif
+    void sendGso(const Address &aDst, CBuffer aBuf,
+                 const std::size_t aSegmentSize, std::error_code &aEc);
+
     sock_t socketHandle_ = kInvalidSocket;
     bool isOpen_ = false;
     bool isNonBlocking_ = false;
+    bool isGro_ = false;
+    bool isConnected_ = false;
+    // executor may receive datagrams of socket by its own requests (io_uring
+    // recvmsg), false for descriptors which only signal readiness
+    bool isNativeRecv_ = true;
+    // GSO support is checked on the first segmented send
+    eSupport gsoSupport_ = eSupport::kUnknown;
+    ZeroCopyState zeroCopy_;
+    uint8_t interest_ = kInterestAll;
+    ePriority priority_ = ePriority::kNormal;
     std::reference_wrapper<Context<SysWrapperT>> context_;
     HandlerSelectBase<SysWrapperT> *handler_ = nullptr;
+    HandlerSelectBase<SysWrapperT> *linkedHandler_ = nullptr;
+    SocketBase *prevOfHandler_ = nullptr;
+    SocketBase *nextOfHandler_ = nullptr;
 };
 
 template <typename SysWrapperT>
@@ -91,9 +377,18 @@ SocketBase<SysWrapperT>::SocketBase(SocketBase &&aOther) noexcept
     : socketHandle_(std::exchange(aOther.socketHandle_, kInvalidSocket))
     , isOpen_(std::exchange(aOther.isOpen_, false))
     , isNonBlocking_(std::exchange(aOther.isNonBlocking_, false))
+    , isGro_(std::exchange(aOther.isGro_, false))
+    , isConnected_(std::exchange(aOther.isConnected_, false))
+    , isNativeRecv_(std::exchange(aOther.isNativeRecv_, true))
+    , gsoSupport_(std::exchange(aOther.gsoSupport_, eSupport::kUnknown))
+    , zeroCopy_(std::exchange(aOther.zeroCopy_, {}))
+    , interest_(std::exchange(aOther.interest_, kInterestAll))
+    , priority_(std::exchange(aOther.priority_, ePriority::kNormal))
     , context_(aOther.context_)
     , handler_(nullptr)
 {
+    // executor forgets moved-from socket and registers this one instead
+    aOther.unlinkHandler();
     handler(aOther.handler_);
 }
 
@@ -106,8 +401,17 @@ SocketBase<SysWrapperT> &SocketBase<SysWrapperT>::operator=(
     std::swap(aOther.socketHandle_, socketHandle_);
     std::swap(aOther.isOpen_, isOpen_);
     std::swap(aOther.isNonBlocking_, isNonBlocking_);
+    std::swap(aOther.isGro_, isGro_);
+    std::swap(aOther.isConnected_, isConnected_);
+    std::swap(aOther.isNativeRecv_, isNativeRecv_);
+    std::swap(aOther.gsoSupport_, gsoSupport_);
+    std::swap(aOther.zeroCopy_, zeroCopy_);
+    std::swap(aOther.interest_, interest_);
+    std::swap(aOther.priority_, priority_);
     context_ = aOther.context_;
-    handler_ = aOther.handler_;
+    aOther.unlinkHandler();
+    handler_ = nullptr;
+    handler(aOther.handler_);
     return *this;
 }
 
@@ -143,19 +447,144 @@ void SocketBase<SysWrapperT>::handler(HandlerSelectBase<SysWrapperT> *aHandler)
     {
         return;
     }
-    handler_ = aHandler;
     if (!isOpen())
     {
+        handler_ = aHandler;
         return;
     }
     if (aHandler != nullptr)
     {
+        handler_ = aHandler;
         context_.get().executor().addSocket(this);
     }
     else
     {
+        // executor ignores sockets without handler, so unsubscribe first
         context_.get().executor().delSocket(this);
+        handler_ = nullptr;
+    }
+}
+
+template <typename SysWrapperT>
+uint8_t SocketBase<SysWrapperT>::interest() const noexcept
+{
+    return interest_;
+}
+
+template <typename SysWrapperT>
+void SocketBase<SysWrapperT>::interest(const uint8_t aMask)
+{
+    const auto mask = static_cast<uint8_t>(aMask & kInterestAll);
+    if (mask == interest_)
+    {
+        return;
+    }
+    interest_ = mask;
+    context_.get().executor().updateSocket(this);
+}
+
+template <typename SysWrapperT>
+bool SocketBase<SysWrapperT>::readInterest() const noexcept
+{
+    return interest_ & kInterestRead;
+}
+
+template <typename SysWrapperT>
+void SocketBase<SysWrapperT>::readInterest(const bool aIsOn)
+{
+    interest(static_cast<uint8_t>(aIsOn ? (interest_ | kInterestRead)
+                                        : (interest_ & ~kInterestRead)));
+}
+
+template <typename SysWrapperT>
+bool SocketBase<SysWrapperT>::writeInterest() const noexcept
+{
+    return interest_ & kInterestWrite;
+}
+
+template <typename SysWrapperT>
+void SocketBase<SysWrapperT>::writeInterest(const bool aIsOn)
+{
+    interest(static_cast<uint8_t>(aIsOn ? (interest_ | kInterestWrite)
+                                        : (interest_ & ~kInterestWrite)));
+}
+
+template <typename SysWrapperT>
+ePriority SocketBase<SysWrapperT>::priority() const noexcept
+{
+    return priority_;
+}
+
+template <typename SysWrapperT>
+void SocketBase<SysWrapperT>::priority(const ePriority aPriority) noexcept
+{
+    priority_ = aPriority;
+}
+
+template <typename SysWrapperT>
+uint8_t SocketBase<SysWrapperT>::eventMask() const noexcept
+{
+    using EventsT = typename HandlerSelectBase<SysWrapperT>::eTrakingEvents;
+    static_assert((uint8_t{EventsT::kRead} == kInterestRead) &&
+                      (uint8_t{EventsT::kWrite} == kInterestWrite) &&
+                      (uint8_t{EventsT::kExceptCond} == kInterestExceptCond),
+                  "Error: interest must match events of handler");
+    if (!handler_)
+    {
+        return EventsT::kNone;
+    }
+    // datagrams are received only while socket is read, descriptor which
+    // isn't native socket is read by recvHandlerImpl's socket on readiness
+    const uint8_t modifiers =
+        ((interest_ & kInterestRead) && isNativeRecv_)
+            ? (EventsT::kEdgeTriggered | EventsT::kRecv)
+            : EventsT::kEdgeTriggered;
+    return handler_->eventMask_ & (interest_ | modifiers);
+}
+
+template <typename SysWrapperT>
+void SocketBase<SysWrapperT>::linkHandler() noexcept
+{
+    if (linkedHandler_ == handler_)
+    {
+        return;
+    }
+    unlinkHandler();
+    if (!handler_)
+    {
+        return;
+    }
+    linkedHandler_ = handler_;
+    nextOfHandler_ = handler_->sockets_;
+    if (nextOfHandler_)
+    {
+        nextOfHandler_->prevOfHandler_ = this;
+    }
+    handler_->sockets_ = this;
+}
+
+template <typename SysWrapperT>
+void SocketBase<SysWrapperT>::unlinkHandler() noexcept
+{
+    if (!linkedHandler_)
+    {
+        return;
+    }
+    if (prevOfHandler_)
+    {
+        prevOfHandler_->nextOfHandler_ = nextOfHandler_;
+    }
+    else
+    {
+        linkedHandler_->sockets_ = nextOfHandler_;
+    }
+    if (nextOfHandler_)
+    {
+        nextOfHandler_->prevOfHandler_ = prevOfHandler_;
     }
+    linkedHandler_ = nullptr;
+    prevOfHandler_ = nullptr;
+    nextOfHandler_ = nullptr;
 }
 
 template <typename SysWrapperT>
@@ -191,19 +620,24 @@ void SocketBase<SysWrapperT>::open(int socket_family, int socket_type,
 }
 
 template <typename SysWrapperT>
-void SocketBase<SysWrapperT>::bind(const uint8_t socket_family,
-                                   const uint16_t aPort, std::error_code &aEc)
+void SocketBase<SysWrapperT>::bind(const Address &aLocal, std::error_code &aEc)
 {
-    Address sa(socket_family, aPort);
     const auto result =
-        SysWrapperT::bind(socketHandle_, sa.nativeDataConst(),
-                          static_cast<ndt::salen_t>(sa.capacity()));
+        SysWrapperT::bind(socketHandle_, aLocal.nativeDataConst(),
+                          static_cast<ndt::salen_t>(aLocal.capacity()));
     if (ndt::kSocketError == result)
     {
         aEc.assign(SysWrapperT::lastErrorCode(), std::system_category());
     }
 }
 
+template <typename SysWrapperT>
+void SocketBase<SysWrapperT>::bind(const uint8_t socket_family,
+                                   const uint16_t aPort, std::error_code &aEc)
+{
+    SocketBase::bind(Address(socket_family, aPort), aEc);
+}
+
 template <typename SysWrapperT>
 std::size_t SocketBase<SysWrapperT>::sendTo(const Address &aDst, CBuffer aBuf)
 {
@@ -227,6 +661,24 @@ std::size_t SocketBase<SysWrapperT>::sendTo(const Address &aDst, CBuffer aBuf,
     return static_cast<std::size_t>(bytesSent);
 }
 
+template <typename SysWrapperT>
+void SocketBase<SysWrapperT>::postSendTo(const Address &aDst, CBuffer aBuf)
+{
+    std::error_code ec;
+    SocketBase::postSendTo(aDst, aBuf, ec);
+    throw_if_error(ec);
+}
+
+// Executor may defer sending till the end of current loop iteration to submit
+// all datagrams at once. aBuf is copied, so it can be reused right away.
+// Errors of deferred sending are reported via executor's error handler.
+template <typename SysWrapperT>
+void SocketBase<SysWrapperT>::postSendTo(const Address &aDst, CBuffer aBuf,
+                                         std::error_code &aEc)
+{
+    context_.get().executor().postSendTo(*this, aDst, aBuf, aEc);
+}
+
 template <typename SysWrapperT>
 std::size_t SocketBase<SysWrapperT>::recvFrom(Buffer &aBuf, Address &aSender)
 {
@@ -240,13 +692,14 @@ template <typename SysWrapperT>
 std::size_t SocketBase<SysWrapperT>::recvFrom(Buffer &aBuf, Address &aSender,
                                               std::error_code &aEc)
 {
-    ndt::salen_t addrlen = static_cast<ndt::salen_t>(kV6Capacity);
+    ndt::salen_t addrlen = static_cast<ndt::salen_t>(kMaxAddressCapacity);
     const auto bytesReceived =
         SysWrapperT::recvfrom(socketHandle_, aBuf.data(), aBuf.size(), 0,
                               aSender.nativeData(), &addrlen);
     if (ndt::kSocketError != bytesReceived)
     {
         aBuf.setSize(static_cast<std::size_t>(bytesReceived));
+        aSender.nativeLength(static_cast<std::size_t>(addrlen));
     }
     else
     {
@@ -256,95 +709,1087 @@ std::size_t SocketBase<SysWrapperT>::recvFrom(Buffer &aBuf, Address &aSender,
 }
 
 template <typename SysWrapperT>
-void SocketBase<SysWrapperT>::close()
+std::size_t SocketBase<SysWrapperT>::recvFrom(Buffer &aBuf, Address &aSender,
+                                              RecvTimeT &aTime)
 {
     std::error_code ec;
-    SocketBase::close(ec);
+    const auto bytesReceived = SocketBase::recvFrom(aBuf, aSender, aTime, ec);
     throw_if_error(ec);
+    return bytesReceived;
 }
 
 template <typename SysWrapperT>
-void SocketBase<SysWrapperT>::close(std::error_code &aEc)
+std::size_t SocketBase<SysWrapperT>::recvFrom(Buffer &aBuf, Address &aSender,
+                                              RecvTimeT &aTime,
+                                              std::error_code &aEc)
 {
-    if (!isOpen_)
+    aTime = RecvTimeT{};
+#if defined(SCM_TIMESTAMPNS)
+    iovec iov;
+    iov.iov_base = aBuf.data();
+    iov.iov_len = aBuf.size<std::size_t>();
+    alignas(cmsghdr) char control[kRecvTimeControlSize] = {};
+    msghdr msg = {};
+    msg.msg_name = aSender.nativeData();
+    msg.msg_namelen = static_cast<socklen_t>(kMaxAddressCapacity);
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    const auto bytesReceived = SysWrapperT::recvmsg(socketHandle_, &msg, 0);
+    if (ndt::kSocketError == bytesReceived)
     {
-        return;
+        aEc.assign(SysWrapperT::lastErrorCode(), std::system_category());
+        return 0;
     }
-    setIsSubscribed(false);
-    const auto result = SysWrapperT::close(socketHandle_);
+    aBuf.setSize(static_cast<std::size_t>(bytesReceived));
+    aSender.nativeLength(msg.msg_namelen);
+    aTime = recvTime(msg);
+    return static_cast<std::size_t>(bytesReceived);
+#else
+    return SocketBase::recvFrom(aBuf, aSender, aEc);
+#endif
+}
+
+template <typename SysWrapperT>
+std::size_t SocketBase<SysWrapperT>::recvBatch(Buffer *aBufs,
+                                               Address *aSenders,
+                                               const std::size_t aCount)
+{
+    std::error_code ec;
+    const auto count = SocketBase::recvBatch(aBufs, aSenders, aCount, ec);
+    throw_if_error(ec);
+    return count;
+}
+
+template <typename SysWrapperT>
+std::size_t SocketBase<SysWrapperT>::recvBatch(Buffer *aBufs,
+                                               Address *aSenders,
+                                               const std::size_t aCount,
+                                               std::error_code &aEc)
+{
+    return SocketBase::recvBatch(aBufs, aSenders, nullptr, aCount, aEc);
+}
+
+template <typename SysWrapperT>
+std::size_t SocketBase<SysWrapperT>::recvBatch(Buffer *aBufs,
+                                               Address *aSenders,
+                                               RecvTimeT *aTimes,
+                                               const std::size_t aCount)
+{
+    std::error_code ec;
+    const auto count =
+        SocketBase::recvBatch(aBufs, aSenders, aTimes, aCount, ec);
+    throw_if_error(ec);
+    return count;
+}
+
+template <typename SysWrapperT>
+std::size_t SocketBase<SysWrapperT>::recvBatch(Buffer *aBufs,
+                                               Address *aSenders,
+                                               RecvTimeT *aTimes,
+                                               const std::size_t aCount,
+                                               std::error_code &aEc)
+{
+#if defined(__linux__)
+    const std::size_t count = std::min(aCount, kMaxBatchSize);
+    std::array<mmsghdr, kMaxBatchSize> msgs;
+    std::array<iovec, kMaxBatchSize> iovs;
+    // control data is needed only for arrival times
+    alignas(cmsghdr) char controls[kMaxBatchSize][kRecvTimeControlSize];
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        iovs[i].iov_base = aBufs[i].data();
+        iovs[i].iov_len = aBufs[i].size<std::size_t>();
+        msgs[i] = {};
+        if (aSenders)
+        {
+            msgs[i].msg_hdr.msg_name = aSenders[i].nativeData();
+            msgs[i].msg_hdr.msg_namelen =
+                static_cast<socklen_t>(kMaxAddressCapacity);
+        }
+        msgs[i].msg_hdr.msg_iov = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        if (aTimes)
+        {
+            msgs[i].msg_hdr.msg_control = controls[i];
+            msgs[i].msg_hdr.msg_controllen = sizeof(controls[i]);
+        }
+    }
+    const int result =
+        SysWrapperT::recvmmsg(socketHandle_, msgs.data(),
+                              static_cast<unsigned int>(count), 0, nullptr);
     if (ndt::kSocketError == result)
     {
         aEc.assign(SysWrapperT::lastErrorCode(), std::system_category());
-        return;
+        return 0;
     }
-    socketHandle_ = kInvalidSocket;
-    isOpen_ = false;
+    const auto received = static_cast<std::size_t>(result);
+    for (std::size_t i = 0; i < received; ++i)
+    {
+        aBufs[i].setSize(msgs[i].msg_len);
+        if (aSenders)
+        {
+            aSenders[i].nativeLength(msgs[i].msg_hdr.msg_namelen);
+        }
+        if (aTimes)
+        {
+            aTimes[i] = recvTime(msgs[i].msg_hdr);
+        }
+    }
+    return received;
+#else
+    std::size_t received = 0;
+    for (; received < aCount; ++received)
+    {
+        std::error_code ec;
+        Address sender;
+        Address &senderRef = aSenders ? aSenders[received] : sender;
+        if (aTimes)
+        {
+            SocketBase::recvFrom(aBufs[received], senderRef, aTimes[received],
+                                 ec);
+        }
+        else if (aSenders)
+        {
+            SocketBase::recvFrom(aBufs[received], senderRef, ec);
+        }
+        else
+        {
+            SocketBase::recv(aBufs[received], ec);
+        }
+        if (ec)
+        {
+            if (received == 0)
+            {
+                aEc = ec;
+            }
+            break;
+        }
+    }
+    return received;
+#endif
 }
 
 template <typename SysWrapperT>
-void SocketBase<SysWrapperT>::nonBlocking(const bool isNonBlocking)
+std::size_t SocketBase<SysWrapperT>::sendBatch(const Address *aDsts,
+                                               const CBuffer *aBufs,
+                                               const std::size_t aCount)
 {
     std::error_code ec;
-    SocketBase::nonBlocking(isNonBlocking, ec);
+    const auto count = SocketBase::sendBatch(aDsts, aBufs, aCount, ec);
     throw_if_error(ec);
+    return count;
 }
 
 template <typename SysWrapperT>
-void SocketBase<SysWrapperT>::nonBlocking(const bool isNonBlocking,
-                                          std::error_code &aEc) noexcept
+std::size_t SocketBase<SysWrapperT>::sendBatch(const Address *aDsts,
+                                               const CBuffer *aBufs,
+                                               const std::size_t aCount,
+                                               std::error_code &aEc)
 {
-#if _WIN32
-    u_long isNonBlockingArg = isNonBlocking ? 1 : 0;
-    const int flags =
-        SysWrapperT::ioctlsocket(socketHandle_, FIONBIO, &isNonBlockingArg);
+    std::size_t sent = 0;
+#if defined(__linux__)
+    std::array<mmsghdr, kMaxBatchSize> msgs;
+    std::array<iovec, kMaxBatchSize> iovs;
+    while (sent < aCount)
+    {
+        const std::size_t count = std::min(aCount - sent, kMaxBatchSize);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const CBuffer &buf = aBufs[sent + i];
+            // sendmmsg doesn't modify names and data
+            iovs[i].iov_base = const_cast<buf_t *>(buf.data());
+            iovs[i].iov_len = buf.size<std::size_t>();
+            msgs[i] = {};
+            if (aDsts)
+            {
+                const Address &dst = aDsts[sent + i];
+                msgs[i].msg_hdr.msg_name =
+                    const_cast<sockaddr *>(dst.nativeDataConst());
+                msgs[i].msg_hdr.msg_namelen =
+                    static_cast<socklen_t>(dst.capacity());
+            }
+            msgs[i].msg_hdr.msg_iov = &iovs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+        // partially sent batch means that datagram which follows the sent
+        // ones failed, it is sent again to get its error
+        const int result = SysWrapperT::sendmmsg(
+            socketHandle_, msgs.data(), static_cast<unsigned int>(count), 0);
+        if (ndt::kSocketError == result)
+        {
+            aEc.assign(SysWrapperT::lastErrorCode(), std::system_category());
+            break;
+        }
+        sent += static_cast<std::size_t>(result);
+    }
 #else
-    int flags = SysWrapperT::fcntl(socketHandle_, F_GETFL, 0);
-    if (flags == kSocketError)
+    for (; sent < aCount; ++sent)
+    {
+        std::error_code ec;
+        if (aDsts)
+        {
+            SocketBase::sendTo(aDsts[sent], aBufs[sent], ec);
+        }
+        else
+        {
+            SocketBase::send(aBufs[sent], ec);
+        }
+        if (ec)
+        {
+            aEc = ec;
+            break;
+        }
+    }
+#endif
+    return sent;
+}
+
+template <typename SysWrapperT>
+void SocketBase<SysWrapperT>::connect(const Address &aPeer)
+{
+    std::error_code ec;
+    SocketBase::connect(aPeer, ec);
+    throw_if_error(ec);
+}
+
+template <typename SysWrapperT>
+void SocketBase<SysWrapperT>::connect(const Address &aPeer,
+                                      std::error_code &aEc)
+{
+    if (SysWrapperT::connect(socketHandle_, aPeer.nativeDataConst(),
+                             static_cast<ndt::salen_t>(aPeer.capacity())) ==
+        kSocketError)
     {
         aEc.assign(SysWrapperT::lastErrorCode(), std::system_category());
         return;
     }
+    isConnected_ = true;
+}
 
-    flags = isNonBlocking ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK);
-    flags = SysWrapperT::fcntl(socketHandle_, F_SETFL, flags);
+template <typename SysWrapperT>
+void SocketBase<SysWrapperT>::disconnect()
+{
+    std::error_code ec;
+    SocketBase::disconnect(ec);
+    throw_if_error(ec);
+}
+
+template <typename SysWrapperT>
+void SocketBase<SysWrapperT>::disconnect(std::error_code &aEc)
+{
+    if (!isConnected_)
+    {
+        return;
+    }
+    // connect to address of AF_UNSPEC family dissolves association, Windows
+    // takes any address with zero port instead
+    sockaddr_in unspec = {};
+#if !_WIN32
+    unspec.sin_family = AF_UNSPEC;
 #endif
-    if (flags == kSocketError)
+    if (SysWrapperT::connect(socketHandle_,
+                             reinterpret_cast<const sockaddr *>(&unspec),
+                             sizeof(unspec)) == kSocketError)
     {
         aEc.assign(SysWrapperT::lastErrorCode(), std::system_category());
         return;
     }
-    isNonBlocking_ = isNonBlocking;
+    isConnected_ = false;
 }
 
-template <typename FlagsT, typename SysWrapperT>
-class Socket final : public SocketBase<SysWrapperT>
+template <typename SysWrapperT>
+bool SocketBase<SysWrapperT>::isConnected() const noexcept
 {
-    friend class ExecutorSelect<SysWrapperT>;
-
-   public:
-    typedef FlagsT SocketT;
-    typedef SysWrapperT SysCallsT;
-    ~Socket();
-    Socket() = delete;
-    Socket(Socket &&) noexcept;
-    Socket &operator=(Socket &&) noexcept;
-    Socket(Context<SysWrapperT> &aContext, const FlagsT &flags) noexcept;
-    Socket(Context<SysWrapperT> &aContext, const FlagsT &aFlags,
-           uint16_t aPort);
+    return isConnected_;
+}
+
+template <typename SysWrapperT>
+std::size_t SocketBase<SysWrapperT>::send(CBuffer aBuf)
+{
+    std::error_code ec;
+    const auto bytesSent = SocketBase::send(aBuf, ec);
+    throw_if_error(ec);
+    return bytesSent;
+}
+
+template <typename SysWrapperT>
+std::size_t SocketBase<SysWrapperT>::send(CBuffer aBuf, std::error_code &aEc)
+{
+    assert(isConnected_ && "Error: socket must be connected");
+    const auto bytesSent =
+        SysWrapperT::send(socketHandle_, aBuf.data(), aBuf.size(), 0);
+    if (ndt::kSocketError == bytesSent)
+    {
+        aEc.assign(SysWrapperT::lastErrorCode(), std::system_category());
+        return 0;
+    }
+    return static_cast<std::size_t>(bytesSent);
+}
+
+template <typename SysWrapperT>
+std::size_t SocketBase<SysWrapperT>::recv(Buffer &aBuf)
+{
+    std::error_code ec;
+    const auto bytesReceived = SocketBase::recv(aBuf, ec);
+    throw_if_error(ec);
+    return bytesReceived;
+}
+
+template <typename SysWrapperT>
+std::size_t SocketBase<SysWrapperT>::recv(Buffer &aBuf, std::error_code &aEc)
+{
+    const auto bytesReceived =
+        SysWrapperT::recv(socketHandle_, aBuf.data(), aBuf.size(), 0);
+    if (ndt::kSocketError == bytesReceived)
+    {
+        aEc.assign(SysWrapperT::lastErrorCode(), std::system_category());
+        return 0;
+    }
+    aBuf.setSize(static_cast<std::size_t>(bytesReceived));
+    return static_cast<std::size_t>(bytesReceived);
+}
+
+template <typename SysWrapperT>
+std::size_t SocketBase<SysWrapperT>::sendBatch(const CBuffer *aBufs,
+                                               const std::size_t aCount)
+{
+    std::error_code ec;
+    const auto count = SocketBase::sendBatch(aBufs, aCount, ec);
+    throw_if_error(ec);
+    return count;
+}
+
+template <typename SysWrapperT>
+std::size_t SocketBase<SysWrapperT>::sendBatch(const CBuffer *aBufs,
+                                               const std::size_t aCount,
+                                               std::error_code &aEc)
+{
+    assert(isConnected_ && "Error: socket must be connected");
+    return SocketBase::sendBatch(nullptr, aBufs, aCount, aEc);
+}
+
+template <typename SysWrapperT>
+std::size_t SocketBase<SysWrapperT>::recvBatch(Buffer *aBufs,
+                                               const std::size_t aCount)
+{
+    std::error_code ec;
+    const auto count = SocketBase::recvBatch(aBufs, aCount, ec);
+    throw_if_error(ec);
+    return count;
+}
+
+template <typename SysWrapperT>
+std::size_t SocketBase<SysWrapperT>::recvBatch(Buffer *aBufs,
+                                               const std::size_t aCount,
+                                               std::error_code &aEc)
+{
+    return SocketBase::recvBatch(aBufs, nullptr, nullptr, aCount, aEc);
+}
+
+template <typename SysWrapperT>
+std::size_t SocketBase<SysWrapperT>::sendSegmented(
+    const Address &aDst, CBuffer aBuf, const std::size_t aSegmentSize)
+{
+    std::error_code ec;
+    const auto bytesSent =
+        SocketBase::sendSegmented(aDst, aBuf, aSegmentSize, ec);
+    throw_if_error(ec);
+    return bytesSent;
+}
+
+template <typename SysWrapperT>
+std::size_t SocketBase<SysWrapperT>::sendSegmented(
+    const Address &aDst, CBuffer aBuf, const std::size_t aSegmentSize,
+    std::error_code &aEc)
+{
+    assert(aSegmentSize > 0 && "Error: segment size must be positive");
+    const std::size_t size = aBuf.size<std::size_t>();
+    if (size == 0)
+    {
+        // empty datagram
+        SocketBase::sendTo(aDst, aBuf, aEc);
+        return 0;
+    }
+    std::size_t sent = 0;
+    if ((size > aSegmentSize) && (aSegmentSize <= kMaxGsoBytes) &&
+        isGsoSupported())
+    {
+        const std::size_t chunkSize =
+            std::min(kMaxGsoSegments, kMaxGsoBytes / aSegmentSize) *
+            aSegmentSize;
+        while (sent < size)
+        {
+            const CBuffer chunk(aBuf[sent], std::min(size - sent, chunkSize));
+            std::error_code ec;
+            sendGso(aDst, chunk, aSegmentSize, ec);
+            if (ec == std::errc::io_error)
+            {
+                // device can't checksum segments, kernel refuses GSO
+                gsoSupport_ = eSupport::kUnsupported;
+                break;
+            }
+            if (ec)
+            {
+                aEc = ec;
+                return sent;
+            }
+            sent += chunk.size<std::size_t>();
+        }
+    }
+    const Segments segments(CBuffer(aBuf[sent], size - sent), aSegmentSize);
+    for (std::size_t i = 0; i < segments.count(); ++i)
+    {
+        const CBuffer segment = segments[i];
+        std::error_code ec;
+        SocketBase::sendTo(aDst, segment, ec);
+        if (ec)
+        {
+            aEc = ec;
+            break;
+        }
+        sent += segment.size<std::size_t>();
+    }
+    return sent;
+}
+
+template <typename SysWrapperT>
+Segments SocketBase<SysWrapperT>::recvSegmented(Buffer &aBuf,
+                                                Address &aSender)
+{
+    std::error_code ec;
+    const auto segments = SocketBase::recvSegmented(aBuf, aSender, ec);
+    throw_if_error(ec);
+    return segments;
+}
+
+template <typename SysWrapperT>
+Segments SocketBase<SysWrapperT>::recvSegmented(Buffer &aBuf,
+                                                Address &aSender,
+                                                std::error_code &aEc)
+{
+#if defined(UDP_GRO)
+    if (isGro_)
+    {
+        iovec iov;
+        iov.iov_base = aBuf.data();
+        iov.iov_len = aBuf.size<std::size_t>();
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+        msghdr msg = {};
+        msg.msg_name = aSender.nativeData();
+        msg.msg_namelen = static_cast<socklen_t>(kMaxAddressCapacity);
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        const auto bytesReceived = SysWrapperT::recvmsg(socketHandle_, &msg, 0);
+        if (ndt::kSocketError == bytesReceived)
+        {
+            aEc.assign(SysWrapperT::lastErrorCode(), std::system_category());
+            return Segments(CBuffer(aBuf.data(), 0), 0);
+        }
+        aBuf.setSize(static_cast<std::size_t>(bytesReceived));
+        aSender.nativeLength(msg.msg_namelen);
+        // datagram which wasn't coalesced comes without segment size
+        std::size_t segmentSize = aBuf.size<std::size_t>();
+        for (cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg;
+             cmsg = CMSG_NXTHDR(&msg, cmsg))
+        {
+            if ((cmsg->cmsg_level == IPPROTO_UDP) &&
+                (cmsg->cmsg_type == UDP_GRO))
+            {
+                int value = 0;
+                std::memcpy(&value, CMSG_DATA(cmsg), sizeof(value));
+                segmentSize = static_cast<std::size_t>(value);
+            }
+        }
+        return Segments(CBuffer(aBuf), segmentSize);
+    }
+#endif
+    const auto bytesReceived = SocketBase::recvFrom(aBuf, aSender, aEc);
+    if (aEc)
+    {
+        return Segments(CBuffer(aBuf.data(), 0), 0);
+    }
+    return Segments(CBuffer(aBuf), bytesReceived);
+}
+
+template <typename SysWrapperT>
+bool SocketBase<SysWrapperT>::gro() const noexcept
+{
+    return isGro_;
+}
+
+template <typename SysWrapperT>
+void SocketBase<SysWrapperT>::gro(const bool aIsOn)
+{
+    std::error_code ec;
+    SocketBase::gro(aIsOn, ec);
+    throw_if_error(ec);
+}
+
+template <typename SysWrapperT>
+void SocketBase<SysWrapperT>::gro(const bool aIsOn,
+                                  std::error_code &aEc) noexcept
+{
+#if defined(UDP_GRO)
+    std::error_code ec;
+    SocketBase::set<opt::UdpGro>(aIsOn, ec);
+    if (ec && (ec.value() != ENOPROTOOPT))
+    {
+        aEc = ec;
+        return;
+    }
+    // kernel older than 5.0 receives datagrams one by one
+    isGro_ = !ec && aIsOn;
+#else
+    (void)aIsOn;
+    (void)aEc;
+#endif
+}
+
+template <typename SysWrapperT>
+bool SocketBase<SysWrapperT>::zeroCopy() const noexcept
+{
+    return zeroCopy_.isOn_;
+}
+
+template <typename SysWrapperT>
+void SocketBase<SysWrapperT>::zeroCopy(const bool aIsOn)
+{
+    std::error_code ec;
+    SocketBase::zeroCopy(aIsOn, ec);
+    throw_if_error(ec);
+}
+
+template <typename SysWrapperT>
+void SocketBase<SysWrapperT>::zeroCopy(const bool aIsOn,
+                                       std::error_code &aEc) noexcept
+{
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+    std::error_code ec;
+    SocketBase::set<opt::ZeroCopy>(aIsOn, ec);
+    if (ec && (ec.value() != ENOPROTOOPT) && (ec.value() != EOPNOTSUPP))
+    {
+        aEc = ec;
+        return;
+    }
+    // kernel older than 5.0 copies datagrams
+    zeroCopy_.isOn_ = !ec && aIsOn;
+#else
+    (void)aIsOn;
+    (void)aEc;
+#endif
+}
+
+template <typename SysWrapperT>
+std::size_t SocketBase<SysWrapperT>::zeroCopyThreshold() const noexcept
+{
+    return zeroCopy_.threshold_;
+}
+
+template <typename SysWrapperT>
+void SocketBase<SysWrapperT>::zeroCopyThreshold(
+    const std::size_t aSize) noexcept
+{
+    zeroCopy_.threshold_ = aSize;
+}
+
+template <typename SysWrapperT>
+bool SocketBase<SysWrapperT>::sendToZeroCopy(const Address &aDst,
+                                             CBuffer aBuf)
+{
+    std::error_code ec;
+    const bool isPending = SocketBase::sendToZeroCopy(aDst, aBuf, ec);
+    throw_if_error(ec);
+    return isPending;
+}
+
+template <typename SysWrapperT>
+bool SocketBase<SysWrapperT>::sendToZeroCopy(const Address &aDst,
+                                             CBuffer aBuf,
+                                             std::error_code &aEc)
+{
+#if defined(MSG_ZEROCOPY)
+    if (zeroCopy_.isOn_ && (aBuf.size<std::size_t>() >= zeroCopy_.threshold_))
+    {
+        const auto bytesSent = SysWrapperT::sendto(
+            socketHandle_, aBuf.data(), aBuf.size(), MSG_ZEROCOPY,
+            aDst.nativeDataConst(), static_cast<ndt::salen_t>(aDst.capacity()));
+        if (ndt::kSocketError != bytesSent)
+        {
+            zeroCopy_.sends_.push_back({aBuf, true});
+            ++zeroCopy_.pendingCount_;
+            return true;
+        }
+        const auto errorCode = SysWrapperT::lastErrorCode();
+        if (errorCode != ENOBUFS)
+        {
+            aEc.assign(errorCode, std::system_category());
+            return false;
+        }
+        // limit of pinned memory (optmem_max) is reached, aBuf is copied
+    }
+#endif
+    SocketBase::sendTo(aDst, aBuf, aEc);
+    return false;
+}
+
+template <typename SysWrapperT>
+template <typename CallbackT>
+std::size_t SocketBase<SysWrapperT>::readZeroCopyCompletions(
+    CallbackT &&aCallback)
+{
+    std::error_code ec;
+    const auto releasedCount = SocketBase::readZeroCopyCompletions(
+        std::forward<CallbackT>(aCallback), ec);
+    throw_if_error(ec);
+    return releasedCount;
+}
+
+template <typename SysWrapperT>
+template <typename CallbackT>
+std::size_t SocketBase<SysWrapperT>::readZeroCopyCompletions(
+    CallbackT &&aCallback, std::error_code &aEc)
+{
+    std::size_t releasedCount = 0;
+#if defined(MSG_ZEROCOPY) && defined(SO_EE_ORIGIN_ZEROCOPY)
+    // completion may be followed by address of the offender
+    constexpr std::size_t kControlSize =
+        CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6));
+    while (zeroCopy_.pendingCount_ > 0)
+    {
+        alignas(cmsghdr) char control[kControlSize] = {};
+        msghdr msg = {};
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        if (SysWrapperT::recvmsg(socketHandle_, &msg, MSG_ERRQUEUE) ==
+            kSocketError)
+        {
+            // reading of error queue never blocks, EAGAIN means it is empty
+            const auto errorCode = SysWrapperT::lastErrorCode();
+            if ((errorCode != EAGAIN) && (errorCode != EWOULDBLOCK))
+            {
+                aEc.assign(errorCode, std::system_category());
+            }
+            break;
+        }
+        for (cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg;
+             cmsg = CMSG_NXTHDR(&msg, cmsg))
+        {
+            const bool isRecvErr =
+                ((cmsg->cmsg_level == IPPROTO_IP) &&
+                 (cmsg->cmsg_type == IP_RECVERR)) ||
+                ((cmsg->cmsg_level == IPPROTO_IPV6) &&
+                 (cmsg->cmsg_type == IPV6_RECVERR));
+            if (!isRecvErr)
+            {
+                continue;
+            }
+            sock_extended_err err;
+            std::memcpy(&err, CMSG_DATA(cmsg), sizeof(err));
+            if (err.ee_origin != SO_EE_ORIGIN_ZEROCOPY)
+            {
+                continue;
+            }
+            // inclusive range of numbers of completed sends, kernel may
+            // report them out of order
+            for (uint32_t number = err.ee_info;; ++number)
+            {
+                const std::size_t i = number - zeroCopy_.base_;
+                if ((i < zeroCopy_.sends_.size()) &&
+                    zeroCopy_.sends_[i].isPending_)
+                {
+                    zeroCopy_.sends_[i].isPending_ = false;
+                    --zeroCopy_.pendingCount_;
+                    ++releasedCount;
+                    aCallback(zeroCopy_.sends_[i].buf_);
+                }
+                if (number == err.ee_data)
+                {
+                    break;
+                }
+            }
+        }
+        while (!zeroCopy_.sends_.empty() &&
+               !zeroCopy_.sends_.front().isPending_)
+        {
+            zeroCopy_.sends_.pop_front();
+            ++zeroCopy_.base_;
+        }
+    }
+#else
+    (void)aCallback;
+    (void)aEc;
+#endif
+    return releasedCount;
+}
+
+template <typename SysWrapperT>
+std::size_t SocketBase<SysWrapperT>::zeroCopyPendingCount() const noexcept
+{
+    return zeroCopy_.pendingCount_;
+}
+
+template <typename SysWrapperT>
+std::size_t SocketBase<SysWrapperT>::zeroCopyTrackedCount() const noexcept
+{
+    return zeroCopy_.sends_.size();
+}
+
+#if defined(SCM_TIMESTAMPNS)
+template <typename SysWrapperT>
+RecvTimeT SocketBase<SysWrapperT>::recvTime(msghdr &aMsg) noexcept
+{
+    for (cmsghdr *cmsg = CMSG_FIRSTHDR(&aMsg); cmsg;
+         cmsg = CMSG_NXTHDR(&aMsg, cmsg))
+    {
+        if ((cmsg->cmsg_level == SOL_SOCKET) &&
+            (cmsg->cmsg_type == SCM_TIMESTAMPNS))
+        {
+            timespec time;
+            std::memcpy(&time, CMSG_DATA(cmsg), sizeof(time));
+            return RecvTimeT(std::chrono::seconds(time.tv_sec) +
+                             std::chrono::nanoseconds(time.tv_nsec));
+        }
+    }
+    return RecvTimeT{};
+}
+#endif
+
+template <typename SysWrapperT>
+bool SocketBase<SysWrapperT>::isGsoSupported() noexcept
+{
+#if defined(UDP_SEGMENT)
+    if (gsoSupport_ == eSupport::kUnknown)
+    {
+        // kernels without GSO (before 4.18) don't know the option
+        std::error_code ec;
+        SocketBase::get<opt::UdpSegment>(ec);
+        gsoSupport_ = ec ? eSupport::kUnsupported : eSupport::kSupported;
+    }
+    return gsoSupport_ == eSupport::kSupported;
+#else
+    return false;
+#endif
+}
+
+template <typename SysWrapperT>
+void SocketBase<SysWrapperT>::sendGso(const Address &aDst, CBuffer aBuf,
+                                      const std::size_t aSegmentSize,
+                                      std::error_code &aEc)
+{
+#if defined(UDP_SEGMENT)
+    iovec iov;
+    // sendmsg doesn't modify data
+    iov.iov_base = const_cast<buf_t *>(aBuf.data());
+    iov.iov_len = aBuf.size<std::size_t>();
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(uint16_t))] = {};
+    msghdr msg = {};
+    msg.msg_name = const_cast<sockaddr *>(aDst.nativeDataConst());
+    msg.msg_namelen = static_cast<socklen_t>(aDst.capacity());
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = IPPROTO_UDP;
+    cmsg->cmsg_type = UDP_SEGMENT;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+    const auto segmentSize = static_cast<uint16_t>(aSegmentSize);
+    std::memcpy(CMSG_DATA(cmsg), &segmentSize, sizeof(segmentSize));
+    if (SysWrapperT::sendmsg(socketHandle_, &msg, 0) == kSocketError)
+    {
+        aEc.assign(SysWrapperT::lastErrorCode(), std::system_category());
+    }
+#else
+    (void)aDst;
+    (void)aBuf;
+    (void)aSegmentSize;
+    aEc = std::make_error_code(std::errc::operation_not_supported);
+#endif
+}
+
+template <typename SysWrapperT>
+void SocketBase<SysWrapperT>::close()
+{
+    std::error_code ec;
+    SocketBase::close(ec);
+    throw_if_error(ec);
+}
+
+template <typename SysWrapperT>
+void SocketBase<SysWrapperT>::close(std::error_code &aEc)
+{
+    if (!isOpen_)
+    {
+        return;
+    }
+    setIsSubscribed(false);
+    const auto result = SysWrapperT::close(socketHandle_);
+    if (ndt::kSocketError == result)
+    {
+        aEc.assign(SysWrapperT::lastErrorCode(), std::system_category());
+        return;
+    }
+    socketHandle_ = kInvalidSocket;
+    isOpen_ = false;
+    isGro_ = false;
+    isConnected_ = false;
+    gsoSupport_ = eSupport::kUnknown;
+    const std::size_t zeroCopyThreshold = zeroCopy_.threshold_;
+    zeroCopy_ = {};
+    zeroCopy_.threshold_ = zeroCopyThreshold;
+}
+
+template <typename SysWrapperT>
+void SocketBase<SysWrapperT>::nonBlocking(const bool isNonBlocking)
+{
+    std::error_code ec;
+    SocketBase::nonBlocking(isNonBlocking, ec);
+    throw_if_error(ec);
+}
+
+template <typename SysWrapperT>
+void SocketBase<SysWrapperT>::nonBlocking(const bool isNonBlocking,
+                                          std::error_code &aEc) noexcept
+{
+#if _WIN32
+    u_long isNonBlockingArg = isNonBlocking ? 1 : 0;
+    const int flags =
+        SysWrapperT::ioctlsocket(socketHandle_, FIONBIO, &isNonBlockingArg);
+#else
+    int flags = SysWrapperT::fcntl(socketHandle_, F_GETFL, 0);
+    if (flags == kSocketError)
+    {
+        aEc.assign(SysWrapperT::lastErrorCode(), std::system_category());
+        return;
+    }
+
+    flags = isNonBlocking ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK);
+    flags = SysWrapperT::fcntl(socketHandle_, F_SETFL, flags);
+#endif
+    if (flags == kSocketError)
+    {
+        aEc.assign(SysWrapperT::lastErrorCode(), std::system_category());
+        return;
+    }
+    isNonBlocking_ = isNonBlocking;
+}
+
+template <typename SysWrapperT>
+template <typename OptionT>
+void SocketBase<SysWrapperT>::set(const typename OptionT::ValueType aValue)
+{
+    std::error_code ec;
+    SocketBase::set<OptionT>(aValue, ec);
+    throw_if_error(ec);
+}
+
+template <typename SysWrapperT>
+template <typename OptionT>
+void SocketBase<SysWrapperT>::set(const typename OptionT::ValueType aValue,
+                                  std::error_code &aEc) noexcept
+{
+    static_assert(opt::IsOption<OptionT>::value,
+                  "Error: OptionT must be one of ndt::opt options");
+    const typename OptionT::NativeType value = OptionT::toNative(aValue);
+    if (SysWrapperT::setsockopt(socketHandle_, OptionT::kLevel,
+                                OptionT::kName, &value,
+                                sizeof(value)) == kSocketError)
+    {
+        aEc.assign(SysWrapperT::lastErrorCode(), std::system_category());
+    }
+}
+
+template <typename SysWrapperT>
+template <typename OptionT>
+typename OptionT::ValueType SocketBase<SysWrapperT>::get() const
+{
+    std::error_code ec;
+    const auto value = SocketBase::get<OptionT>(ec);
+    throw_if_error(ec);
+    return value;
+}
+
+template <typename SysWrapperT>
+template <typename OptionT>
+typename OptionT::ValueType SocketBase<SysWrapperT>::get(
+    std::error_code &aEc) const noexcept
+{
+    static_assert(opt::IsOption<OptionT>::value,
+                  "Error: OptionT must be one of ndt::opt options");
+    typename OptionT::NativeType value{};
+    salen_t size = sizeof(value);
+    if (SysWrapperT::getsockopt(socketHandle_, OptionT::kLevel,
+                                OptionT::kName, &value,
+                                &size) == kSocketError)
+    {
+        aEc.assign(SysWrapperT::lastErrorCode(), std::system_category());
+        return {};
+    }
+    return OptionT::fromNative(value);
+}
+
+// Lets several sockets bind the same port, kernel spreads incoming flows
+// between them. Must be called before bind.
+template <typename SysWrapperT>
+void SocketBase<SysWrapperT>::reusePort(const bool aIsReusePort)
+{
+    std::error_code ec;
+    SocketBase::reusePort(aIsReusePort, ec);
+    throw_if_error(ec);
+}
+
+template <typename SysWrapperT>
+void SocketBase<SysWrapperT>::reusePort(const bool aIsReusePort,
+                                        std::error_code &aEc) noexcept
+{
+#if defined(SO_REUSEPORT)
+    SocketBase::set<opt::ReusePort>(aIsReusePort, aEc);
+#else
+    (void)aIsReusePort;
+    aEc = std::make_error_code(std::errc::operation_not_supported);
+#endif
+}
+
+template <typename SysWrapperT>
+void SocketBase<SysWrapperT>::busyPoll(
+    const std::chrono::microseconds aDuration)
+{
+    std::error_code ec;
+    SocketBase::busyPoll(aDuration, ec);
+    throw_if_error(ec);
+}
+
+template <typename SysWrapperT>
+void SocketBase<SysWrapperT>::busyPoll(
+    const std::chrono::microseconds aDuration, std::error_code &aEc) noexcept
+{
+#if defined(SO_BUSY_POLL)
+    SocketBase::set<opt::BusyPoll>(aDuration, aEc);
+#else
+    (void)aDuration;
+    aEc = std::make_error_code(std::errc::operation_not_supported);
+#endif
+}
+
+template <typename FlagsT, typename SysWrapperT>
+class Socket final : public SocketBase<SysWrapperT>
+{
+    friend class ExecutorSelect<SysWrapperT>;
+
+   public:
+    typedef FlagsT SocketT;
+    typedef SysWrapperT SysCallsT;
+    ~Socket();
+    Socket() = delete;
+    Socket(Socket &&) noexcept;
+    Socket &operator=(Socket &&) noexcept;
+    Socket(Context<SysWrapperT> &aContext, const FlagsT &flags) noexcept;
+    Socket(Context<SysWrapperT> &aContext, const FlagsT &aFlags,
+           uint16_t aPort);
+    Socket(Context<SysWrapperT> &aContext, const FlagsT &aFlags,
+           const Address &aLocal);
 
     void open();
     void open(std::error_code &aEc);
     void bind(const uint16_t aPort);
     void bind(const uint16_t aPort, std::error_code &aEc);
+    void bind(const Address &aLocal);
+    void bind(const Address &aLocal, std::error_code &aEc);
     std::size_t sendTo(const Address &aDst, CBuffer aBuf);
     std::size_t sendTo(const Address &aDst, CBuffer aBuf, std::error_code &aEc);
+    void postSendTo(const Address &aDst, CBuffer aBuf);
+    void postSendTo(const Address &aDst, CBuffer aBuf, std::error_code &aEc);
     std::size_t recvFrom(Buffer &aBuf, Address &aSender);
     std::size_t recvFrom(Buffer &aBuf, Address &aSender, std::error_code &aEc);
+    std::size_t recvFrom(Buffer &aBuf, Address &aSender, RecvTimeT &aTime);
+    std::size_t recvFrom(Buffer &aBuf, Address &aSender, RecvTimeT &aTime,
+                         std::error_code &aEc);
+    std::size_t recvBatch(Buffer *aBufs, Address *aSenders,
+                          const std::size_t aCount);
+    std::size_t recvBatch(Buffer *aBufs, Address *aSenders,
+                          const std::size_t aCount, std::error_code &aEc);
+    std::size_t recvBatch(Buffer *aBufs, Address *aSenders, RecvTimeT *aTimes,
+                          const std::size_t aCount);
+    std::size_t recvBatch(Buffer *aBufs, Address *aSenders, RecvTimeT *aTimes,
+                          const std::size_t aCount, std::error_code &aEc);
+    std::size_t sendBatch(const Address *aDsts, const CBuffer *aBufs,
+                          const std::size_t aCount);
+    std::size_t sendBatch(const Address *aDsts, const CBuffer *aBufs,
+                          const std::size_t aCount, std::error_code &aEc);
+    void connect(const Address &aPeer);
+    void connect(const Address &aPeer, std::error_code &aEc);
+    void disconnect();
+    void disconnect(std::error_code &aEc);
+    bool isConnected() const noexcept;
+    std::size_t send(CBuffer aBuf);
+    std::size_t send(CBuffer aBuf, std::error_code &aEc);
+    std::size_t recv(Buffer &aBuf);
+    std::size_t recv(Buffer &aBuf, std::error_code &aEc);
+    std::size_t sendBatch(const CBuffer *aBufs, const std::size_t aCount);
+    std::size_t sendBatch(const CBuffer *aBufs, const std::size_t aCount,
+                          std::error_code &aEc);
+    std::size_t recvBatch(Buffer *aBufs, const std::size_t aCount);
+    std::size_t recvBatch(Buffer *aBufs, const std::size_t aCount,
+                          std::error_code &aEc);
+    std::size_t sendSegmented(const Address &aDst, CBuffer aBuf,
+                              const std::size_t aSegmentSize);
+    std::size_t sendSegmented(const Address &aDst, CBuffer aBuf,
+                              const std::size_t aSegmentSize,
+                              std::error_code &aEc);
+    Segments recvSegmented(Buffer &aBuf, Address &aSender);
+    Segments recvSegmented(Buffer &aBuf, Address &aSender,
+                           std::error_code &aEc);
+    bool gro() const noexcept;
+    void gro(const bool aIsOn);
+    void gro(const bool aIsOn, std::error_code &aEc) noexcept;
+    bool zeroCopy() const noexcept;
+    void zeroCopy(const bool aIsOn);
+    void zeroCopy(const bool aIsOn, std::error_code &aEc) noexcept;
+    std::size_t zeroCopyThreshold() const noexcept;
+    void zeroCopyThreshold(const std::size_t aSize) noexcept;
+    bool sendToZeroCopy(const Address &aDst, CBuffer aBuf);
+    bool sendToZeroCopy(const Address &aDst, CBuffer aBuf,
+                        std::error_code &aEc);
+    template <typename CallbackT>
+    std::size_t readZeroCopyCompletions(CallbackT &&aCallback);
+    template <typename CallbackT>
+    std::size_t readZeroCopyCompletions(CallbackT &&aCallback,
+                                        std::error_code &aEc);
+    std::size_t zeroCopyPendingCount() const noexcept;
+    std::size_t zeroCopyTrackedCount() const noexcept;
     void close();
     void close(std::error_code &aEc);
     bool nonBlocking() const noexcept;
     void nonBlocking(const bool isNonBlocking);
     void nonBlocking(const bool isNonBlocking, std::error_code &aEc) noexcept;
+    template <typename OptionT>
+    void set(const typename OptionT::ValueType aValue);
+    template <typename OptionT>
+    void set(const typename OptionT::ValueType aValue,
+             std::error_code &aEc) noexcept;
+    template <typename OptionT>
+    typename OptionT::ValueType get() const;
+    template <typename OptionT>
+    typename OptionT::ValueType get(std::error_code &aEc) const noexcept;
+    void reusePort(const bool aIsReusePort);
+    void reusePort(const bool aIsReusePort, std::error_code &aEc) noexcept;
+    void busyPoll(const std::chrono::microseconds aDuration);
+    void busyPoll(const std::chrono::microseconds aDuration,
+                  std::error_code &aEc) noexcept;
+#if defined(NDT_COROUTINES)
+    // co_await-able counterparts of recvFrom and sendTo for non-blocking
+    // socket, defined in coroutine.h
+    RecvFromAwaiter<Socket> asyncRecvFrom(Buffer &aBuf, Address &aSender);
+    RecvFromAwaiter<Socket> asyncRecvFrom(Buffer &aBuf, Address &aSender,
+                                          std::error_code &aEc);
+    SendToAwaiter<Socket> asyncSendTo(const Address &aDst, CBuffer aBuf);
+    SendToAwaiter<Socket> asyncSendTo(const Address &aDst, CBuffer aBuf,
+                                      std::error_code &aEc);
+#endif
 
     FlagsT flags() const noexcept;
 
@@ -398,6 +1843,24 @@ Socket<FlagsT, SysWrapperT>::Socket(Context<SysWrapperT> &aContext,
     }
 }
 
+template <typename FlagsT, typename SysWrapperT>
+Socket<FlagsT, SysWrapperT>::Socket(Context<SysWrapperT> &aContext,
+                                    const FlagsT &aFlags,
+                                    const Address &aLocal)
+    : Socket(aContext, aFlags)
+{
+    open();
+    try
+    {
+        bind(aLocal);
+    }
+    catch (const std::exception &e)
+    {
+        close();
+        throw;
+    }
+}
+
 template <typename FlagsT, typename SysWrapperT>
 void Socket<FlagsT, SysWrapperT>::open()
 {
@@ -411,6 +1874,18 @@ void Socket<FlagsT, SysWrapperT>::open(std::error_code &aEc)
 {
     SocketBase<SysWrapperT>::open(flags_.sysFamily(), flags_.sysSocketType(),
                                   flags_.sysProtocol(), aEc);
+    if constexpr (IsDualStackFlags<FlagsT>::value)
+    {
+        if (!aEc && flags_.isDualStack())
+        {
+            SocketBase<SysWrapperT>::template set<opt::V6Only>(false, aEc);
+            if (aEc)
+            {
+                std::error_code closeEc;
+                SocketBase<SysWrapperT>::close(closeEc);
+            }
+        }
+    }
 }
 
 template <typename FlagsT, typename SysWrapperT>
@@ -428,6 +1903,21 @@ void Socket<FlagsT, SysWrapperT>::bind(const uint16_t aPort,
     SocketBase<SysWrapperT>::bind(flags_.sysFamily(), aPort, aEc);
 }
 
+template <typename FlagsT, typename SysWrapperT>
+void Socket<FlagsT, SysWrapperT>::bind(const Address &aLocal)
+{
+    std::error_code ec;
+    Socket<FlagsT, SysWrapperT>::bind(aLocal, ec);
+    throw_if_error(ec);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+void Socket<FlagsT, SysWrapperT>::bind(const Address &aLocal,
+                                       std::error_code &aEc)
+{
+    SocketBase<SysWrapperT>::bind(aLocal, aEc);
+}
+
 template <typename FlagsT, typename SysWrapperT>
 std::size_t Socket<FlagsT, SysWrapperT>::sendTo(const Address &aDst,
                                                 CBuffer aBuf)
@@ -443,6 +1933,19 @@ std::size_t Socket<FlagsT, SysWrapperT>::sendTo(const Address &aDst,
     return SocketBase<SysWrapperT>::sendTo(aDst, aBuf, aEc);
 }
 
+template <typename FlagsT, typename SysWrapperT>
+void Socket<FlagsT, SysWrapperT>::postSendTo(const Address &aDst, CBuffer aBuf)
+{
+    SocketBase<SysWrapperT>::postSendTo(aDst, aBuf);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+void Socket<FlagsT, SysWrapperT>::postSendTo(const Address &aDst, CBuffer aBuf,
+                                             std::error_code &aEc)
+{
+    SocketBase<SysWrapperT>::postSendTo(aDst, aBuf, aEc);
+}
+
 template <typename FlagsT, typename SysWrapperT>
 std::size_t Socket<FlagsT, SysWrapperT>::recvFrom(Buffer &aBuf,
                                                   Address &aSender)
@@ -458,6 +1961,294 @@ std::size_t Socket<FlagsT, SysWrapperT>::recvFrom(Buffer &aBuf,
     return SocketBase<SysWrapperT>::recvFrom(aBuf, aSender, aEc);
 }
 
+template <typename FlagsT, typename SysWrapperT>
+std::size_t Socket<FlagsT, SysWrapperT>::recvFrom(Buffer &aBuf,
+                                                  Address &aSender,
+                                                  RecvTimeT &aTime)
+{
+    return SocketBase<SysWrapperT>::recvFrom(aBuf, aSender, aTime);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+std::size_t Socket<FlagsT, SysWrapperT>::recvFrom(Buffer &aBuf,
+                                                  Address &aSender,
+                                                  RecvTimeT &aTime,
+                                                  std::error_code &aEc)
+{
+    return SocketBase<SysWrapperT>::recvFrom(aBuf, aSender, aTime, aEc);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+std::size_t Socket<FlagsT, SysWrapperT>::recvBatch(Buffer *aBufs,
+                                                   Address *aSenders,
+                                                   RecvTimeT *aTimes,
+                                                   const std::size_t aCount)
+{
+    return SocketBase<SysWrapperT>::recvBatch(aBufs, aSenders, aTimes,
+                                              aCount);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+std::size_t Socket<FlagsT, SysWrapperT>::recvBatch(Buffer *aBufs,
+                                                   Address *aSenders,
+                                                   RecvTimeT *aTimes,
+                                                   const std::size_t aCount,
+                                                   std::error_code &aEc)
+{
+    return SocketBase<SysWrapperT>::recvBatch(aBufs, aSenders, aTimes, aCount,
+                                              aEc);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+std::size_t Socket<FlagsT, SysWrapperT>::recvBatch(Buffer *aBufs,
+                                                   Address *aSenders,
+                                                   const std::size_t aCount)
+{
+    return SocketBase<SysWrapperT>::recvBatch(aBufs, aSenders, aCount);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+std::size_t Socket<FlagsT, SysWrapperT>::recvBatch(Buffer *aBufs,
+                                                   Address *aSenders,
+                                                   const std::size_t aCount,
+                                                   std::error_code &aEc)
+{
+    return SocketBase<SysWrapperT>::recvBatch(aBufs, aSenders, aCount, aEc);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+std::size_t Socket<FlagsT, SysWrapperT>::sendBatch(const Address *aDsts,
+                                                   const CBuffer *aBufs,
+                                                   const std::size_t aCount)
+{
+    return SocketBase<SysWrapperT>::sendBatch(aDsts, aBufs, aCount);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+std::size_t Socket<FlagsT, SysWrapperT>::sendBatch(const Address *aDsts,
+                                                   const CBuffer *aBufs,
+                                                   const std::size_t aCount,
+                                                   std::error_code &aEc)
+{
+    return SocketBase<SysWrapperT>::sendBatch(aDsts, aBufs, aCount, aEc);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+void Socket<FlagsT, SysWrapperT>::connect(const Address &aPeer)
+{
+    SocketBase<SysWrapperT>::connect(aPeer);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+void Socket<FlagsT, SysWrapperT>::connect(const Address &aPeer,
+                                          std::error_code &aEc)
+{
+    SocketBase<SysWrapperT>::connect(aPeer, aEc);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+void Socket<FlagsT, SysWrapperT>::disconnect()
+{
+    SocketBase<SysWrapperT>::disconnect();
+}
+
+template <typename FlagsT, typename SysWrapperT>
+void Socket<FlagsT, SysWrapperT>::disconnect(std::error_code &aEc)
+{
+    SocketBase<SysWrapperT>::disconnect(aEc);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+bool Socket<FlagsT, SysWrapperT>::isConnected() const noexcept
+{
+    return SocketBase<SysWrapperT>::isConnected();
+}
+
+template <typename FlagsT, typename SysWrapperT>
+std::size_t Socket<FlagsT, SysWrapperT>::send(CBuffer aBuf)
+{
+    return SocketBase<SysWrapperT>::send(aBuf);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+std::size_t Socket<FlagsT, SysWrapperT>::send(CBuffer aBuf,
+                                              std::error_code &aEc)
+{
+    return SocketBase<SysWrapperT>::send(aBuf, aEc);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+std::size_t Socket<FlagsT, SysWrapperT>::recv(Buffer &aBuf)
+{
+    return SocketBase<SysWrapperT>::recv(aBuf);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+std::size_t Socket<FlagsT, SysWrapperT>::recv(Buffer &aBuf,
+                                              std::error_code &aEc)
+{
+    return SocketBase<SysWrapperT>::recv(aBuf, aEc);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+std::size_t Socket<FlagsT, SysWrapperT>::sendBatch(const CBuffer *aBufs,
+                                                   const std::size_t aCount)
+{
+    return SocketBase<SysWrapperT>::sendBatch(aBufs, aCount);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+std::size_t Socket<FlagsT, SysWrapperT>::sendBatch(const CBuffer *aBufs,
+                                                   const std::size_t aCount,
+                                                   std::error_code &aEc)
+{
+    return SocketBase<SysWrapperT>::sendBatch(aBufs, aCount, aEc);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+std::size_t Socket<FlagsT, SysWrapperT>::recvBatch(Buffer *aBufs,
+                                                   const std::size_t aCount)
+{
+    return SocketBase<SysWrapperT>::recvBatch(aBufs, aCount);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+std::size_t Socket<FlagsT, SysWrapperT>::recvBatch(Buffer *aBufs,
+                                                   const std::size_t aCount,
+                                                   std::error_code &aEc)
+{
+    return SocketBase<SysWrapperT>::recvBatch(aBufs, aCount, aEc);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+std::size_t Socket<FlagsT, SysWrapperT>::sendSegmented(
+    const Address &aDst, CBuffer aBuf, const std::size_t aSegmentSize)
+{
+    return SocketBase<SysWrapperT>::sendSegmented(aDst, aBuf, aSegmentSize);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+std::size_t Socket<FlagsT, SysWrapperT>::sendSegmented(
+    const Address &aDst, CBuffer aBuf, const std::size_t aSegmentSize,
+    std::error_code &aEc)
+{
+    return SocketBase<SysWrapperT>::sendSegmented(aDst, aBuf, aSegmentSize,
+                                                  aEc);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+Segments Socket<FlagsT, SysWrapperT>::recvSegmented(Buffer &aBuf,
+                                                    Address &aSender)
+{
+    return SocketBase<SysWrapperT>::recvSegmented(aBuf, aSender);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+Segments Socket<FlagsT, SysWrapperT>::recvSegmented(Buffer &aBuf,
+                                                    Address &aSender,
+                                                    std::error_code &aEc)
+{
+    return SocketBase<SysWrapperT>::recvSegmented(aBuf, aSender, aEc);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+bool Socket<FlagsT, SysWrapperT>::gro() const noexcept
+{
+    return SocketBase<SysWrapperT>::gro();
+}
+
+template <typename FlagsT, typename SysWrapperT>
+void Socket<FlagsT, SysWrapperT>::gro(const bool aIsOn)
+{
+    SocketBase<SysWrapperT>::gro(aIsOn);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+void Socket<FlagsT, SysWrapperT>::gro(const bool aIsOn,
+                                      std::error_code &aEc) noexcept
+{
+    SocketBase<SysWrapperT>::gro(aIsOn, aEc);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+bool Socket<FlagsT, SysWrapperT>::zeroCopy() const noexcept
+{
+    return SocketBase<SysWrapperT>::zeroCopy();
+}
+
+template <typename FlagsT, typename SysWrapperT>
+void Socket<FlagsT, SysWrapperT>::zeroCopy(const bool aIsOn)
+{
+    SocketBase<SysWrapperT>::zeroCopy(aIsOn);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+void Socket<FlagsT, SysWrapperT>::zeroCopy(const bool aIsOn,
+                                           std::error_code &aEc) noexcept
+{
+    SocketBase<SysWrapperT>::zeroCopy(aIsOn, aEc);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+std::size_t Socket<FlagsT, SysWrapperT>::zeroCopyThreshold() const noexcept
+{
+    return SocketBase<SysWrapperT>::zeroCopyThreshold();
+}
+
+template <typename FlagsT, typename SysWrapperT>
+void Socket<FlagsT, SysWrapperT>::zeroCopyThreshold(
+    const std::size_t aSize) noexcept
+{
+    SocketBase<SysWrapperT>::zeroCopyThreshold(aSize);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+bool Socket<FlagsT, SysWrapperT>::sendToZeroCopy(const Address &aDst,
+                                                 CBuffer aBuf)
+{
+    return SocketBase<SysWrapperT>::sendToZeroCopy(aDst, aBuf);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+bool Socket<FlagsT, SysWrapperT>::sendToZeroCopy(const Address &aDst,
+                                                 CBuffer aBuf,
+                                                 std::error_code &aEc)
+{
+    return SocketBase<SysWrapperT>::sendToZeroCopy(aDst, aBuf, aEc);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+template <typename CallbackT>
+std::size_t Socket<FlagsT, SysWrapperT>::readZeroCopyCompletions(
+    CallbackT &&aCallback)
+{
+    return SocketBase<SysWrapperT>::readZeroCopyCompletions(
+        std::forward<CallbackT>(aCallback));
+}
+
+template <typename FlagsT, typename SysWrapperT>
+template <typename CallbackT>
+std::size_t Socket<FlagsT, SysWrapperT>::readZeroCopyCompletions(
+    CallbackT &&aCallback, std::error_code &aEc)
+{
+    return SocketBase<SysWrapperT>::readZeroCopyCompletions(
+        std::forward<CallbackT>(aCallback), aEc);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+std::size_t Socket<FlagsT, SysWrapperT>::zeroCopyPendingCount()
+    const noexcept
+{
+    return SocketBase<SysWrapperT>::zeroCopyPendingCount();
+}
+
+template <typename FlagsT, typename SysWrapperT>
+std::size_t Socket<FlagsT, SysWrapperT>::zeroCopyTrackedCount()
+    const noexcept
+{
+    return SocketBase<SysWrapperT>::zeroCopyTrackedCount();
+}
+
 template <typename FlagsT, typename SysWrapperT>
 void Socket<FlagsT, SysWrapperT>::close()
 {
@@ -489,6 +2280,63 @@ void Socket<FlagsT, SysWrapperT>::nonBlocking(const bool isNonBlocking,
     SocketBase<SysWrapperT>::nonBlocking(isNonBlocking, aEc);
 }
 
+template <typename FlagsT, typename SysWrapperT>
+template <typename OptionT>
+void Socket<FlagsT, SysWrapperT>::set(const typename OptionT::ValueType aValue)
+{
+    SocketBase<SysWrapperT>::template set<OptionT>(aValue);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+template <typename OptionT>
+void Socket<FlagsT, SysWrapperT>::set(const typename OptionT::ValueType aValue,
+                                      std::error_code &aEc) noexcept
+{
+    SocketBase<SysWrapperT>::template set<OptionT>(aValue, aEc);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+template <typename OptionT>
+typename OptionT::ValueType Socket<FlagsT, SysWrapperT>::get() const
+{
+    return SocketBase<SysWrapperT>::template get<OptionT>();
+}
+
+template <typename FlagsT, typename SysWrapperT>
+template <typename OptionT>
+typename OptionT::ValueType Socket<FlagsT, SysWrapperT>::get(
+    std::error_code &aEc) const noexcept
+{
+    return SocketBase<SysWrapperT>::template get<OptionT>(aEc);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+void Socket<FlagsT, SysWrapperT>::reusePort(const bool aIsReusePort)
+{
+    SocketBase<SysWrapperT>::reusePort(aIsReusePort);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+void Socket<FlagsT, SysWrapperT>::reusePort(const bool aIsReusePort,
+                                            std::error_code &aEc) noexcept
+{
+    SocketBase<SysWrapperT>::reusePort(aIsReusePort, aEc);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+void Socket<FlagsT, SysWrapperT>::busyPoll(
+    const std::chrono::microseconds aDuration)
+{
+    SocketBase<SysWrapperT>::busyPoll(aDuration);
+}
+
+template <typename FlagsT, typename SysWrapperT>
+void Socket<FlagsT, SysWrapperT>::busyPoll(
+    const std::chrono::microseconds aDuration, std::error_code &aEc) noexcept
+{
+    SocketBase<SysWrapperT>::busyPoll(aDuration, aEc);
+}
+
 template <typename FlagsT, typename SysWrapperT>
 FlagsT Socket<FlagsT, SysWrapperT>::flags() const noexcept
 {
@@ -0,0 +1,215 @@
+#ifndef ndt_socket_options_h
+#define ndt_socket_options_h
+
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+
+#include "common.h"
+
+namespace ndt
+{
+/*! \namespace opt
+    \brief Socket options for SocketBase::set and SocketBase::get:
+
+       socket.set<ndt::opt::RecvBufferSize>(8 << 20);
+       const int size = socket.get<ndt::opt::RecvBufferSize>();
+
+   Option type defines level and name of the option, type of its value and
+   conversion of the value to the integer which kernel takes. Options which
+   platform doesn't have aren't defined, so using them doesn't compile.
+ */
+namespace opt
+{
+template <int Level, int Name, typename ValueT = int>
+struct Option
+{
+    static constexpr int kLevel = Level;
+    static constexpr int kName = Name;
+    using ValueType = ValueT;
+    using NativeType = int;
+
+    static constexpr NativeType toNative(const ValueType aValue) noexcept
+    {
+        return static_cast<NativeType>(aValue);
+    }
+
+    static constexpr ValueType fromNative(const NativeType aValue) noexcept
+    {
+        return static_cast<ValueType>(aValue);
+    }
+};
+
+template <int Level, int Name>
+struct BoolOption : Option<Level, Name, bool>
+{
+    static constexpr int toNative(const bool aValue) noexcept
+    {
+        return aValue ? 1 : 0;
+    }
+
+    static constexpr bool fromNative(const int aValue) noexcept
+    {
+        return aValue != 0;
+    }
+};
+
+// Linux reports doubled size, the other half is bookkeeping overhead. Sizes
+// above net.core.rmem_max and net.core.wmem_max are capped.
+struct RecvBufferSize : Option<SOL_SOCKET, SO_RCVBUF>
+{
+};
+
+struct SendBufferSize : Option<SOL_SOCKET, SO_SNDBUF>
+{
+};
+
+template <int Level, int Name>
+struct DscpOption : Option<Level, Name, uint8_t>
+{
+    static constexpr int toNative(const uint8_t aValue) noexcept
+    {
+        return (aValue & 0x3F) << 2;
+    }
+
+    static constexpr uint8_t fromNative(const int aValue) noexcept
+    {
+        return static_cast<uint8_t>((aValue >> 2) & 0x3F);
+    }
+};
+
+// type of service byte of IPv4 header, IPv6 socket uses TrafficClass
+struct Tos : Option<IPPROTO_IP, IP_TOS, uint8_t>
+{
+};
+
+// differentiated services code point, upper 6 bits of IPv4 type of service.
+// It is IPv4 only, IPv6 socket uses Dscp6.
+struct Dscp : DscpOption<IPPROTO_IP, IP_TOS>
+{
+};
+
+#if defined(IPV6_TCLASS)
+// traffic class byte of IPv6 header, the same as Tos of IPv4
+struct TrafficClass : Option<IPPROTO_IPV6, IPV6_TCLASS, uint8_t>
+{
+};
+
+// differentiated services code point, upper 6 bits of IPv6 traffic class
+struct Dscp6 : DscpOption<IPPROTO_IPV6, IPV6_TCLASS>
+{
+};
+#endif
+
+// IPv6 socket doesn't serve IPv4 peers when it is on, default value depends
+// on platform
+struct V6Only : BoolOption<IPPROTO_IPV6, IPV6_V6ONLY>
+{
+};
+
+// lets listening socket bind port whose old connections are in TIME_WAIT
+struct ReuseAddress : BoolOption<SOL_SOCKET, SO_REUSEADDR>
+{
+};
+
+// pending error of socket, e.g. result of non-blocking connect, reading
+// clears it
+struct SocketError : Option<SOL_SOCKET, SO_ERROR>
+{
+};
+
+// sends small TCP segments right away instead of coalescing them (Nagle's
+// algorithm)
+struct NoDelay : BoolOption<IPPROTO_TCP, TCP_NODELAY>
+{
+};
+
+#if defined(SO_REUSEPORT)
+struct ReusePort : BoolOption<SOL_SOCKET, SO_REUSEPORT>
+{
+};
+#endif
+
+#if defined(SO_PRIORITY)
+// priority of socket's packets in device queues, values above 6 require
+// CAP_NET_ADMIN
+struct Priority : Option<SOL_SOCKET, SO_PRIORITY>
+{
+};
+#endif
+
+#if defined(IP_MTU_DISCOVER)
+// IP_PMTUDISC_DONT, IP_PMTUDISC_WANT, IP_PMTUDISC_DO, IP_PMTUDISC_PROBE.
+// It is IPv4 only, IPv6 socket uses MtuDiscover6.
+struct MtuDiscover : Option<IPPROTO_IP, IP_MTU_DISCOVER>
+{
+};
+#endif
+
+#if defined(IPV6_MTU_DISCOVER)
+// IPV6_PMTUDISC_DONT, IPV6_PMTUDISC_WANT, IPV6_PMTUDISC_DO,
+// IPV6_PMTUDISC_PROBE
+struct MtuDiscover6 : Option<IPPROTO_IPV6, IPV6_MTU_DISCOVER>
+{
+};
+#endif
+
+#if defined(SO_BUSY_POLL)
+struct BusyPoll : Option<SOL_SOCKET, SO_BUSY_POLL, std::chrono::microseconds>
+{
+    static constexpr int toNative(
+        const std::chrono::microseconds aValue) noexcept
+    {
+        return static_cast<int>(aValue.count());
+    }
+
+    static constexpr std::chrono::microseconds fromNative(
+        const int aValue) noexcept
+    {
+        return std::chrono::microseconds(aValue);
+    }
+};
+#endif
+
+#if defined(UDP_SEGMENT)
+// segment size of UDP GSO for all sends of socket, 0 turns it off
+struct UdpSegment : Option<IPPROTO_UDP, UDP_SEGMENT>
+{
+};
+#endif
+
+#if defined(UDP_GRO)
+struct UdpGro : BoolOption<IPPROTO_UDP, UDP_GRO>
+{
+};
+#endif
+
+#if defined(SO_ZEROCOPY)
+struct ZeroCopy : BoolOption<SOL_SOCKET, SO_ZEROCOPY>
+{
+};
+#endif
+
+#if defined(SO_TIMESTAMPNS)
+// kernel attaches arrival time to every received datagram, see
+// SocketBase::recvFrom with RecvTimeT
+struct RecvTimestamp : BoolOption<SOL_SOCKET, SO_TIMESTAMPNS>
+{
+};
+#endif
+
+template <typename T, typename = void>
+struct IsOption : std::false_type
+{
+};
+
+template <typename T>
+struct IsOption<T, std::void_t<decltype(T::kLevel), decltype(T::kName),
+                               typename T::ValueType, typename T::NativeType>>
+    : std::true_type
+{
+};
+}  // namespace opt
+}  // namespace ndt
+
+#endif /* ndt_socket_options_h */
@@ -18,12 +18,28 @@ class SysSocketOps
     static sdlen_t sendto(sock_t sockfd, ndt::cbufp_t buf, ndt::dlen_t len,
                           int flags, const struct sockaddr *dest_addr,
                           ndt::salen_t addrlen) noexcept;
+    static int connect(sock_t sockfd, const struct sockaddr *addr,
+                       ndt::salen_t addrlen) noexcept;
+    static sdlen_t send(sock_t sockfd, ndt::cbufp_t buf, ndt::dlen_t len,
+                        int flags) noexcept;
+    static sdlen_t recv(sock_t sockfd, ndt::bufp_t buf, ndt::dlen_t len,
+                        int flags) noexcept;
     static sock_t socket(int socket_family, int socket_type,
                          int protocol) noexcept;
+    static int listen(sock_t sockfd, int backlog) noexcept;
+    static sock_t accept(sock_t sockfd, struct sockaddr *addr,
+                         ndt::salen_t *addrlen) noexcept;
+    static int shutdown(sock_t sockfd, int how) noexcept;
     static int close(sock_t fd) noexcept;
     static const char *inet_ntop(int af, const void *src, char *dst,
                                  salen_t size) noexcept;
     static int inet_pton(int af, const char *src, void *dst) noexcept;
+    static int setsockopt(sock_t sockfd, int level, int optname,
+                          const void *optval, salen_t optlen) noexcept;
+    static int getsockopt(sock_t sockfd, int level, int optname, void *optval,
+                          salen_t *optlen) noexcept;
+    static int getsockname(sock_t sockfd, struct sockaddr *addr,
+                           salen_t *addrlen) noexcept;
     [[nodiscard]] static int select(int nfds, fd_set *readfds, fd_set *writefds,
                                     fd_set *exceptfds,
                                     struct timeval *timeout) noexcept;
@@ -33,6 +49,42 @@ class SysSocketOps
     static int WSACleanup() noexcept;
 #else
     static int fcntl(sock_t s, int cmd, int arg) noexcept;
+    static int pipe(int pipefd[2]) noexcept;
+    static sdlen_t read(int fd, bufp_t buf, dlen_t count) noexcept;
+    static sdlen_t write(int fd, cbufp_t buf, dlen_t count) noexcept;
+    static sdlen_t sendmsg(sock_t sockfd, const struct msghdr *msg,
+                           int flags) noexcept;
+    static sdlen_t recvmsg(sock_t sockfd, struct msghdr *msg,
+                           int flags) noexcept;
+#endif
+#if defined(__linux__)
+    static int recvmmsg(sock_t sockfd, struct mmsghdr *msgvec,
+                        unsigned int vlen, int flags,
+                        struct timespec *timeout) noexcept;
+    static int sendmmsg(sock_t sockfd, struct mmsghdr *msgvec,
+                        unsigned int vlen, int flags) noexcept;
+    static int epoll_create1(int flags) noexcept;
+    static int epoll_ctl(int epfd, int op, sock_t fd,
+                         struct epoll_event *event) noexcept;
+    [[nodiscard]] static int epoll_wait(int epfd, struct epoll_event *events,
+                                        int maxevents, int timeout) noexcept;
+    static int eventfd(unsigned int initval, int flags) noexcept;
+    static int memfd_create(const char *name, unsigned int flags) noexcept;
+    static int ftruncate(int fd, off_t length) noexcept;
+    static int fstat(int fd, struct stat *statbuf) noexcept;
+    static void *mmap(void *addr, std::size_t length, int prot, int flags,
+                      int fd, off_t offset) noexcept;
+    static int munmap(void *addr, std::size_t length) noexcept;
+#endif
+#if defined(NDT_HAS_IO_URING)
+    static int io_uring_setup(unsigned entries,
+                              struct io_uring_params *p) noexcept;
+    [[nodiscard]] static int io_uring_enter(int fd, unsigned to_submit,
+                                            unsigned min_complete,
+                                            unsigned flags, const void *arg,
+                                            std::size_t argsz) noexcept;
+    static int io_uring_register(int fd, unsigned opcode, void *arg,
+                                 unsigned nr_args) noexcept;
 #endif
 };
 
@@ -0,0 +1,545 @@
+#ifndef ndt_tcp_h
+#define ndt_tcp_h
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+#include "address.h"
+#include "buffer.h"
+#include "common.h"
+#include "exception.h"
+#include "socket.h"
+#include "socket_options.h"
+#include "utils.h"
+
+namespace ndt
+{
+/*! \class TCP
+    \brief Flags of TCP stream socket. Socket<TCP> is driven by the same
+   executors as UDP one: listening socket reports incoming connections as
+   read readiness (readHandlerImpl calls accept), connecting non-blocking
+   socket reports result of connect as write readiness (writeHandlerImpl
+   calls finishConnect). Data is read in readHandlerImpl and written in
+   writeHandlerImpl, recvHandlerImpl isn't supported.
+
+   send and recv take arrays of buffers, so header and payload of a message
+   go to the kernel in a single system call without being copied into one
+   buffer. Stream may be written and read partially, use consume to skip
+   transferred bytes before the next call.
+ */
+class TCP final
+{
+   public:
+    using Socket = ndt::Socket<TCP, SocketOps>;
+
+    static TCP V4() noexcept;
+    static TCP V6() noexcept;
+    // IPv6 socket which accepts IPv4 peers too, see UDP::DualStack
+    static TCP DualStack() noexcept;
+
+    eAddressFamily getFamily() const noexcept;
+    eSocketType getSocketType() const noexcept;
+    eIPProtocol getProtocol() const noexcept;
+
+    uint8_t sysFamily() const noexcept;
+    int sysSocketType() const noexcept;
+    int sysProtocol() const noexcept;
+    bool isDualStack() const noexcept;
+
+    friend bool operator==(const TCP &aVal1, const TCP &aVal2);
+    friend bool operator!=(const TCP &aVal1, const TCP &aVal2);
+
+   private:
+    explicit TCP(const eAddressFamily aAF,
+                 const bool aIsDualStack = false) noexcept;
+    uint8_t _af;
+    bool _isDualStack;
+};
+
+namespace details
+{
+// writing to connection which peer has closed fails with EPIPE instead of
+// raising SIGPIPE
+#if defined(MSG_NOSIGNAL)
+inline constexpr int kStreamSendFlags = MSG_NOSIGNAL;
+#else
+inline constexpr int kStreamSendFlags = 0;
+#endif
+}  // namespace details
+
+template <typename SysWrapperT>
+class Socket<TCP, SysWrapperT> final : public SocketBase<SysWrapperT>
+{
+   public:
+    typedef TCP SocketT;
+    typedef SysWrapperT SysCallsT;
+    // max number of buffers which send and recv pass to a single system
+    // call, the rest is left for the next call
+    static constexpr std::size_t kMaxBufferCount = 64;
+
+    ~Socket();
+    Socket() = delete;
+    Socket(Socket &&) noexcept;
+    Socket &operator=(Socket &&) noexcept;
+    Socket(Context<SysWrapperT> &aContext, const TCP &aFlags) noexcept;
+
+    void open();
+    void open(std::error_code &aEc);
+    void bind(const uint16_t aPort);
+    void bind(const uint16_t aPort, std::error_code &aEc);
+    void bind(const Address &aLocal);
+    void bind(const Address &aLocal, std::error_code &aEc);
+    void listen(const int aBacklog = SOMAXCONN);
+    void listen(const int aBacklog, std::error_code &aEc);
+    // Returns connected socket, it is non-blocking if listening socket is.
+    // Non-blocking listening socket fails with operation_would_block when
+    // there is no pending connection, returned socket isn't open then.
+    Socket accept(Address &aPeer);
+    Socket accept(Address &aPeer, std::error_code &aEc);
+    // Non-blocking socket fails with operation_in_progress
+    // (operation_would_block on Windows), finishConnect reports result once
+    // socket becomes writable.
+    void connect(const Address &aPeer);
+    void connect(const Address &aPeer, std::error_code &aEc);
+    void finishConnect();
+    void finishConnect(std::error_code &aEc);
+    bool isConnected() const noexcept;
+    // Return number of transferred bytes, it may be less than total size of
+    // the buffers. recv returns 0 without error when peer has closed
+    // connection.
+    std::size_t send(CBuffer aBuf);
+    std::size_t send(CBuffer aBuf, std::error_code &aEc);
+    std::size_t send(const CBuffer *aBufs, const std::size_t aCount);
+    std::size_t send(const CBuffer *aBufs, const std::size_t aCount,
+                     std::error_code &aEc);
+    // size of aBuf is set to number of received bytes
+    std::size_t recv(Buffer &aBuf);
+    std::size_t recv(Buffer &aBuf, std::error_code &aEc);
+    // aBufs are filled in order, their sizes aren't changed
+    std::size_t recv(Buffer *aBufs, const std::size_t aCount);
+    std::size_t recv(Buffer *aBufs, const std::size_t aCount,
+                     std::error_code &aEc);
+    // sends FIN after queued data, peer's recv returns 0 then
+    void shutdown();
+    void shutdown(std::error_code &aEc);
+    void close();
+    void close(std::error_code &aEc);
+    TCP flags() const noexcept;
+
+   private:
+    void assignError(std::error_code &aEc) const;
+    void noSigPipe(std::error_code &aEc) noexcept;
+
+    TCP flags_;
+};
+
+template <typename SysWrapperT>
+Socket<TCP, SysWrapperT>::~Socket()
+{
+}
+
+template <typename SysWrapperT>
+Socket<TCP, SysWrapperT>::Socket(Socket &&aOther) noexcept
+    : SocketBase<SysWrapperT>(std::move(aOther)), flags_(aOther.flags_)
+{
+}
+
+template <typename SysWrapperT>
+Socket<TCP, SysWrapperT> &Socket<TCP, SysWrapperT>::operator=(
+    Socket &&aOther) noexcept
+{
+    SocketBase<SysWrapperT>::operator=(std::move(aOther));
+    std::swap(aOther.flags_, flags_);
+    return *this;
+}
+
+template <typename SysWrapperT>
+Socket<TCP, SysWrapperT>::Socket(Context<SysWrapperT> &aContext,
+                                 const TCP &aFlags) noexcept
+    : SocketBase<SysWrapperT>(aContext), flags_(aFlags)
+{
+    // stream is read by handler, not by io_uring recvmsg of datagrams
+    this->isNativeRecv_ = false;
+}
+
+template <typename SysWrapperT>
+void Socket<TCP, SysWrapperT>::open()
+{
+    std::error_code ec;
+    Socket::open(ec);
+    throw_if_error(ec);
+}
+
+template <typename SysWrapperT>
+void Socket<TCP, SysWrapperT>::open(std::error_code &aEc)
+{
+    SocketBase<SysWrapperT>::open(flags_.sysFamily(), flags_.sysSocketType(),
+                                  flags_.sysProtocol(), aEc);
+    if (aEc)
+    {
+        return;
+    }
+    if (flags_.isDualStack())
+    {
+        SocketBase<SysWrapperT>::template set<opt::V6Only>(false, aEc);
+    }
+    if (!aEc)
+    {
+        noSigPipe(aEc);
+    }
+    if (aEc)
+    {
+        std::error_code closeEc;
+        SocketBase<SysWrapperT>::close(closeEc);
+    }
+}
+
+template <typename SysWrapperT>
+void Socket<TCP, SysWrapperT>::bind(const uint16_t aPort)
+{
+    std::error_code ec;
+    Socket::bind(aPort, ec);
+    throw_if_error(ec);
+}
+
+template <typename SysWrapperT>
+void Socket<TCP, SysWrapperT>::bind(const uint16_t aPort,
+                                    std::error_code &aEc)
+{
+    SocketBase<SysWrapperT>::bind(flags_.sysFamily(), aPort, aEc);
+}
+
+template <typename SysWrapperT>
+void Socket<TCP, SysWrapperT>::bind(const Address &aLocal)
+{
+    std::error_code ec;
+    Socket::bind(aLocal, ec);
+    throw_if_error(ec);
+}
+
+template <typename SysWrapperT>
+void Socket<TCP, SysWrapperT>::bind(const Address &aLocal,
+                                    std::error_code &aEc)
+{
+    SocketBase<SysWrapperT>::bind(aLocal, aEc);
+}
+
+template <typename SysWrapperT>
+void Socket<TCP, SysWrapperT>::listen(const int aBacklog)
+{
+    std::error_code ec;
+    Socket::listen(aBacklog, ec);
+    throw_if_error(ec);
+}
+
+template <typename SysWrapperT>
+void Socket<TCP, SysWrapperT>::listen(const int aBacklog,
+                                      std::error_code &aEc)
+{
+    if (SysWrapperT::listen(this->socketHandle_, aBacklog) == kSocketError)
+    {
+        assignError(aEc);
+    }
+}
+
+template <typename SysWrapperT>
+Socket<TCP, SysWrapperT> Socket<TCP, SysWrapperT>::accept(Address &aPeer)
+{
+    std::error_code ec;
+    auto result = Socket::accept(aPeer, ec);
+    throw_if_error(ec);
+    return result;
+}
+
+template <typename SysWrapperT>
+Socket<TCP, SysWrapperT> Socket<TCP, SysWrapperT>::accept(
+    Address &aPeer, std::error_code &aEc)
+{
+    Socket result(this->context_.get(), flags_);
+    auto peerLength = static_cast<salen_t>(kMaxAddressCapacity);
+    const sock_t handle = SysWrapperT::accept(
+        this->socketHandle_, aPeer.nativeData(), &peerLength);
+    if (handle == kInvalidSocket)
+    {
+        assignError(aEc);
+        return result;
+    }
+    aPeer.nativeLength(static_cast<std::size_t>(peerLength));
+    result.socketHandle_ = handle;
+    result.isOpen_ = true;
+    result.isConnected_ = true;
+    // whether accepted socket inherits O_NONBLOCK depends on platform
+    result.nonBlocking(this->isNonBlocking_, aEc);
+    if (!aEc)
+    {
+        result.noSigPipe(aEc);
+    }
+    if (aEc)
+    {
+        std::error_code closeEc;
+        result.close(closeEc);
+    }
+    return result;
+}
+
+template <typename SysWrapperT>
+void Socket<TCP, SysWrapperT>::connect(const Address &aPeer)
+{
+    std::error_code ec;
+    Socket::connect(aPeer, ec);
+    throw_if_error(ec);
+}
+
+template <typename SysWrapperT>
+void Socket<TCP, SysWrapperT>::connect(const Address &aPeer,
+                                       std::error_code &aEc)
+{
+    SocketBase<SysWrapperT>::connect(aPeer, aEc);
+}
+
+template <typename SysWrapperT>
+void Socket<TCP, SysWrapperT>::finishConnect()
+{
+    std::error_code ec;
+    Socket::finishConnect(ec);
+    throw_if_error(ec);
+}
+
+template <typename SysWrapperT>
+void Socket<TCP, SysWrapperT>::finishConnect(std::error_code &aEc)
+{
+    const int error =
+        SocketBase<SysWrapperT>::template get<opt::SocketError>(aEc);
+    if (aEc)
+    {
+        return;
+    }
+    if (error != 0)
+    {
+        aEc.assign(error, std::system_category());
+        return;
+    }
+    this->isConnected_ = true;
+}
+
+template <typename SysWrapperT>
+bool Socket<TCP, SysWrapperT>::isConnected() const noexcept
+{
+    return this->isConnected_;
+}
+
+template <typename SysWrapperT>
+std::size_t Socket<TCP, SysWrapperT>::send(CBuffer aBuf)
+{
+    std::error_code ec;
+    const auto bytesSent = Socket::send(aBuf, ec);
+    throw_if_error(ec);
+    return bytesSent;
+}
+
+template <typename SysWrapperT>
+std::size_t Socket<TCP, SysWrapperT>::send(CBuffer aBuf, std::error_code &aEc)
+{
+    return Socket::send(&aBuf, 1, aEc);
+}
+
+template <typename SysWrapperT>
+std::size_t Socket<TCP, SysWrapperT>::send(const CBuffer *aBufs,
+                                           const std::size_t aCount)
+{
+    std::error_code ec;
+    const auto bytesSent = Socket::send(aBufs, aCount, ec);
+    throw_if_error(ec);
+    return bytesSent;
+}
+
+template <typename SysWrapperT>
+std::size_t Socket<TCP, SysWrapperT>::send(const CBuffer *aBufs,
+                                           const std::size_t aCount,
+                                           std::error_code &aEc)
+{
+#if _WIN32
+    // no writev, buffers are sent one by one until the first partial write
+    std::size_t bytesSent = 0;
+    for (std::size_t i = 0; i < aCount; ++i)
+    {
+        const auto result =
+            SysWrapperT::send(this->socketHandle_, aBufs[i].data(),
+                              aBufs[i].size(), details::kStreamSendFlags);
+        if (result == kSocketError)
+        {
+            if (bytesSent == 0)
+            {
+                assignError(aEc);
+            }
+            return bytesSent;
+        }
+        bytesSent += static_cast<std::size_t>(result);
+        if (static_cast<std::size_t>(result) < aBufs[i].size<std::size_t>())
+        {
+            break;
+        }
+    }
+    return bytesSent;
+#else
+    const std::size_t count = std::min(aCount, kMaxBufferCount);
+    std::array<iovec, kMaxBufferCount> iovs;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        // sendmsg doesn't modify data
+        iovs[i].iov_base = const_cast<void *>(aBufs[i].data());
+        iovs[i].iov_len = aBufs[i].size<std::size_t>();
+    }
+    msghdr msg = {};
+    msg.msg_iov = iovs.data();
+    msg.msg_iovlen = count;
+    const auto bytesSent = SysWrapperT::sendmsg(this->socketHandle_, &msg,
+                                                details::kStreamSendFlags);
+    if (bytesSent == kSocketError)
+    {
+        assignError(aEc);
+        return 0;
+    }
+    return static_cast<std::size_t>(bytesSent);
+#endif
+}
+
+template <typename SysWrapperT>
+std::size_t Socket<TCP, SysWrapperT>::recv(Buffer &aBuf)
+{
+    std::error_code ec;
+    const auto bytesReceived = Socket::recv(aBuf, ec);
+    throw_if_error(ec);
+    return bytesReceived;
+}
+
+template <typename SysWrapperT>
+std::size_t Socket<TCP, SysWrapperT>::recv(Buffer &aBuf, std::error_code &aEc)
+{
+    return SocketBase<SysWrapperT>::recv(aBuf, aEc);
+}
+
+template <typename SysWrapperT>
+std::size_t Socket<TCP, SysWrapperT>::recv(Buffer *aBufs,
+                                           const std::size_t aCount)
+{
+    std::error_code ec;
+    const auto bytesReceived = Socket::recv(aBufs, aCount, ec);
+    throw_if_error(ec);
+    return bytesReceived;
+}
+
+template <typename SysWrapperT>
+std::size_t Socket<TCP, SysWrapperT>::recv(Buffer *aBufs,
+                                           const std::size_t aCount,
+                                           std::error_code &aEc)
+{
+#if _WIN32
+    // no readv, buffers are filled one by one until the first short read
+    std::size_t bytesReceived = 0;
+    for (std::size_t i = 0; i < aCount; ++i)
+    {
+        const auto result = SysWrapperT::recv(
+            this->socketHandle_, aBufs[i].data(), aBufs[i].size(), 0);
+        if (result == kSocketError)
+        {
+            if (bytesReceived == 0)
+            {
+                assignError(aEc);
+            }
+            return bytesReceived;
+        }
+        bytesReceived += static_cast<std::size_t>(result);
+        if (static_cast<std::size_t>(result) < aBufs[i].size<std::size_t>())
+        {
+            break;
+        }
+    }
+    return bytesReceived;
+#else
+    const std::size_t count = std::min(aCount, kMaxBufferCount);
+    std::array<iovec, kMaxBufferCount> iovs;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        iovs[i].iov_base = aBufs[i].data();
+        iovs[i].iov_len = aBufs[i].size<std::size_t>();
+    }
+    msghdr msg = {};
+    msg.msg_iov = iovs.data();
+    msg.msg_iovlen = count;
+    const auto bytesReceived =
+        SysWrapperT::recvmsg(this->socketHandle_, &msg, 0);
+    if (bytesReceived == kSocketError)
+    {
+        assignError(aEc);
+        return 0;
+    }
+    return static_cast<std::size_t>(bytesReceived);
+#endif
+}
+
+template <typename SysWrapperT>
+void Socket<TCP, SysWrapperT>::shutdown()
+{
+    std::error_code ec;
+    Socket::shutdown(ec);
+    throw_if_error(ec);
+}
+
+template <typename SysWrapperT>
+void Socket<TCP, SysWrapperT>::shutdown(std::error_code &aEc)
+{
+#if _WIN32
+    constexpr int kHow = SD_SEND;
+#else
+    constexpr int kHow = SHUT_WR;
+#endif
+    if (SysWrapperT::shutdown(this->socketHandle_, kHow) == kSocketError)
+    {
+        assignError(aEc);
+    }
+}
+
+template <typename SysWrapperT>
+void Socket<TCP, SysWrapperT>::close()
+{
+    SocketBase<SysWrapperT>::close();
+}
+
+template <typename SysWrapperT>
+void Socket<TCP, SysWrapperT>::close(std::error_code &aEc)
+{
+    SocketBase<SysWrapperT>::close(aEc);
+}
+
+template <typename SysWrapperT>
+TCP Socket<TCP, SysWrapperT>::flags() const noexcept
+{
+    return flags_;
+}
+
+template <typename SysWrapperT>
+void Socket<TCP, SysWrapperT>::assignError(std::error_code &aEc) const
+{
+    aEc.assign(SysWrapperT::lastErrorCode(), std::system_category());
+}
+
+template <typename SysWrapperT>
+void Socket<TCP, SysWrapperT>::noSigPipe(std::error_code &aEc) noexcept
+{
+#if defined(SO_NOSIGPIPE) && !defined(MSG_NOSIGNAL)
+    // platforms without MSG_NOSIGNAL (macOS) turn SIGPIPE off per socket
+    const int isOn = 1;
+    if (SysWrapperT::setsockopt(this->socketHandle_, SOL_SOCKET, SO_NOSIGPIPE,
+                                &isOn, sizeof(isOn)) == kSocketError)
+    {
+        assignError(aEc);
+    }
+#else
+    (void)aEc;
+#endif
+}
+}  // namespace ndt
+
+#endif /* ndt_tcp_h */
@@ -0,0 +1,148 @@
+#ifndef ndt_timer_wheel_h
+#define ndt_timer_wheel_h
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "useful_base_types.h"
+
+namespace ndt
+{
+class TimerWheel;
+class TimerPool;
+
+struct TimerLink
+{
+    TimerLink *prev_ = nullptr;
+    TimerLink *next_ = nullptr;
+};
+
+/*! \class Timer
+    \brief Intrusive timer node. Timer is usually embedded into object it
+   belongs to (e.g. per-peer session) or taken from TimerPool, so arming it
+   never allocates. Callback is set once and can't be changed while timer is
+   armed. Destroying armed timer cancels it. Callback may re-arm its timer or
+   release it to TimerPool but must not destroy it.
+ */
+class Timer final
+    : private TimerLink
+    , private NoCopyAble
+    , private NoMoveAble
+{
+    friend class TimerWheel;
+    friend class TimerPool;
+
+   public:
+    using CallbackT = std::function<void()>;
+
+    ~Timer();
+    Timer() noexcept;
+    explicit Timer(CallbackT aCallback);
+
+    void callback(CallbackT aCallback);
+    bool isArmed() const noexcept;
+    uint64_t expiry() const noexcept;
+
+   private:
+    CallbackT callback_;
+    TimerWheel *wheel_ = nullptr;
+    uint64_t expiry_ = 0;
+    uint8_t level_ = 0;
+    uint8_t slot_ = 0;
+};
+
+/*! \class TimerWheel
+    \brief Hierarchical timing wheel: 4 levels of 256 slots, one tick of the
+   lowest level is one millisecond, so timers up to ~49 days are placed
+   directly and further ones wait in overflow list. schedule, cancel and
+   firing of a timer are O(1); timer is moved to lower level at most once per
+   level (cascading).
+
+   Time is measured in ticks from arbitrary origin. advance moves wheel time
+   forward and fires expired timers, so callbacks are called only from
+   advance. Callbacks may schedule and cancel any timers.
+ */
+class TimerWheel final
+    : private NoCopyAble
+    , private NoMoveAble
+{
+   public:
+    static constexpr std::size_t kLevelBits = 8;
+    static constexpr std::size_t kSlotCount = 1 << kLevelBits;
+    static constexpr std::size_t kLevelCount = 4;
+    static constexpr uint64_t kNever = std::numeric_limits<uint64_t>::max();
+
+    ~TimerWheel();
+    TimerWheel() noexcept;
+
+    // timer expiring at or before current tick fires on the next tick
+    void schedule(Timer &aTimer, const uint64_t aExpiry);
+    void cancel(Timer &aTimer) noexcept;
+
+    // returns number of fired timers
+    std::size_t advance(const uint64_t aNow);
+
+    uint64_t now() const noexcept;
+    std::size_t size() const noexcept;
+    bool empty() const noexcept;
+
+    // tick at which wheel has to be advanced next time: exact expiry if
+    // the earliest timer is on the lowest level, otherwise the tick when it
+    // is cascaded. kNever if there are no timers.
+    uint64_t nextExpiry() const noexcept;
+
+   private:
+    struct Level
+    {
+        Level() noexcept;
+        std::array<TimerLink, kSlotCount> slots_;
+        std::array<uint64_t, kSlotCount / 64> occupied_ = {};
+    };
+
+    static constexpr uint8_t kOverflowLevel = kLevelCount;
+
+    void link(Timer &aTimer);
+    void unlink(Timer &aTimer) noexcept;
+    void cascade(const std::size_t aLevel);
+    void relinkOverflow();
+    static Timer &timer(TimerLink *aLink) noexcept;
+
+    uint64_t now_ = 0;
+    std::size_t size_ = 0;
+    // allocated on first schedule, Context which never uses timers doesn't
+    // pay for them
+    std::unique_ptr<Level[]> levels_;
+    TimerLink overflow_;
+};
+
+/*! \class TimerPool
+    \brief Keeps released timers for reuse, so that timer per packet costs no
+   allocation once pool is warmed up. Pool must outlive timers taken from it.
+ */
+class TimerPool final
+    : private NoCopyAble
+    , private NoMoveAble
+{
+   public:
+    ~TimerPool();
+    TimerPool() noexcept;
+
+    Timer &acquire(Timer::CallbackT aCallback);
+    // cancels timer if it is armed
+    void release(Timer &aTimer) noexcept;
+
+    std::size_t capacity() const noexcept;
+    std::size_t available() const noexcept;
+
+   private:
+    std::deque<Timer> timers_;
+    std::vector<Timer *> free_;
+};
+}  // namespace ndt
+
+#endif /* ndt_timer_wheel_h */
@@ -13,6 +13,9 @@ class UDP final
 
     static UDP V4() noexcept;
     static UDP V6() noexcept;
+    // IPv6 socket which serves IPv4 peers too, they have v4-mapped addresses
+    // (::ffff:a.b.c.d), see Address::normalize
+    static UDP DualStack() noexcept;
 
     eAddressFamily getFamily() const noexcept;
     eSocketType getSocketType() const noexcept;
@@ -21,13 +24,16 @@ class UDP final
     uint8_t sysFamily() const noexcept;
     int sysSocketType() const noexcept;
     int sysProtocol() const noexcept;
+    bool isDualStack() const noexcept;
 
     friend bool operator==(const UDP& aVal1, const UDP& aVal2);
     friend bool operator!=(const UDP& aVal1, const UDP& aVal2);
 
    private:
-    explicit UDP(const eAddressFamily aAF) noexcept;
+    explicit UDP(const eAddressFamily aAF,
+                 const bool aIsDualStack = false) noexcept;
     uint8_t _af;
+    bool _isDualStack;
 };
 }  // namespace ndt
 
@@ -0,0 +1,38 @@
+#ifndef ndt_unix_dgram_h
+#define ndt_unix_dgram_h
+
+#include "utils.h"
+#include "socket.h"
+
+#if !_WIN32
+namespace ndt
+{
+/*! \class UnixDgram
+    \brief Flags of AF_UNIX datagram socket for processes of the same host.
+   Socket is bound to Address made by Address::unixPath or
+   Address::abstractPath and otherwise is used the same way as UDP one.
+   Datagrams bypass IP stack, full queue of receiver makes sender wait
+   instead of dropping them.
+ */
+class UnixDgram final
+{
+   public:
+    using Socket = ndt::Socket<UnixDgram, SocketOps>;
+
+    UnixDgram() noexcept = default;
+
+    eAddressFamily getFamily() const noexcept;
+    eSocketType getSocketType() const noexcept;
+    eIPProtocol getProtocol() const noexcept;
+
+    uint8_t sysFamily() const noexcept;
+    int sysSocketType() const noexcept;
+    int sysProtocol() const noexcept;
+
+    friend bool operator==(const UnixDgram& aVal1, const UnixDgram& aVal2);
+    friend bool operator!=(const UnixDgram& aVal1, const UnixDgram& aVal2);
+};
+}  // namespace ndt
+#endif
+
+#endif /* ndt_unix_dgram_h */
@@ -23,6 +23,9 @@ union sa_u
     sockaddr sa;
     sockaddr_in sa4;
     sockaddr_in6 sa6;
+#if !_WIN32
+    sockaddr_un saun;
+#endif
 };
 
 enum class eSocketType : std::uint8_t
@@ -36,7 +39,8 @@ enum class eAddressFamily : std::uint8_t
 {
     kUnspec,
     kIPv4,
-    kIPv6
+    kIPv6,
+    kUnix
 };
 
 enum class eIPProtocol : std::uint8_t
@@ -92,6 +96,8 @@ extern const ipv6_t kIPv6Loopback;
 
 inline constexpr std::size_t kV4Capacity = sizeof(sockaddr_in);
 inline constexpr std::size_t kV6Capacity = sizeof(sockaddr_in6);
+// size of the largest address which socket may report for peer
+inline constexpr std::size_t kMaxAddressCapacity = sizeof(sa_u);
 
 template <typename T>
 using Int =
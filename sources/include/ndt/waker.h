@@ -0,0 +1,12 @@
+#ifndef ndt_waker_h
+#define ndt_waker_h
+
+#if defined(__linux__)
+#include "platform/linux/waker_impl.h"
+#elif defined(_WIN32)
+#include "platform/win/waker_impl.h"
+#else
+#include "platform/nix/waker_impl.h"
+#endif
+
+#endif /* ndt_waker_h */
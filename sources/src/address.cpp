@@ -1,5 +1,7 @@
 #include "ndt/address.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstring>
 
 #include "ndt/bin_rw.h"
@@ -58,6 +60,13 @@ Address::Address(const ipv6_t &aIPv6, const uint16_t aPort) noexcept : Address()
 Address::Address(const sockaddr &aSockaddr) : Address()
 {
     const auto family = static_cast<uint8_t>(aSockaddr.sa_family);
+#if !_WIN32
+    if (family == AF_UNIX)
+    {
+        std::memcpy(&sockaddr_, &aSockaddr, sizeof(sockaddr_un));
+        return;
+    }
+#endif
     throwIfInvalidFamily<uint8_t>(family);
 
     if (family == AF_INET)
@@ -126,14 +135,148 @@ void Address::ip(const ipv6_t &aIPv6) noexcept
 
 void Address::port(uint16_t aPort) noexcept
 {
+    // AF_UNIX path occupies bytes of port
+    if (addressFamilySys() == AF_UNIX)
+    {
+        return;
+    }
     sockaddr_.sa4.sin_port = htons(aPort);
 }
 
 uint16_t Address::port() const noexcept
 {
+    if (addressFamilySys() == AF_UNIX)
+    {
+        return 0;
+    }
     return ntohs(sockaddr_.sa4.sin_port);
 }
 
+bool Address::isV4Mapped() const noexcept
+{
+    if (addressFamilySys() != AF_INET6)
+    {
+        return false;
+    }
+    const uint8_t *bytes = sockaddr_.sa6.sin6_addr.s6_addr;
+    constexpr uint8_t kPrefix[12] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xFF, 0xFF};
+    return !std::memcmp(bytes, kPrefix, sizeof(kPrefix));
+}
+
+void Address::normalize() noexcept
+{
+    if (!isV4Mapped())
+    {
+        return;
+    }
+    const auto kPort = port();
+    in_addr v4;
+    std::memcpy(&v4, sockaddr_.sa6.sin6_addr.s6_addr + 12, sizeof(v4));
+    reset();
+    setFamily(AF_INET);
+    sockaddr_.sa4.sin_addr = v4;
+    port(kPort);
+}
+
+void Address::mapToV6() noexcept
+{
+    if (addressFamilySys() != AF_INET)
+    {
+        return;
+    }
+    const auto kPort = port();
+    const in_addr v4 = sockaddr_.sa4.sin_addr;
+    reset();
+    setFamily(AF_INET6);
+    uint8_t *bytes = sockaddr_.sa6.sin6_addr.s6_addr;
+    bytes[10] = 0xFF;
+    bytes[11] = 0xFF;
+    std::memcpy(bytes + 12, &v4, sizeof(v4));
+    port(kPort);
+}
+
+#if !_WIN32
+void Address::unixPath(std::string_view aPath, std::error_code &aEc) noexcept
+{
+    unixName(0, aPath, aEc);
+}
+
+void Address::unixPath(std::string_view aPath)
+{
+    std::error_code ec;
+    unixPath(aPath, ec);
+    throw_if_error(ec);
+}
+
+#if defined(__linux__)
+void Address::abstractPath(std::string_view aName,
+                           std::error_code &aEc) noexcept
+{
+    // abstract name starts after zero character
+    unixName(1, aName, aEc);
+}
+
+void Address::abstractPath(std::string_view aName)
+{
+    std::error_code ec;
+    abstractPath(aName, ec);
+    throw_if_error(ec);
+}
+#endif
+
+std::string_view Address::unixPath() const noexcept
+{
+    if (addressFamilySys() != AF_UNIX)
+    {
+        return {};
+    }
+    constexpr std::size_t kPathSize = sizeof(sockaddr_un::sun_path);
+    const char *path = sockaddr_.saun.sun_path;
+    if (path[0] != '\0')
+    {
+        return {path, strnlen(path, kPathSize)};
+    }
+    return {path + 1, strnlen(path + 1, kPathSize - 1)};
+}
+
+bool Address::isAbstract() const noexcept
+{
+    return (addressFamilySys() == AF_UNIX) &&
+           (sockaddr_.saun.sun_path[0] == '\0') &&
+           (sockaddr_.saun.sun_path[1] != '\0');
+}
+
+std::size_t Address::unixCapacity() const noexcept
+{
+    constexpr std::size_t kPathOffset = offsetof(sockaddr_un, sun_path);
+    constexpr std::size_t kPathSize = sizeof(sockaddr_un::sun_path);
+    const char *path = sockaddr_.saun.sun_path;
+    if (path[0] != '\0')
+    {
+        // terminating zero is counted, path of maximal length has none
+        return kPathOffset + std::min(strnlen(path, kPathSize) + 1, kPathSize);
+    }
+    // abstract name has no terminating zero, unnamed socket has no path
+    const std::size_t nameLength = strnlen(path + 1, kPathSize - 1);
+    return (nameLength == 0) ? kPathOffset : kPathOffset + 1 + nameLength;
+}
+
+void Address::unixName(const std::size_t aOffset, std::string_view aName,
+                       std::error_code &aEc) noexcept
+{
+    constexpr std::size_t kMaxLength = sizeof(sockaddr_un::sun_path) - 1;
+    if (aName.empty() || (aName.size() > kMaxLength) ||
+        (aName.find('\0') != std::string_view::npos))
+    {
+        aEc = eAddressErrorCode::kInvalidUnixPath;
+        return;
+    }
+    reset();
+    setFamily(AF_UNIX);
+    std::memcpy(sockaddr_.saun.sun_path + aOffset, aName.data(), aName.size());
+}
+#endif
+
 const sockaddr *Address::nativeDataConst() const noexcept
 {
     return &sockaddr_.sa;
@@ -147,10 +290,17 @@ void Address::reset() noexcept
 
 std::size_t Address::capacity() const noexcept
 {
-    if (addressFamilySys() == AF_INET)
+    const auto kAf = addressFamilySys();
+    if (kAf == AF_INET)
     {
         return kV4Capacity;
     }
+#if !_WIN32
+    if (kAf == AF_UNIX)
+    {
+        return unixCapacity();
+    }
+#endif
     return kV6Capacity;
 }
 
@@ -222,6 +372,23 @@ void const *Address::ipPtr() const noexcept
 
 sockaddr *Address::nativeData() noexcept { return &sockaddr_.sa; }
 
+void Address::nativeLength(const std::size_t aLength) noexcept
+{
+    if (aLength == 0)
+    {
+        // peer is unnamed socket and some platforms don't write its family
+        reset();
+        return;
+    }
+#if !_WIN32
+    if ((addressFamilySys() == AF_UNIX) && (aLength < sizeof(sockaddr_un)))
+    {
+        std::memset(reinterpret_cast<char *>(&sockaddr_.saun) + aLength, 0,
+                    sizeof(sockaddr_un) - aLength);
+    }
+#endif
+}
+
 const char *AddressErrorCategory::name() const noexcept
 {
     return kAddressErrorCategoryCStr;
@@ -239,6 +406,8 @@ std::string AddressErrorCategory::message(int c) const
             return kAddressUnknownFamilyDescr;
         case eAddressErrorCode::kStringIsNotIpAddress:
             return kStringIsNotIpAddressDescr;
+        case eAddressErrorCode::kInvalidUnixPath:
+            return kInvalidUnixPathDescr;
         default:
             return "unknown";
     }
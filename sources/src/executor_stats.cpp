@@ -0,0 +1,58 @@
+#include "ndt/executor_stats.h"
+
+#include "ndt/common.h"
+
+namespace ndt
+{
+ExecutorStats::~ExecutorStats() = default;
+
+ExecutorStats::ExecutorStats() noexcept = default;
+
+void ExecutorStats::onWait(const ClockT::time_point aStart,
+                           const ClockT::time_point aEnd,
+                           const int aResult) noexcept
+{
+    addSingleWriter(iterations_, 1);
+    waitTime_.record(elapsedNs(aStart, aEnd));
+    if (aResult != kSocketError)
+    {
+        readyCount_.record(static_cast<uint64_t>(aResult));
+    }
+}
+
+void ExecutorStats::onDispatch(const ClockT::time_point aStart) noexcept
+{
+    dispatchTime_.record(elapsedNs(aStart, ClockT::now()));
+}
+
+void ExecutorStats::onHandler(const ClockT::time_point aStart) noexcept
+{
+    handlerTime_.record(elapsedNs(aStart, ClockT::now()));
+}
+
+void ExecutorStats::onTimeout() noexcept { addSingleWriter(timeouts_, 1); }
+
+void ExecutorStats::onError() noexcept { addSingleWriter(errors_, 1); }
+
+ExecutorStatsSnapshot ExecutorStats::snapshot() const noexcept
+{
+    ExecutorStatsSnapshot result;
+    result.iterations_ = iterations_.load(std::memory_order_relaxed);
+    result.timeouts_ = timeouts_.load(std::memory_order_relaxed);
+    result.errors_ = errors_.load(std::memory_order_relaxed);
+    result.waitTime_ = waitTime_.snapshot();
+    result.readyCount_ = readyCount_.snapshot();
+    result.dispatchTime_ = dispatchTime_.snapshot();
+    result.handlerTime_ = handlerTime_.snapshot();
+    return result;
+}
+
+uint64_t ExecutorStats::elapsedNs(const ClockT::time_point aStart,
+                                  const ClockT::time_point aEnd) noexcept
+{
+    const auto ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(aEnd - aStart)
+            .count();
+    return (ns > 0) ? static_cast<uint64_t>(ns) : 0;
+}
+}  // namespace ndt
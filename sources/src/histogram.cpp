@@ -0,0 +1,127 @@
+#include "ndt/histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace ndt
+{
+namespace
+{
+std::size_t highestBit(const uint64_t aValue) noexcept
+{
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanReverse64(&index, aValue);
+    return static_cast<std::size_t>(index);
+#else
+    return static_cast<std::size_t>(63 - __builtin_clzll(aValue));
+#endif
+}
+}  // namespace
+
+std::size_t HistogramSnapshot::bucketIndex(const uint64_t aValue) noexcept
+{
+    if (aValue < kSubBucketCount)
+    {
+        return static_cast<std::size_t>(aValue);
+    }
+    const std::size_t shift = highestBit(aValue) - kSubBucketBits;
+    const auto subBucket =
+        static_cast<std::size_t>(aValue >> shift) & (kSubBucketCount - 1);
+    return (shift + 1) * kSubBucketCount + subBucket;
+}
+
+uint64_t HistogramSnapshot::bucketLowerBound(const std::size_t aIndex) noexcept
+{
+    if (aIndex < kSubBucketCount)
+    {
+        return aIndex;
+    }
+    const std::size_t shift = aIndex / kSubBucketCount - 1;
+    const uint64_t mantissa = kSubBucketCount + aIndex % kSubBucketCount;
+    return mantissa << shift;
+}
+
+uint64_t HistogramSnapshot::bucketUpperBound(const std::size_t aIndex) noexcept
+{
+    if (aIndex + 1 >= kBucketCount)
+    {
+        return UINT64_MAX;
+    }
+    return bucketLowerBound(aIndex + 1) - 1;
+}
+
+uint64_t HistogramSnapshot::count() const noexcept { return count_; }
+
+uint64_t HistogramSnapshot::sum() const noexcept { return sum_; }
+
+uint64_t HistogramSnapshot::max() const noexcept { return max_; }
+
+uint64_t HistogramSnapshot::mean() const noexcept
+{
+    return count_ ? sum_ / count_ : 0;
+}
+
+uint64_t HistogramSnapshot::valueAtPercentile(
+    const double aPercentile) const noexcept
+{
+    if (!count_)
+    {
+        return 0;
+    }
+    const double clamped = std::min(std::max(aPercentile, 0.0), 100.0);
+    const auto rank = std::max<uint64_t>(
+        static_cast<uint64_t>(
+            std::ceil(clamped / 100.0 * static_cast<double>(count_))),
+        1);
+    uint64_t seen = 0;
+    for (std::size_t i = 0; i < kBucketCount; ++i)
+    {
+        seen += buckets_[i];
+        if (seen >= rank)
+        {
+            // never report more than the largest recorded value
+            return std::min(bucketUpperBound(i), max_);
+        }
+    }
+    return max_;
+}
+
+uint64_t HistogramSnapshot::bucket(const std::size_t aIndex) const noexcept
+{
+    return buckets_[aIndex];
+}
+
+Histogram::~Histogram() = default;
+
+Histogram::Histogram() noexcept = default;
+
+void Histogram::record(const uint64_t aValue) noexcept
+{
+    addSingleWriter(buckets_[HistogramSnapshot::bucketIndex(aValue)], 1);
+    addSingleWriter(sum_, aValue);
+    if (aValue > max_.load(std::memory_order_relaxed))
+    {
+        max_.store(aValue, std::memory_order_relaxed);
+    }
+}
+
+HistogramSnapshot Histogram::snapshot() const noexcept
+{
+    HistogramSnapshot result;
+    for (std::size_t i = 0; i < HistogramSnapshot::kBucketCount; ++i)
+    {
+        result.buckets_[i] = buckets_[i].load(std::memory_order_relaxed);
+        result.count_ += result.buckets_[i];
+    }
+    // count is derived from buckets, so percentiles are consistent even if
+    // values are recorded while snapshot is taken
+    result.sum_ = sum_.load(std::memory_order_relaxed);
+    result.max_ = max_.load(std::memory_order_relaxed);
+    return result;
+}
+}  // namespace ndt
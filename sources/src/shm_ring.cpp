@@ -0,0 +1,195 @@
+#include "ndt/shm_ring.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "ndt/common.h"
+
+#if defined(__linux__)
+namespace ndt
+{
+ShmRing ShmRing::Create(const uint32_t aSlotCount,
+                        const uint32_t aSlotSize) noexcept
+{
+    return ShmRing(true, aSlotCount, aSlotSize, Handles{});
+}
+
+ShmRing ShmRing::Attach(const Handles &aHandles) noexcept
+{
+    // sizes are read from segment when socket is opened
+    return ShmRing(false, 0, 0, aHandles);
+}
+
+ShmRing::ShmRing(const bool aIsCreator, const uint32_t aSlotCount,
+                 const uint32_t aSlotSize, const Handles &aHandles) noexcept
+    : _isCreator(aIsCreator)
+    , _slotCount(aSlotCount)
+    , _slotSize(aSlotSize)
+    , _handles(aHandles)
+{
+}
+
+bool ShmRing::isCreator() const noexcept { return _isCreator; }
+
+uint32_t ShmRing::slotCount() const noexcept { return _slotCount; }
+
+uint32_t ShmRing::slotSize() const noexcept { return _slotSize; }
+
+const ShmRing::Handles &ShmRing::handles() const noexcept { return _handles; }
+
+bool operator==(const ShmRing &aVal1, const ShmRing &aVal2)
+{
+    return (aVal1._isCreator == aVal2._isCreator) &&
+           (aVal1._slotCount == aVal2._slotCount) &&
+           (aVal1._slotSize == aVal2._slotSize) &&
+           (aVal1._handles.memory_ == aVal2._handles.memory_) &&
+           (aVal1._handles.creatorWakeup_ == aVal2._handles.creatorWakeup_) &&
+           (aVal1._handles.attacherWakeup_ == aVal2._handles.attacherWakeup_);
+}
+
+bool operator!=(const ShmRing &aVal1, const ShmRing &aVal2)
+{
+    return !(aVal1 == aVal2);
+}
+
+namespace details
+{
+ShmRingView::ShmRingView(ShmRingSegment *aSegment,
+                         const std::size_t aIndex) noexcept
+    : queue_(&aSegment->queues_[aIndex])
+    , stride_(slotStride(aSegment->slotSize_))
+    , mask_(aSegment->slotCount_ - 1)
+    , slotSize_(aSegment->slotSize_)
+{
+    slots_ = reinterpret_cast<char *>(aSegment + 1) +
+             aIndex * stride_ * aSegment->slotCount_;
+}
+
+std::size_t ShmRingView::slotStride(const uint32_t aSlotSize) noexcept
+{
+    const std::size_t size = sizeof(ShmRingSlot) + aSlotSize;
+    return (size + kShmCacheLineSize - 1) & ~(kShmCacheLineSize - 1);
+}
+
+std::size_t ShmRingView::segmentSize(const uint32_t aSlotCount,
+                                     const uint32_t aSlotSize) noexcept
+{
+    return sizeof(ShmRingSegment) +
+           2 * static_cast<std::size_t>(aSlotCount) * slotStride(aSlotSize);
+}
+
+ShmRingSegment *ShmRingView::init(void *aMemory, const uint32_t aSlotCount,
+                                  const uint32_t aSlotSize) noexcept
+{
+    auto *segment = new (aMemory) ShmRingSegment();
+    segment->magic_ = ShmRingSegment::kMagic;
+    segment->slotCount_ = aSlotCount;
+    segment->slotSize_ = aSlotSize;
+    for (std::size_t i = 0; i < 2; ++i)
+    {
+        ShmRingQueue &queue = segment->queues_[i];
+        queue.enqueuePos_.store(0, std::memory_order_relaxed);
+        queue.dequeuePos_.store(0, std::memory_order_relaxed);
+        // consumer is idle until it reads, so the first message wakes it
+        queue.isConsumerWaiting_.store(1, std::memory_order_relaxed);
+        ShmRingView view(segment, i);
+        for (uint64_t pos = 0; pos < aSlotCount; ++pos)
+        {
+            auto *s = new (view.slot(pos)) ShmRingSlot();
+            s->sequence_.store(pos, std::memory_order_relaxed);
+            s->size_ = 0;
+        }
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    return segment;
+}
+
+bool ShmRingView::push(CBuffer aData) noexcept
+{
+    uint64_t pos = queue_->enqueuePos_.load(std::memory_order_relaxed);
+    ShmRingSlot *s = nullptr;
+    for (;;)
+    {
+        s = slot(pos);
+        const uint64_t seq = s->sequence_.load(std::memory_order_acquire);
+        const auto diff = static_cast<int64_t>(seq - pos);
+        if (diff == 0)
+        {
+            if (queue_->enqueuePos_.compare_exchange_weak(
+                    pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            return false;
+        }
+        else
+        {
+            pos = queue_->enqueuePos_.load(std::memory_order_relaxed);
+        }
+    }
+    s->size_ = static_cast<uint32_t>(aData.size());
+    std::memcpy(reinterpret_cast<char *>(s + 1), aData.data(), aData.size());
+    s->sequence_.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool ShmRingView::pop(Buffer &aBuf) noexcept
+{
+    uint64_t pos = queue_->dequeuePos_.load(std::memory_order_relaxed);
+    ShmRingSlot *s = nullptr;
+    for (;;)
+    {
+        s = slot(pos);
+        const uint64_t seq = s->sequence_.load(std::memory_order_acquire);
+        const auto diff = static_cast<int64_t>(seq - (pos + 1));
+        if (diff == 0)
+        {
+            if (queue_->dequeuePos_.compare_exchange_weak(
+                    pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            return false;
+        }
+        else
+        {
+            pos = queue_->dequeuePos_.load(std::memory_order_relaxed);
+        }
+    }
+    // size is written by other process, it must not lead out of the slot
+    const std::size_t size =
+        std::min<std::size_t>({s->size_, slotSize_, aBuf.size()});
+    std::memcpy(aBuf.data(), reinterpret_cast<char const *>(s + 1), size);
+    aBuf = Buffer(aBuf.data(), size);
+    s->sequence_.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+}
+
+bool ShmRingView::takeWaiting() noexcept
+{
+    if (queue_->isConsumerWaiting_.load(std::memory_order_relaxed) == 0)
+    {
+        return false;
+    }
+    return queue_->isConsumerWaiting_.exchange(0, std::memory_order_acq_rel) !=
+           0;
+}
+
+void ShmRingView::setWaiting() noexcept
+{
+    queue_->isConsumerWaiting_.store(1, std::memory_order_relaxed);
+}
+
+ShmRingSlot *ShmRingView::slot(const uint64_t aPos) noexcept
+{
+    return reinterpret_cast<ShmRingSlot *>(slots_ + (aPos & mask_) * stride_);
+}
+}  // namespace details
+}  // namespace ndt
+#endif
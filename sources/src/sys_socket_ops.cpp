@@ -1,5 +1,9 @@
 #include "ndt/sys_socket_ops.h"
 
+#if defined(NDT_HAS_IO_URING)
+#include <sys/syscall.h>
+#endif
+
 namespace ndt
 {
 int SysSocketOps::bind(sock_t sockfd, const struct sockaddr *addr,
@@ -22,12 +26,46 @@ sdlen_t SysSocketOps::sendto(sock_t sockfd, ndt::cbufp_t buf, ndt::dlen_t len,
     return ::sendto(sockfd, buf, len, flags, dest_addr, addrlen);
 }
 
+int SysSocketOps::connect(sock_t sockfd, const struct sockaddr *addr,
+                          ndt::salen_t addrlen) noexcept
+{
+    return ::connect(sockfd, addr, addrlen);
+}
+
+sdlen_t SysSocketOps::send(sock_t sockfd, ndt::cbufp_t buf, ndt::dlen_t len,
+                           int flags) noexcept
+{
+    return ::send(sockfd, buf, len, flags);
+}
+
+sdlen_t SysSocketOps::recv(sock_t sockfd, ndt::bufp_t buf, ndt::dlen_t len,
+                           int flags) noexcept
+{
+    return ::recv(sockfd, buf, len, flags);
+}
+
 sock_t SysSocketOps::socket(int socket_family, int socket_type,
                             int protocol) noexcept
 {
     return ::socket(socket_family, socket_type, protocol);
 }
 
+int SysSocketOps::listen(sock_t sockfd, int backlog) noexcept
+{
+    return ::listen(sockfd, backlog);
+}
+
+sock_t SysSocketOps::accept(sock_t sockfd, struct sockaddr *addr,
+                            ndt::salen_t *addrlen) noexcept
+{
+    return ::accept(sockfd, addr, addrlen);
+}
+
+int SysSocketOps::shutdown(sock_t sockfd, int how) noexcept
+{
+    return ::shutdown(sockfd, how);
+}
+
 int SysSocketOps::close(sock_t fd) noexcept { return ndt::socketcloser(fd); }
 
 const char *SysSocketOps::inet_ntop(int af, const void *src, char *dst,
@@ -41,6 +79,34 @@ int SysSocketOps::inet_pton(int af, const char *src, void *dst) noexcept
     return ::inet_pton(af, src, dst);
 }
 
+int SysSocketOps::setsockopt(sock_t sockfd, int level, int optname,
+                             const void *optval, salen_t optlen) noexcept
+{
+#if _WIN32
+    return ::setsockopt(sockfd, level, optname,
+                        static_cast<const char *>(optval), optlen);
+#else
+    return ::setsockopt(sockfd, level, optname, optval, optlen);
+#endif
+}
+
+int SysSocketOps::getsockopt(sock_t sockfd, int level, int optname,
+                             void *optval, salen_t *optlen) noexcept
+{
+#if _WIN32
+    return ::getsockopt(sockfd, level, optname, static_cast<char *>(optval),
+                        optlen);
+#else
+    return ::getsockopt(sockfd, level, optname, optval, optlen);
+#endif
+}
+
+int SysSocketOps::getsockname(sock_t sockfd, struct sockaddr *addr,
+                              salen_t *addrlen) noexcept
+{
+    return ::getsockname(sockfd, addr, addrlen);
+}
+
 int SysSocketOps::select(int nfds, fd_set *readfds, fd_set *writefds,
                          fd_set *exceptfds, struct timeval *timeout) noexcept
 {
@@ -66,5 +132,116 @@ int SysSocketOps::fcntl(sock_t s, int cmd, int arg) noexcept
 {
     return ::fcntl(s, cmd, arg);
 }
+
+int SysSocketOps::pipe(int pipefd[2]) noexcept { return ::pipe(pipefd); }
+
+sdlen_t SysSocketOps::read(int fd, bufp_t buf, dlen_t count) noexcept
+{
+    return ::read(fd, buf, count);
+}
+
+sdlen_t SysSocketOps::write(int fd, cbufp_t buf, dlen_t count) noexcept
+{
+    return ::write(fd, buf, count);
+}
+
+sdlen_t SysSocketOps::sendmsg(sock_t sockfd, const struct msghdr *msg,
+                              int flags) noexcept
+{
+    return ::sendmsg(sockfd, msg, flags);
+}
+
+sdlen_t SysSocketOps::recvmsg(sock_t sockfd, struct msghdr *msg,
+                              int flags) noexcept
+{
+    return ::recvmsg(sockfd, msg, flags);
+}
+#endif
+
+#if defined(__linux__)
+int SysSocketOps::recvmmsg(sock_t sockfd, struct mmsghdr *msgvec,
+                           unsigned int vlen, int flags,
+                           struct timespec *timeout) noexcept
+{
+    return ::recvmmsg(sockfd, msgvec, vlen, flags, timeout);
+}
+
+int SysSocketOps::sendmmsg(sock_t sockfd, struct mmsghdr *msgvec,
+                           unsigned int vlen, int flags) noexcept
+{
+    return ::sendmmsg(sockfd, msgvec, vlen, flags);
+}
+
+int SysSocketOps::epoll_create1(int flags) noexcept
+{
+    return ::epoll_create1(flags);
+}
+
+int SysSocketOps::epoll_ctl(int epfd, int op, sock_t fd,
+                            struct epoll_event *event) noexcept
+{
+    return ::epoll_ctl(epfd, op, fd, event);
+}
+
+int SysSocketOps::epoll_wait(int epfd, struct epoll_event *events,
+                             int maxevents, int timeout) noexcept
+{
+    return ::epoll_wait(epfd, events, maxevents, timeout);
+}
+
+int SysSocketOps::eventfd(unsigned int initval, int flags) noexcept
+{
+    return ::eventfd(initval, flags);
+}
+
+int SysSocketOps::memfd_create(const char *name, unsigned int flags) noexcept
+{
+    return ::memfd_create(name, flags);
+}
+
+int SysSocketOps::ftruncate(int fd, off_t length) noexcept
+{
+    return ::ftruncate(fd, length);
+}
+
+int SysSocketOps::fstat(int fd, struct stat *statbuf) noexcept
+{
+    return ::fstat(fd, statbuf);
+}
+
+void *SysSocketOps::mmap(void *addr, std::size_t length, int prot, int flags,
+                         int fd, off_t offset) noexcept
+{
+    return ::mmap(addr, length, prot, flags, fd, offset);
+}
+
+int SysSocketOps::munmap(void *addr, std::size_t length) noexcept
+{
+    return ::munmap(addr, length);
+}
+#endif
+
+#if defined(NDT_HAS_IO_URING)
+// glibc has no wrappers for io_uring system calls
+int SysSocketOps::io_uring_setup(unsigned entries,
+                                 struct io_uring_params *p) noexcept
+{
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, p));
+}
+
+int SysSocketOps::io_uring_enter(int fd, unsigned to_submit,
+                                 unsigned min_complete, unsigned flags,
+                                 const void *arg, std::size_t argsz) noexcept
+{
+    return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit,
+                                      min_complete, flags, arg, argsz));
+}
+
+int SysSocketOps::io_uring_register(int fd, unsigned opcode, void *arg,
+                                    unsigned nr_args) noexcept
+{
+    return static_cast<int>(
+        ::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
 #endif
 }  // namespace ndt
\ No newline at end of file
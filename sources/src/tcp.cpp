@@ -0,0 +1,46 @@
+#include "ndt/tcp.h"
+#include "ndt/common.h"
+
+namespace ndt
+{
+TCP TCP::V4() noexcept { return TCP(eAddressFamily::kIPv4); }
+
+TCP TCP::V6() noexcept { return TCP(eAddressFamily::kIPv6); }
+
+TCP TCP::DualStack() noexcept { return TCP(eAddressFamily::kIPv6, true); }
+
+eAddressFamily TCP::getFamily() const noexcept
+{
+    return (_af == AF_INET) ? eAddressFamily::kIPv4 : eAddressFamily::kIPv6;
+}
+
+eSocketType TCP::getSocketType() const noexcept { return eSocketType::kStream; }
+
+eIPProtocol TCP::getProtocol() const noexcept { return eIPProtocol::kTCP; }
+
+bool operator==(const TCP& aVal1, const TCP& aVal2)
+{
+    return (aVal1._af == aVal2._af) &&
+           (aVal1._isDualStack == aVal2._isDualStack);
+}
+
+bool operator!=(const TCP& aVal1, const TCP& aVal2)
+{
+    return !(aVal1 == aVal2);
+}
+
+TCP::TCP(const eAddressFamily aAF, const bool aIsDualStack) noexcept
+    : _af((aAF == eAddressFamily::kIPv4) ? AF_INET : AF_INET6)
+    , _isDualStack(aIsDualStack)
+{
+}
+
+uint8_t TCP::sysFamily() const noexcept { return _af; }
+
+int TCP::sysSocketType() const noexcept { return SOCK_STREAM; }
+
+int TCP::sysProtocol() const noexcept { return IPPROTO_TCP; }
+
+bool TCP::isDualStack() const noexcept { return _isDualStack; }
+
+}  // namespace ndt
@@ -0,0 +1,337 @@
+#include "ndt/timer_wheel.h"
+
+#include <cassert>
+#include <utility>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace ndt
+{
+namespace
+{
+constexpr std::size_t kBitsPerWord = 64;
+
+std::size_t lowestBit(const uint64_t aWord) noexcept
+{
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanForward64(&index, aWord);
+    return static_cast<std::size_t>(index);
+#else
+    return static_cast<std::size_t>(__builtin_ctzll(aWord));
+#endif
+}
+
+// index of the first set bit greater than aPos or aBits.size() * 64
+template <std::size_t N>
+std::size_t firstSetAfter(const std::array<uint64_t, N> &aBits,
+                          const std::size_t aPos) noexcept
+{
+    std::size_t wordIndex = (aPos + 1) / kBitsPerWord;
+    if (wordIndex >= N)
+    {
+        return N * kBitsPerWord;
+    }
+    const std::size_t bitIndex = (aPos + 1) % kBitsPerWord;
+    uint64_t word = aBits[wordIndex] & (~uint64_t{0} << bitIndex);
+    while (!word)
+    {
+        if (++wordIndex == N)
+        {
+            return N * kBitsPerWord;
+        }
+        word = aBits[wordIndex];
+    }
+    return wordIndex * kBitsPerWord + lowestBit(word);
+}
+
+void initList(TimerLink &aHead) noexcept
+{
+    aHead.prev_ = &aHead;
+    aHead.next_ = &aHead;
+}
+
+bool isEmptyList(const TimerLink &aHead) noexcept
+{
+    return aHead.next_ == &aHead;
+}
+}  // namespace
+
+Timer::~Timer()
+{
+    if (wheel_)
+    {
+        wheel_->cancel(*this);
+    }
+}
+
+Timer::Timer() noexcept = default;
+
+Timer::Timer(CallbackT aCallback) : callback_(std::move(aCallback)) {}
+
+void Timer::callback(CallbackT aCallback)
+{
+    assert(!isArmed() && "Error: callback of armed timer can't be changed");
+    callback_ = std::move(aCallback);
+}
+
+bool Timer::isArmed() const noexcept { return wheel_ != nullptr; }
+
+uint64_t Timer::expiry() const noexcept { return expiry_; }
+
+TimerWheel::Level::Level() noexcept
+{
+    for (auto &slot: slots_)
+    {
+        initList(slot);
+    }
+}
+
+TimerWheel::~TimerWheel()
+{
+    // detach timers which outlive the wheel
+    const auto detach = [](TimerLink &aHead) {
+        while (!isEmptyList(aHead))
+        {
+            Timer &t = timer(aHead.next_);
+            aHead.next_ = t.next_;
+            t.prev_ = t.next_ = nullptr;
+            t.wheel_ = nullptr;
+        }
+    };
+    if (levels_)
+    {
+        for (std::size_t level = 0; level < kLevelCount; ++level)
+        {
+            for (auto &slot: levels_[level].slots_)
+            {
+                detach(slot);
+            }
+        }
+    }
+    detach(overflow_);
+}
+
+TimerWheel::TimerWheel() noexcept { initList(overflow_); }
+
+void TimerWheel::schedule(Timer &aTimer, const uint64_t aExpiry)
+{
+    if (!levels_)
+    {
+        levels_ = std::make_unique<Level[]>(kLevelCount);
+    }
+    if (aTimer.wheel_)
+    {
+        aTimer.wheel_->cancel(aTimer);
+    }
+    aTimer.expiry_ = (aExpiry > now_) ? aExpiry : now_ + 1;
+    aTimer.wheel_ = this;
+    link(aTimer);
+    ++size_;
+}
+
+void TimerWheel::cancel(Timer &aTimer) noexcept
+{
+    if (aTimer.wheel_ != this)
+    {
+        return;
+    }
+    unlink(aTimer);
+    aTimer.wheel_ = nullptr;
+    --size_;
+}
+
+std::size_t TimerWheel::advance(const uint64_t aNow)
+{
+    std::size_t firedCount = 0;
+    while (now_ < aNow)
+    {
+        // ticks without expiries or cascades are skipped, so the cost
+        // doesn't depend on how long wheel wasn't advanced
+        const uint64_t next = nextExpiry();
+        if (next > aNow)
+        {
+            now_ = aNow;
+            break;
+        }
+        now_ = next;
+
+        // higher levels are cascaded first, their timers may land in lower
+        // levels' slots which are cascaded next
+        if (!(now_ & ((uint64_t{1} << (kLevelCount * kLevelBits)) - 1)))
+        {
+            relinkOverflow();
+        }
+        for (std::size_t level = kLevelCount - 1; level > 0; --level)
+        {
+            const uint64_t lowerMask =
+                (uint64_t{1} << (level * kLevelBits)) - 1;
+            if (!(now_ & lowerMask))
+            {
+                cascade(level);
+            }
+        }
+
+        TimerLink &slot = levels_[0].slots_[now_ & (kSlotCount - 1)];
+        while (!isEmptyList(slot))
+        {
+            Timer &t = timer(slot.next_);
+            cancel(t);
+            ++firedCount;
+            if (t.callback_)
+            {
+                // timer isn't touched after callback, it may be re-armed or
+                // released to pool there
+                t.callback_();
+            }
+        }
+    }
+    return firedCount;
+}
+
+uint64_t TimerWheel::now() const noexcept { return now_; }
+
+std::size_t TimerWheel::size() const noexcept { return size_; }
+
+bool TimerWheel::empty() const noexcept { return size_ == 0; }
+
+uint64_t TimerWheel::nextExpiry() const noexcept
+{
+    if (!size_)
+    {
+        return kNever;
+    }
+    for (std::size_t level = 0; level < kLevelCount; ++level)
+    {
+        const std::size_t shift = level * kLevelBits;
+        const auto current =
+            static_cast<std::size_t>((now_ >> shift) & (kSlotCount - 1));
+        const std::size_t slot =
+            firstSetAfter(levels_[level].occupied_, current);
+        if (slot < kSlotCount)
+        {
+            const std::size_t upperShift = shift + kLevelBits;
+            return ((now_ >> upperShift) << upperShift) |
+                   (static_cast<uint64_t>(slot) << shift);
+        }
+    }
+    // only overflow timers left, they are relinked when all levels wrap
+    const std::size_t wheelBits = kLevelCount * kLevelBits;
+    return ((now_ >> wheelBits) + 1) << wheelBits;
+}
+
+void TimerWheel::link(Timer &aTimer)
+{
+    // timer goes to the lowest level where expiry and current time share
+    // all higher bits, slot is expiry's digit of that level
+    TimerLink *head = &overflow_;
+    aTimer.level_ = kOverflowLevel;
+    for (std::size_t level = 0; level < kLevelCount; ++level)
+    {
+        const std::size_t upperShift = (level + 1) * kLevelBits;
+        if ((aTimer.expiry_ >> upperShift) == (now_ >> upperShift))
+        {
+            const auto slot = static_cast<uint8_t>(
+                (aTimer.expiry_ >> (level * kLevelBits)) & (kSlotCount - 1));
+            aTimer.level_ = static_cast<uint8_t>(level);
+            aTimer.slot_ = slot;
+            head = &levels_[level].slots_[slot];
+            levels_[level].occupied_[slot / kBitsPerWord] |=
+                uint64_t{1} << (slot % kBitsPerWord);
+            break;
+        }
+    }
+    aTimer.prev_ = head->prev_;
+    aTimer.next_ = head;
+    head->prev_->next_ = &aTimer;
+    head->prev_ = &aTimer;
+}
+
+void TimerWheel::unlink(Timer &aTimer) noexcept
+{
+    aTimer.prev_->next_ = aTimer.next_;
+    aTimer.next_->prev_ = aTimer.prev_;
+    aTimer.prev_ = aTimer.next_ = nullptr;
+    if (aTimer.level_ != kOverflowLevel)
+    {
+        Level &level = levels_[aTimer.level_];
+        if (isEmptyList(level.slots_[aTimer.slot_]))
+        {
+            level.occupied_[aTimer.slot_ / kBitsPerWord] &=
+                ~(uint64_t{1} << (aTimer.slot_ % kBitsPerWord));
+        }
+    }
+}
+
+void TimerWheel::cascade(const std::size_t aLevel)
+{
+    const auto slot = static_cast<std::size_t>(
+        (now_ >> (aLevel * kLevelBits)) & (kSlotCount - 1));
+    TimerLink &head = levels_[aLevel].slots_[slot];
+    while (!isEmptyList(head))
+    {
+        Timer &t = timer(head.next_);
+        unlink(t);
+        link(t);
+    }
+}
+
+void TimerWheel::relinkOverflow()
+{
+    // timers are appended to the end of the list, so stop at the last one
+    // present before relinking
+    TimerLink *last = overflow_.prev_;
+    bool isLast = isEmptyList(overflow_);
+    while (!isLast)
+    {
+        Timer &t = timer(overflow_.next_);
+        isLast = (&t == last);
+        unlink(t);
+        link(t);
+    }
+}
+
+Timer &TimerWheel::timer(TimerLink *aLink) noexcept
+{
+    return static_cast<Timer &>(*aLink);
+}
+
+TimerPool::~TimerPool() = default;
+
+TimerPool::TimerPool() noexcept = default;
+
+Timer &TimerPool::acquire(Timer::CallbackT aCallback)
+{
+    Timer *t = nullptr;
+    if (free_.empty())
+    {
+        t = &timers_.emplace_back();
+        // release must not allocate
+        free_.reserve(timers_.size());
+    }
+    else
+    {
+        t = free_.back();
+        free_.pop_back();
+    }
+    t->callback(std::move(aCallback));
+    return *t;
+}
+
+void TimerPool::release(Timer &aTimer) noexcept
+{
+    if (aTimer.wheel_)
+    {
+        aTimer.wheel_->cancel(aTimer);
+    }
+    // callback is kept until timer is acquired again because release may be
+    // called from the callback itself
+    free_.push_back(&aTimer);
+}
+
+std::size_t TimerPool::capacity() const noexcept { return timers_.size(); }
+
+std::size_t TimerPool::available() const noexcept { return free_.size(); }
+}  // namespace ndt
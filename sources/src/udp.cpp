@@ -7,6 +7,8 @@ UDP UDP::V4() noexcept { return UDP(eAddressFamily::kIPv4); }
 
 UDP UDP::V6() noexcept { return UDP(eAddressFamily::kIPv6); }
 
+UDP UDP::DualStack() noexcept { return UDP(eAddressFamily::kIPv6, true); }
+
 eAddressFamily UDP::getFamily() const noexcept
 {
     return (_af == AF_INET) ? eAddressFamily::kIPv4 : eAddressFamily::kIPv6;
@@ -18,16 +20,18 @@ eIPProtocol UDP::getProtocol() const noexcept { return eIPProtocol::kUDP; }
 
 bool operator==(const UDP& aVal1, const UDP& aVal2)
 {
-    return aVal1._af == aVal2._af;
+    return (aVal1._af == aVal2._af) &&
+           (aVal1._isDualStack == aVal2._isDualStack);
 }
 
 bool operator!=(const UDP& aVal1, const UDP& aVal2)
 {
-    return aVal1._af != aVal2._af;
+    return !(aVal1 == aVal2);
 }
 
-UDP::UDP(const eAddressFamily aAF) noexcept
+UDP::UDP(const eAddressFamily aAF, const bool aIsDualStack) noexcept
     : _af((aAF == eAddressFamily::kIPv4) ? AF_INET : AF_INET6)
+    , _isDualStack(aIsDualStack)
 {
 }
 
@@ -37,4 +41,6 @@ int UDP::sysSocketType() const noexcept { return SOCK_DGRAM; }
 
 int UDP::sysProtocol() const noexcept { return IPPROTO_UDP; }
 
+bool UDP::isDualStack() const noexcept { return _isDualStack; }
+
 }  // namespace ndt
\ No newline at end of file
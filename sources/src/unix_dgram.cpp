@@ -0,0 +1,31 @@
+#include "ndt/unix_dgram.h"
+#include "ndt/common.h"
+
+#if !_WIN32
+namespace ndt
+{
+eAddressFamily UnixDgram::getFamily() const noexcept
+{
+    return eAddressFamily::kUnix;
+}
+
+eSocketType UnixDgram::getSocketType() const noexcept
+{
+    return eSocketType::kDgram;
+}
+
+// AF_UNIX has the only protocol, its number is 0 as IPPROTO_IP
+eIPProtocol UnixDgram::getProtocol() const noexcept { return eIPProtocol::kIP; }
+
+uint8_t UnixDgram::sysFamily() const noexcept { return AF_UNIX; }
+
+int UnixDgram::sysSocketType() const noexcept { return SOCK_DGRAM; }
+
+int UnixDgram::sysProtocol() const noexcept { return 0; }
+
+bool operator==(const UnixDgram&, const UnixDgram&) { return true; }
+
+bool operator!=(const UnixDgram&, const UnixDgram&) { return false; }
+
+}  // namespace ndt
+#endif
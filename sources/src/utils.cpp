@@ -20,12 +20,14 @@ const std::unordered_map<int, eSocketType> SocketTypeSystemToUser = {
 const std::unordered_map<eAddressFamily, uint8_t> AddressFamilyUserToSystem = {
     {eAddressFamily::kUnspec, AF_UNSPEC},
     {eAddressFamily::kIPv4, AF_INET},
-    {eAddressFamily::kIPv6, AF_INET6}};
+    {eAddressFamily::kIPv6, AF_INET6},
+    {eAddressFamily::kUnix, AF_UNIX}};
 
 const std::unordered_map<uint8_t, eAddressFamily> AddressFamilySystemToUser = {
     {AF_UNSPEC, eAddressFamily::kUnspec},
     {AF_INET, eAddressFamily::kIPv4},
-    {AF_INET6, eAddressFamily::kIPv6}};
+    {AF_INET6, eAddressFamily::kIPv6},
+    {AF_UNIX, eAddressFamily::kUnix}};
 
 const std::unordered_map<eIPProtocol, int> IPProtocolUserToSystem = {
     {eIPProtocol::kIP, IPPROTO_IP},
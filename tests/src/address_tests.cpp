@@ -4,6 +4,8 @@
 
 #include <algorithm>
 #include <array>
+#include <cstddef>
+#include <string>
 
 #include "ndt/address.h"
 #include "ndt/bin_rw.h"
@@ -1024,4 +1026,92 @@ TEST(AddressTest, SerializeDeserialize)
 
         ASSERT_EQ(a, b);
     }
-}
\ No newline at end of file
+}
+
+TEST(AddressTest, NormalizeTurnsV4MappedAddressIntoV4)
+{
+    ndt::Address mapped;
+    mapped.ip("::ffff:10.1.2.3");
+    mapped.port(4321);
+    ASSERT_TRUE(mapped.isV4Mapped());
+
+    ndt::Address expected;
+    expected.ip("10.1.2.3");
+    expected.port(4321);
+
+    ndt::Address normalized = mapped;
+    normalized.normalize();
+    ASSERT_FALSE(normalized.isV4Mapped());
+    ASSERT_EQ(normalized, expected);
+
+    normalized.mapToV6();
+    ASSERT_EQ(normalized, mapped);
+}
+
+TEST(AddressTest, NormalizeKeepsOtherAddresses)
+{
+    ndt::Address v6;
+    v6.ip("2001:db8::abcd:0:0:1234");
+    v6.port(11341);
+    ASSERT_FALSE(v6.isV4Mapped());
+    ndt::Address copy = v6;
+    copy.normalize();
+    ASSERT_EQ(copy, v6);
+    copy.mapToV6();
+    ASSERT_EQ(copy, v6);
+
+    ndt::Address v4(ndt::kIPv4Loopback, 1111);
+    ASSERT_FALSE(v4.isV4Mapped());
+    copy = v4;
+    copy.normalize();
+    ASSERT_EQ(copy, v4);
+}
+
+#if !_WIN32
+TEST(AddressTest, UnixPathAddress)
+{
+    ndt::Address a;
+    a.unixPath("/tmp/ndt.sock");
+    ASSERT_EQ(a.addressFamilySys(), AF_UNIX);
+    ASSERT_EQ(a.addressFamily(), ndt::eAddressFamily::kUnix);
+    ASSERT_EQ(a.unixPath(), "/tmp/ndt.sock");
+    ASSERT_FALSE(a.isAbstract());
+    ASSERT_EQ(a.port(), 0);
+    ASSERT_EQ(a.capacity(),
+              offsetof(sockaddr_un, sun_path) + sizeof("/tmp/ndt.sock"));
+
+    ndt::Address b;
+    b.unixPath("/tmp/ndt.sock");
+    ASSERT_EQ(a, b);
+    b.unixPath("/tmp/ndt.sock2");
+    ASSERT_NE(a, b);
+}
+
+TEST(AddressTest, InvalidUnixPathThrow)
+{
+    ndt::Address a;
+    const std::string tooLong(sizeof(sockaddr_un::sun_path), 'a');
+    EXPECT_THROW(a.unixPath(tooLong), ndt::Error);
+    EXPECT_THROW(a.unixPath(""), ndt::Error);
+
+    std::error_code ec;
+    a.unixPath(std::string_view("a\0b", 3), ec);
+    ASSERT_EQ(ec, ndt::eAddressErrorCode::kInvalidUnixPath);
+}
+
+#if defined(__linux__)
+TEST(AddressTest, AbstractUnixAddress)
+{
+    ndt::Address a;
+    a.abstractPath("ndt");
+    ASSERT_TRUE(a.isAbstract());
+    ASSERT_EQ(a.unixPath(), "ndt");
+    // abstract name has no terminating zero
+    ASSERT_EQ(a.capacity(), offsetof(sockaddr_un, sun_path) + 1 + 3);
+
+    ndt::Address path;
+    path.unixPath("ndt");
+    ASSERT_NE(a, path);
+}
+#endif
+#endif
@@ -0,0 +1,142 @@
+#include <fmt/core.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#include "ndt/address.h"
+#include "ndt/context_group.h"
+#include "ndt/event_handler_select.h"
+#include "ndt/udp.h"
+
+namespace
+{
+using GroupT = ndt::ContextGroup<ndt::SocketOps>;
+using ContextT = GroupT::ContextT;
+
+struct Counters
+{
+    std::atomic<std::size_t> received_ = 0;
+    std::atomic<std::size_t> started_ = 0;
+    std::atomic<std::size_t> destroyed_ = 0;
+};
+
+class Reactor
+    : public ndt::HandlerSelect<ndt::UDP::Socket, Reactor, ndt::SocketOps>
+{
+   public:
+    ~Reactor()
+    {
+        socket_.close();
+        ++counters_.destroyed_;
+    }
+
+    Reactor(ContextT &aContext, std::size_t, Counters *aCounters,
+            uint16_t aPort)
+        : HandlerSelect(aContext)
+        , counters_(*aCounters)
+        , socket_(aContext, ndt::UDP::V4())
+    {
+        aContext.executor().setTimeout({0, 10000});
+        socket_.open();
+        socket_.reusePort(true);
+        socket_.bind(aPort);
+        socket_.handler(this);
+        ++counters_.started_;
+    }
+
+    void recvHandlerImpl(ndt::UDP::Socket &, const ndt::Address &,
+                         ndt::CBuffer)
+    {
+        ++counters_.received_;
+    }
+
+   private:
+    Counters &counters_;
+    ndt::UDP::Socket socket_;
+};
+
+class ThrowingReactor
+{
+   public:
+    ThrowingReactor(ContextT &, std::size_t aIndex)
+    {
+        if (aIndex == 1)
+        {
+            throw std::runtime_error("reactor failed");
+        }
+    }
+};
+
+template <typename PredicateT>
+bool waitFor(PredicateT aPredicate)
+{
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!aPredicate())
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+}  // namespace
+
+TEST(ContextGroupTests, ReactorsShareReusedPort)
+{
+    constexpr uint16_t kPort = 34201;
+    constexpr std::size_t kReactorCount = 3;
+    constexpr std::size_t kSenderCount = 8;
+    constexpr std::size_t kDatagramCount = 4;
+    Counters counters;
+    GroupT group(kReactorCount);
+    ASSERT_EQ(group.size(), kReactorCount);
+    group.start<Reactor>(&counters, kPort);
+    ASSERT_TRUE(waitFor([&]() { return counters.started_ == kReactorCount; }));
+
+    // several source ports, so that flows are spread across the sockets
+    ndt::Context<ndt::SocketOps> ctx;
+    for (std::size_t i = 0; i < kSenderCount; ++i)
+    {
+        ndt::UDP::Socket sender(ctx, ndt::UDP::V4());
+        sender.open();
+        const char kData[] = "ndt";
+        for (std::size_t j = 0; j < kDatagramCount; ++j)
+        {
+            sender.sendTo(ndt::Address(ndt::kIPv4Loopback, kPort),
+                          ndt::CBuffer(kData));
+        }
+        sender.close();
+    }
+
+    ASSERT_TRUE(waitFor([&]() {
+        return counters.received_ == kSenderCount * kDatagramCount;
+    }));
+    ASSERT_NO_THROW(group.stop());
+    ASSERT_EQ(counters.destroyed_, kReactorCount);
+}
+
+TEST(ContextGroupTests, StopBeforeReactorsRunIsNotLost)
+{
+    constexpr uint16_t kPort = 34202;
+    Counters counters;
+    GroupT group(2);
+    group.start<Reactor>(&counters, kPort);
+    ASSERT_NO_THROW(group.stop());
+    ASSERT_EQ(counters.started_, counters.destroyed_);
+    ASSERT_FALSE(group.context(0).isRunning());
+}
+
+TEST(ContextGroupTests, ReactorExceptionStopsGroupAndIsRethrown)
+{
+    GroupT group(2);
+    group.start<ThrowingReactor>();
+    ASSERT_THROW(group.join(), std::runtime_error);
+    ASSERT_TRUE(group.isStopRequested());
+}
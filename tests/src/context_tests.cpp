@@ -2,12 +2,40 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <thread>
 #include <vector>
 
+#include "ndt/address.h"
 #include "ndt/context.h"
+#include "ndt/event_handler_select.h"
 #include "ndt/exception.h"
 #include "ndt/thread_pool.h"
+#include "ndt/timer_wheel.h"
+#include "ndt/udp.h"
+
+namespace
+{
+using ContextT = ndt::Context<ndt::SocketOps>;
+
+class CountingHandler
+    : public ndt::HandlerSelect<ndt::UDP::Socket, CountingHandler,
+                                ndt::SocketOps>
+{
+   public:
+    explicit CountingHandler(ContextT &aContext) : HandlerSelect(aContext) {}
+
+    void recvHandlerImpl(ndt::UDP::Socket &, const ndt::Address &,
+                         ndt::CBuffer)
+    {
+        ++receivedCount_;
+    }
+
+    std::size_t receivedCount_ = 0;
+};
+}  // namespace
 
 TEST(ContextTest, MultithreadConstructionDestruction)
 {
@@ -65,4 +93,144 @@ TEST(ContextTest, MultithreadConstructionDestruction)
 
     EXPECT_NO_THROW(action());
     ASSERT_EQ(ndt::Context<ndt::SocketOps>::instanceCount(), 0);
-}
\ No newline at end of file
+}
+
+TEST(ContextTest, PostedHandlerIsCalledByRunningContext)
+{
+    ndt::Context<ndt::SocketOps> ctx;
+    ctx.executor().setTimeoutInfinite();
+    std::atomic<std::thread::id> handlerThread;
+    std::thread poster([&ctx, &handlerThread]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        ctx.post([&ctx, &handlerThread]() {
+            handlerThread = std::this_thread::get_id();
+            ctx.stop();
+        });
+    });
+
+    // would block forever if post didn't interrupt the wait
+    ctx.run();
+    poster.join();
+    ASSERT_EQ(handlerThread.load(), std::this_thread::get_id());
+}
+
+TEST(ContextTest, HandlerPostedBeforeRunIsCalled)
+{
+    ndt::Context<ndt::SocketOps> ctx;
+    ctx.executor().setTimeoutInfinite();
+    std::size_t callCount = 0;
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        ctx.post([&callCount]() { ++callCount; });
+    }
+    ctx.post([&ctx]() { ctx.stop(); });
+
+    ctx.run();
+    ASSERT_EQ(callCount, 3);
+}
+
+TEST(ContextTest, StopFromOtherThreadInterruptsWait)
+{
+    ndt::Context<ndt::SocketOps> ctx;
+    ctx.executor().setTimeoutInfinite();
+    std::size_t timeoutCount = 0;
+    ctx.executor().setTimeoutHandler([&timeoutCount]() { ++timeoutCount; });
+    std::thread stopper([&ctx]() {
+        while (!ctx.isRunning())
+        {
+            std::this_thread::yield();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        ctx.stop();
+    });
+
+    ctx.run();
+    stopper.join();
+    ASSERT_FALSE(ctx.isRunning());
+    ASSERT_EQ(timeoutCount, 0);
+}
+
+TEST(ContextTest, PollDoesNotBlock)
+{
+    ContextT ctx;
+    ctx.executor().setTimeoutInfinite();
+    const auto start = ContextT::ClockT::now();
+    ASSERT_EQ(ctx.poll(), 0);
+    ASSERT_LT(ContextT::ClockT::now() - start, std::chrono::milliseconds(500));
+}
+
+TEST(ContextTest, PollHandlesAtMostMaxEvents)
+{
+    constexpr uint16_t kPort = 34110;
+    constexpr std::size_t kDatagramCount = 3;
+    ContextT ctx;
+    ctx.executor().setTimeoutInfinite();
+    // blocking socket is read once per readiness event
+    ndt::UDP::Socket receiver(ctx, ndt::UDP::V4(), kPort);
+    CountingHandler handler(ctx);
+    receiver.handler(&handler);
+
+    ndt::UDP::Socket sender(ctx, ndt::UDP::V4());
+    sender.open();
+    const char kData[] = "ndt";
+    for (std::size_t i = 0; i < kDatagramCount; ++i)
+    {
+        sender.sendTo(ndt::Address(ndt::kIPv4Loopback, kPort),
+                      ndt::CBuffer(kData));
+    }
+
+    const auto deadline =
+        ContextT::ClockT::now() + std::chrono::milliseconds(500);
+    while ((handler.receivedCount_ < kDatagramCount) &&
+           (ContextT::ClockT::now() < deadline))
+    {
+        const std::size_t before = handler.receivedCount_;
+        ASSERT_LE(ctx.poll(1), 1);
+        ASSERT_LE(handler.receivedCount_ - before, 1);
+    }
+    ASSERT_EQ(handler.receivedCount_, kDatagramCount);
+    sender.close();
+    receiver.close();
+}
+
+TEST(ContextTest, RunOnceWakesUpForTimer)
+{
+    ContextT ctx;
+    ctx.executor().setTimeoutInfinite();
+    bool isFired = false;
+    ndt::Timer timer([&isFired]() { isFired = true; });
+    ctx.schedule(timer, std::chrono::milliseconds(5));
+
+    // wait may end slightly before tick of expiry, but never blocks forever
+    for (std::size_t i = 0; (i < 10) && !isFired; ++i)
+    {
+        ctx.runOnce();
+    }
+    ASSERT_TRUE(isFired);
+}
+
+TEST(ContextTest, RunForReturnsAtDeadline)
+{
+    ContextT ctx;
+    ctx.executor().setTimeoutInfinite();
+    std::size_t postedCount = 0;
+    ctx.post([&postedCount]() { ++postedCount; });
+
+    const auto start = ContextT::ClockT::now();
+    ASSERT_EQ(ctx.runFor(std::chrono::milliseconds(20)), 1);
+    const auto elapsed = ContextT::ClockT::now() - start;
+    ASSERT_GE(elapsed, std::chrono::milliseconds(20));
+    ASSERT_LT(elapsed, std::chrono::milliseconds(500));
+    ASSERT_EQ(postedCount, 1);
+    ASSERT_FALSE(ctx.isRunning());
+}
+
+TEST(ContextTest, RunUntilEndsOnStop)
+{
+    ContextT ctx;
+    ctx.executor().setTimeoutInfinite();
+    ctx.post([&ctx]() { ctx.stop(); });
+    const auto start = ContextT::ClockT::now();
+    ctx.runUntil(start + std::chrono::seconds(10));
+    ASSERT_LT(ContextT::ClockT::now() - start, std::chrono::seconds(1));
+}
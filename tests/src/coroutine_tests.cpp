@@ -0,0 +1,128 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#if defined(NDT_COROUTINES)
+
+#include <cstring>
+#include <string>
+
+#include "ndt/address.h"
+#include "ndt/context.h"
+#include "ndt/coroutine.h"
+#include "ndt/udp.h"
+
+namespace
+{
+using ContextT = ndt::Context<ndt::SocketOps>;
+
+constexpr timeval kTimeout = {1, 0};
+
+ndt::DetachedTask echoServer(ndt::UDP::Socket &aSocket, std::size_t aCount)
+{
+    char data[64];
+    for (std::size_t i = 0; i < aCount; ++i)
+    {
+        ndt::Buffer buf(data);
+        ndt::Address sender;
+        co_await aSocket.asyncRecvFrom(buf, sender);
+        co_await aSocket.asyncSendTo(sender, ndt::CBuffer(buf));
+    }
+}
+
+ndt::DetachedTask client(ContextT &aContext, const uint16_t aServerPort,
+                         std::string &aReply)
+{
+    // socket is owned by coroutine and destroyed right after the reply
+    ndt::UDP::Socket socket(aContext, ndt::UDP::V4());
+    socket.open();
+    socket.nonBlocking(true);
+    const char kRequest[] = "time?";
+    co_await socket.asyncSendTo(ndt::Address(ndt::kIPv4Loopback, aServerPort),
+                                ndt::CBuffer(kRequest));
+    char data[64];
+    ndt::Buffer buf(data);
+    ndt::Address sender;
+    std::error_code ec;
+    const auto size = co_await socket.asyncRecvFrom(buf, sender, ec);
+    if (!ec)
+    {
+        aReply.assign(data, size);
+    }
+    socket.close();
+    aContext.stop();
+}
+}  // namespace
+
+TEST(CoroutineTests, RequestAndReplyAreAwaitedLinearly)
+{
+    constexpr uint16_t kPort = 34112;
+    ContextT ctx;
+    ctx.executor().setTimeout(kTimeout);
+    ctx.executor().setTimeoutHandler([&ctx]() { ctx.stop(); });
+
+    ndt::UDP::Socket server(ctx, ndt::UDP::V4(), kPort);
+    server.nonBlocking(true);
+    echoServer(server, 1);
+    ASSERT_NE(server.handler(), nullptr) << "server must wait for request";
+
+    std::string reply;
+    client(ctx, kPort, reply);
+    ctx.run();
+
+    ASSERT_EQ(reply, std::string("time?", sizeof("time?")));
+    ASSERT_EQ(server.handler(), nullptr) << "server must be finished";
+    server.close();
+}
+
+TEST(CoroutineTests, ReadyDatagramIsReceivedWithoutSuspension)
+{
+    constexpr uint16_t kPort = 34113;
+    ContextT ctx;
+    ndt::UDP::Socket receiver(ctx, ndt::UDP::V4(), kPort);
+    receiver.nonBlocking(true);
+    ndt::UDP::Socket sender(ctx, ndt::UDP::V4());
+    sender.open();
+    const char kData[] = "ndt";
+    sender.sendTo(ndt::Address(ndt::kIPv4Loopback, kPort), ndt::CBuffer(kData));
+
+    bool isReceived = false;
+    [](ndt::UDP::Socket &aSocket, bool &aIsReceived) -> ndt::DetachedTask {
+        char data[64];
+        ndt::Buffer buf(data);
+        ndt::Address from;
+        co_await aSocket.asyncRecvFrom(buf, from);
+        aIsReceived = true;
+    }(receiver, isReceived);
+
+    // datagram may need a moment to get through loopback
+    if (!isReceived)
+    {
+        ASSERT_NE(receiver.handler(), nullptr);
+        ctx.runFor(std::chrono::seconds(1), 1);
+    }
+    ASSERT_TRUE(isReceived);
+    sender.close();
+    receiver.close();
+}
+
+TEST(CoroutineTests, ErrorIsReportedThroughErrorCode)
+{
+    ContextT ctx;
+    ndt::UDP::Socket socket(ctx, ndt::UDP::V4());
+    socket.open();
+    socket.nonBlocking(true);
+    std::error_code result;
+    [](ndt::UDP::Socket &aSocket, std::error_code &aResult)
+        -> ndt::DetachedTask {
+        const char kData[] = "ndt";
+        std::error_code ec;
+        // port 0 is not a valid destination
+        co_await aSocket.asyncSendTo(ndt::Address(ndt::kIPv4Loopback, 0),
+                                     ndt::CBuffer(kData), ec);
+        aResult = ec;
+    }(socket, result);
+    ASSERT_TRUE(result);
+    socket.close();
+}
+
+#endif
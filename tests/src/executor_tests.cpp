@@ -0,0 +1,984 @@
+#include <fmt/core.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ndt/address.h"
+#include "ndt/context.h"
+#include "ndt/event_handler_select.h"
+#include "ndt/udp.h"
+#include "ndt/unix_dgram.h"
+
+namespace
+{
+using ContextT = ndt::Context<ndt::SocketOps>;
+
+class ReadHandler
+    : public ndt::HandlerSelect<ndt::UDP::Socket, ReadHandler, ndt::SocketOps>
+{
+   public:
+    explicit ReadHandler(ContextT &aContext) : HandlerSelect(aContext) {}
+
+    void readHandlerImpl(ndt::UDP::Socket &aSocket)
+    {
+        char data[64];
+        ndt::Buffer buf(data);
+        ndt::Address sender;
+        std::error_code ec;
+        const auto bytesReceived = aSocket.recvFrom(buf, sender, ec);
+        if (!ec)
+        {
+            ++readCount_;
+            lastSize_ = bytesReceived;
+        }
+        context_.stop();
+    }
+
+    std::size_t readCount_ = 0;
+    std::size_t lastSize_ = 0;
+};
+
+class EdgeReadHandler
+    : public ndt::HandlerSelect<ndt::UDP::Socket, EdgeReadHandler,
+                                ndt::SocketOps>
+{
+   public:
+    explicit EdgeReadHandler(ContextT &aContext) : HandlerSelect(aContext) {}
+
+    bool edgeReadHandlerImpl(ndt::UDP::Socket &aSocket)
+    {
+        char data[64];
+        ndt::Buffer buf(data);
+        ndt::Address sender;
+        std::error_code ec;
+        aSocket.recvFrom(buf, sender, ec);
+        if (ec)
+        {
+            wouldBlock_ = (ec == std::errc::operation_would_block);
+            return false;
+        }
+        ++readCount_;
+        return true;
+    }
+
+    std::size_t readCount_ = 0;
+    bool wouldBlock_ = false;
+};
+
+class RecvHandler
+    : public ndt::HandlerSelect<ndt::UDP::Socket, RecvHandler, ndt::SocketOps>
+{
+   public:
+    explicit RecvHandler(ContextT &aContext) : HandlerSelect(aContext) {}
+
+    void recvHandlerImpl(ndt::UDP::Socket &, const ndt::Address &aSender,
+                         ndt::CBuffer aData)
+    {
+        sender_ = aSender;
+        data_.emplace_back(static_cast<char const *>(aData.data()),
+                           aData.size());
+        if (data_.size() == expectedCount_)
+        {
+            context_.stop();
+        }
+    }
+
+    std::size_t expectedCount_ = 1;
+    std::vector<std::string> data_;
+    ndt::Address sender_;
+};
+
+#if !_WIN32
+class UnixRecvHandler
+    : public ndt::HandlerSelect<ndt::UnixDgram::Socket, UnixRecvHandler,
+                                ndt::SocketOps>
+{
+   public:
+    explicit UnixRecvHandler(ContextT &aContext) : HandlerSelect(aContext) {}
+
+    void recvHandlerImpl(ndt::UnixDgram::Socket &, const ndt::Address &aSender,
+                         ndt::CBuffer aData)
+    {
+        sender_ = aSender;
+        data_.assign(static_cast<char const *>(aData.data()), aData.size());
+        context_.stop();
+    }
+
+    std::string data_;
+    ndt::Address sender_;
+};
+#endif
+
+// remembers order in which sockets got their datagrams
+class OrderHandler
+    : public ndt::HandlerSelect<ndt::UDP::Socket, OrderHandler, ndt::SocketOps>
+{
+   public:
+    explicit OrderHandler(ContextT &aContext) : HandlerSelect(aContext) {}
+
+    void recvHandlerImpl(ndt::UDP::Socket &aSocket, const ndt::Address &,
+                         ndt::CBuffer)
+    {
+        order_.push_back(aSocket.nativeHandle());
+    }
+
+    std::vector<ndt::sock_t> order_;
+};
+
+class ReadWriteHandler
+    : public ndt::HandlerSelect<ndt::UDP::Socket, ReadWriteHandler,
+                                ndt::SocketOps>
+{
+   public:
+    explicit ReadWriteHandler(ContextT &aContext) : HandlerSelect(aContext) {}
+
+    void readHandlerImpl(ndt::UDP::Socket &aSocket)
+    {
+        char data[64];
+        ndt::Buffer buf(data);
+        ndt::Address sender;
+        aSocket.recvFrom(buf, sender);
+        ++readCount_;
+    }
+
+    void writeHandlerImpl(ndt::UDP::Socket &aSocket)
+    {
+        ++writeCount_;
+        aSocket.writeInterest(false);
+    }
+
+    std::size_t readCount_ = 0;
+    std::size_t writeCount_ = 0;
+};
+
+// collects buffers of zero-copy sends released by kernel
+class ZeroCopyHandler
+    : public ndt::HandlerSelect<ndt::UDP::Socket, ZeroCopyHandler,
+                                ndt::SocketOps>
+{
+   public:
+    explicit ZeroCopyHandler(ContextT &aContext) : HandlerSelect(aContext) {}
+
+    void readHandlerImpl(ndt::UDP::Socket &aSocket)
+    {
+        char data[64];
+        ndt::Buffer buf(data);
+        ndt::Address sender;
+        std::error_code ec;
+        aSocket.recvFrom(buf, sender, ec);
+        ++readCount_;
+    }
+
+    void exceptionConditionHandlerImpl(ndt::UDP::Socket &aSocket)
+    {
+        aSocket.readZeroCopyCompletions([this](ndt::CBuffer aBuf) {
+            released_.push_back(aBuf.data<char>());
+        });
+        if (!aSocket.zeroCopyPendingCount())
+        {
+            context_.stop();
+        }
+    }
+
+    std::vector<const char *> released_;
+    std::size_t readCount_ = 0;
+};
+
+class ListedHandler;
+
+// wrapper with compile-time handler list, ListedHandler is dispatched
+// statically and UnlistedHandler through function pointers
+struct StaticOps : ndt::SocketOps
+{
+    using HandlersT = ndt::HandlerList<ListedHandler>;
+};
+
+using StaticContextT = ndt::Context<StaticOps>;
+using StaticSocketT = ndt::Socket<ndt::UDP, StaticOps>;
+
+template <typename ActualHandlerT>
+class CountingHandler
+    : public ndt::HandlerSelect<StaticSocketT, ActualHandlerT, StaticOps>
+{
+   public:
+    CountingHandler(StaticContextT &aContext, std::size_t &aTotalCount)
+        : ndt::HandlerSelect<StaticSocketT, ActualHandlerT, StaticOps>(
+              aContext)
+        , totalCount_(aTotalCount)
+    {
+    }
+
+    void recvHandlerImpl(StaticSocketT &, const ndt::Address &, ndt::CBuffer)
+    {
+        ++count_;
+        if (++totalCount_ == 2)
+        {
+            this->context_.stop();
+        }
+    }
+
+    std::size_t count_ = 0;
+
+   private:
+    std::size_t &totalCount_;
+};
+
+class ListedHandler : public CountingHandler<ListedHandler>
+{
+    using CountingHandler::CountingHandler;
+};
+
+class UnlistedHandler : public CountingHandler<UnlistedHandler>
+{
+    using CountingHandler::CountingHandler;
+};
+
+static_assert(ndt::handlerIndex<ListedHandler>(StaticOps::HandlersT{}) == 1);
+static_assert(ndt::handlerIndex<UnlistedHandler>(StaticOps::HandlersT{}) ==
+              0);
+
+constexpr timeval kTimeout = {1, 0};
+}  // namespace
+
+TEST(ExecutorTests, ReadHandlerIsCalledForReadySocket)
+{
+    constexpr uint16_t kPort = 34101;
+    ContextT ctx;
+    ctx.executor().setTimeout(kTimeout);
+    ctx.executor().setTimeoutHandler([&ctx]() { ctx.stop(); });
+
+    ndt::UDP::Socket receiver(ctx, ndt::UDP::V4(), kPort);
+    ReadHandler handler(ctx);
+    receiver.handler(&handler);
+
+    ndt::UDP::Socket sender(ctx, ndt::UDP::V4());
+    sender.open();
+    const char kData[] = "ndt";
+    sender.sendTo(ndt::Address(ndt::kIPv4Loopback, kPort), ndt::CBuffer(kData));
+
+    ctx.run();
+
+    ASSERT_EQ(handler.readCount_, 1);
+    ASSERT_EQ(handler.lastSize_, sizeof(kData));
+    sender.close();
+    receiver.close();
+}
+
+TEST(ExecutorTests, TimeoutHandlerIsCalledWhenNothingIsReady)
+{
+    constexpr uint16_t kPort = 34102;
+    ContextT ctx;
+    ctx.executor().setTimeout({0, 1000});
+    std::size_t timeoutCount = 0;
+    ctx.executor().setTimeoutHandler([&ctx, &timeoutCount]() {
+        ++timeoutCount;
+        ctx.stop();
+    });
+
+    ndt::UDP::Socket receiver(ctx, ndt::UDP::V4(), kPort);
+    ReadHandler handler(ctx);
+    receiver.handler(&handler);
+
+    ctx.run();
+
+    ASSERT_EQ(timeoutCount, 1);
+    ASSERT_EQ(handler.readCount_, 0);
+    receiver.close();
+}
+
+TEST(ExecutorTests, DestroyedHandlerIsUnsubscribed)
+{
+    constexpr uint16_t kPort = 34103;
+    ContextT ctx;
+    ctx.executor().setTimeout({0, 1000});
+    ctx.executor().setTimeoutHandler([&ctx]() { ctx.stop(); });
+
+    ndt::UDP::Socket receiver(ctx, ndt::UDP::V4(), kPort);
+    auto handler = std::make_unique<ReadHandler>(ctx);
+    receiver.handler(handler.get());
+    handler = nullptr;
+    ASSERT_EQ(receiver.handler(), nullptr);
+
+    ndt::UDP::Socket sender(ctx, ndt::UDP::V4());
+    sender.open();
+    const char kData[] = "ndt";
+    sender.sendTo(ndt::Address(ndt::kIPv4Loopback, kPort), ndt::CBuffer(kData));
+
+    // must end up with timeout because nobody listens for the socket
+    ASSERT_NO_THROW(ctx.run());
+    sender.close();
+    receiver.close();
+}
+
+TEST(ExecutorTests, DestroyedHandlerIsUnsubscribedFromAllItsSockets)
+{
+    constexpr uint16_t kPort = 34118;
+    constexpr uint16_t kOtherPort = 34119;
+    ContextT ctx;
+    ctx.executor().setTimeout({0, 1000});
+    ctx.executor().setTimeoutHandler([&ctx]() { ctx.stop(); });
+
+    ndt::UDP::Socket first(ctx, ndt::UDP::V4());
+    first.open();
+    ndt::UDP::Socket second(ctx, ndt::UDP::V4());
+    second.open();
+    ndt::UDP::Socket receiver(ctx, ndt::UDP::V4(), kPort);
+    auto handler = std::make_unique<ReadHandler>(ctx);
+    ReadHandler otherHandler(ctx);
+    first.handler(handler.get());
+    receiver.handler(handler.get());
+    second.handler(handler.get());
+    // socket is moved to the list of other handler and back
+    receiver.handler(&otherHandler);
+    receiver.handler(handler.get());
+    ndt::UDP::Socket other(ctx, ndt::UDP::V4(), kOtherPort);
+    other.handler(&otherHandler);
+    handler = nullptr;
+    ASSERT_EQ(first.handler(), nullptr);
+    ASSERT_EQ(second.handler(), nullptr);
+    ASSERT_EQ(receiver.handler(), nullptr);
+    ASSERT_EQ(other.handler(), &otherHandler);
+
+    ndt::UDP::Socket sender(ctx, ndt::UDP::V4());
+    sender.open();
+    const char kData[] = "ndt";
+    sender.sendTo(ndt::Address(ndt::kIPv4Loopback, kPort), ndt::CBuffer(kData));
+    sender.sendTo(ndt::Address(ndt::kIPv4Loopback, kOtherPort),
+                  ndt::CBuffer(kData));
+    ctx.run();
+    ASSERT_EQ(otherHandler.readCount_, 1);
+
+    sender.close();
+    other.close();
+    receiver.close();
+    second.close();
+    first.close();
+}
+
+TEST(ExecutorTests, MovedSocketIsDispatched)
+{
+    constexpr uint16_t kPort = 34120;
+    ContextT ctx;
+    ctx.executor().setTimeout(kTimeout);
+    ctx.executor().setTimeoutHandler([&ctx]() { ctx.stop(); });
+
+    ReadHandler handler(ctx);
+    ndt::UDP::Socket receiver(ctx, ndt::UDP::V4(), kPort);
+    receiver.handler(&handler);
+    ndt::UDP::Socket moved(std::move(receiver));
+    ndt::UDP::Socket assigned(ctx, ndt::UDP::V4());
+    assigned = std::move(moved);
+    ASSERT_EQ(assigned.handler(), &handler);
+
+    ndt::UDP::Socket sender(ctx, ndt::UDP::V4());
+    sender.open();
+    const char kData[] = "ndt";
+    sender.sendTo(ndt::Address(ndt::kIPv4Loopback, kPort), ndt::CBuffer(kData));
+    ctx.run();
+    ASSERT_EQ(handler.readCount_, 1);
+
+    sender.close();
+    assigned.close();
+}
+
+TEST(ExecutorTests, EdgeTriggeredHandlerDrainsSocketWithinBudget)
+{
+    constexpr uint16_t kPort = 34104;
+    constexpr std::size_t kDatagramCount = 5;
+    ContextT ctx;
+    ctx.executor().setTimeout(kTimeout);
+    ctx.executor().setReadBudget(2);
+
+    ndt::UDP::Socket receiver(ctx, ndt::UDP::V4(), kPort);
+    receiver.nonBlocking(true);
+    EdgeReadHandler handler(ctx);
+    receiver.handler(&handler);
+
+    ndt::UDP::Socket sender(ctx, ndt::UDP::V4());
+    sender.open();
+    const char kData[] = "ndt";
+    for (std::size_t i = 0; i < kDatagramCount; ++i)
+    {
+        sender.sendTo(ndt::Address(ndt::kIPv4Loopback, kPort),
+                      ndt::CBuffer(kData));
+    }
+
+    // every iteration serves at most two datagrams, the rest is drained
+    // during subsequent iterations without new readiness notification
+    ctx.executor()();
+    ASSERT_EQ(handler.readCount_, 2);
+    ctx.executor()();
+    ASSERT_EQ(handler.readCount_, 4);
+    ctx.executor()();
+    ASSERT_EQ(handler.readCount_, kDatagramCount);
+    ASSERT_TRUE(handler.wouldBlock_);
+
+    sender.close();
+    receiver.close();
+}
+
+TEST(ExecutorTests, SocketOverBudgetIsDispatchedOncePerIteration)
+{
+    constexpr uint16_t kPort = 34142;
+    constexpr std::size_t kIterationCount = 5;
+    ContextT ctx;
+    ctx.executor().setTimeout(kTimeout);
+    ctx.executor().setReadBudget(2);
+
+    ndt::UDP::Socket receiver(ctx, ndt::UDP::V4(), kPort);
+    receiver.nonBlocking(true);
+    EdgeReadHandler handler(ctx);
+    receiver.handler(&handler);
+
+    ndt::UDP::Socket sender(ctx, ndt::UDP::V4());
+    sender.open();
+    const char kData[] = "ndt";
+    const ndt::Address dst(ndt::kIPv4Loopback, kPort);
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        sender.sendTo(dst, ndt::CBuffer(kData));
+    }
+
+    // new datagrams keep arriving while socket has unread ones, it still
+    // gets a single read budget per iteration
+    for (std::size_t i = 1; i <= kIterationCount; ++i)
+    {
+        ASSERT_EQ(ctx.runOnce(), 1);
+        ASSERT_EQ(handler.readCount_, 2 * i);
+        sender.sendTo(dst, ndt::CBuffer(kData));
+        sender.sendTo(dst, ndt::CBuffer(kData));
+    }
+
+    sender.close();
+    receiver.close();
+}
+
+TEST(ExecutorTests, RecvHandlerGetsDatagramAndSender)
+{
+    constexpr uint16_t kPort = 34105;
+    constexpr uint16_t kSenderPort = 34106;
+    ContextT ctx;
+    ctx.executor().setTimeout(kTimeout);
+    ctx.executor().setTimeoutHandler([&ctx]() { ctx.stop(); });
+
+    ndt::UDP::Socket receiver(ctx, ndt::UDP::V4(), kPort);
+    RecvHandler handler(ctx);
+    receiver.handler(&handler);
+
+    ndt::UDP::Socket sender(ctx, ndt::UDP::V4(), kSenderPort);
+    const char kData[] = "ndt";
+    sender.sendTo(ndt::Address(ndt::kIPv4Loopback, kPort), ndt::CBuffer(kData));
+
+    ctx.run();
+
+    ASSERT_EQ(handler.data_.size(), 1);
+    ASSERT_EQ(handler.data_[0], std::string(kData, sizeof(kData)));
+    ASSERT_EQ(handler.sender_, ndt::Address(ndt::kIPv4Loopback, kSenderPort));
+    sender.close();
+    receiver.close();
+}
+
+#if !_WIN32
+TEST(ExecutorTests, UnixDatagramIsDispatchedToRecvHandler)
+{
+    const std::string prefix =
+        "/tmp/ndt_executor_" + std::to_string(::getpid());
+    const std::string receiverPath = prefix + "_receiver";
+    const std::string senderPath = prefix + "_sender";
+    ::unlink(receiverPath.c_str());
+    ::unlink(senderPath.c_str());
+    ndt::Address receiverAddress;
+    receiverAddress.unixPath(receiverPath);
+    ndt::Address senderAddress;
+    senderAddress.unixPath(senderPath);
+
+    ContextT ctx;
+    ctx.executor().setTimeout(kTimeout);
+    ctx.executor().setTimeoutHandler([&ctx]() { ctx.stop(); });
+
+    ndt::UnixDgram::Socket receiver(ctx, ndt::UnixDgram(), receiverAddress);
+    UnixRecvHandler handler(ctx);
+    receiver.handler(&handler);
+
+    ndt::UnixDgram::Socket sender(ctx, ndt::UnixDgram(), senderAddress);
+    const char kData[] = "ipc";
+    sender.sendTo(receiverAddress, ndt::CBuffer(kData));
+
+    ctx.run();
+
+    ASSERT_EQ(handler.data_, std::string(kData, sizeof(kData)));
+    ASSERT_EQ(handler.sender_.unixPath(), senderPath);
+    ASSERT_EQ(handler.sender_, senderAddress);
+    sender.close();
+    receiver.close();
+    ::unlink(receiverPath.c_str());
+    ::unlink(senderPath.c_str());
+}
+
+TEST(ExecutorTests, DatagramOfUnboundUnixSenderIsDispatched)
+{
+    const std::string receiverPath =
+        "/tmp/ndt_executor_" + std::to_string(::getpid()) + "_unnamed";
+    ::unlink(receiverPath.c_str());
+    ndt::Address receiverAddress;
+    receiverAddress.unixPath(receiverPath);
+
+    ContextT ctx;
+    ctx.executor().setTimeout(kTimeout);
+    ctx.executor().setTimeoutHandler([&ctx]() { ctx.stop(); });
+
+    ndt::UnixDgram::Socket receiver(ctx, ndt::UnixDgram(), receiverAddress);
+    UnixRecvHandler handler(ctx);
+    handler.sender_ = receiverAddress;
+    receiver.handler(&handler);
+
+    // sender without name, kernel reports zero address length for it
+    ndt::UnixDgram::Socket sender(ctx, ndt::UnixDgram());
+    sender.open();
+    const char kData[] = "unnamed";
+    sender.sendTo(receiverAddress, ndt::CBuffer(kData));
+
+    ctx.run();
+
+    ASSERT_EQ(handler.data_, std::string(kData, sizeof(kData)));
+    ASSERT_EQ(handler.sender_, ndt::Address());
+    sender.close();
+    receiver.close();
+    ::unlink(receiverPath.c_str());
+}
+#endif
+
+TEST(ExecutorTests, RecvErrorIsReportedToErrorHandler)
+{
+    constexpr uint16_t kClosedPort = 34143;
+    ContextT ctx;
+    ctx.executor().setTimeout(kTimeout);
+    ctx.executor().setTimeoutHandler([&ctx]() { ctx.stop(); });
+    std::error_code error;
+    ctx.executor().setErrorHandler(
+        [&ctx, &error](std::error_code aEc)
+        {
+            error = aEc;
+            ctx.stop();
+        });
+
+    ndt::UDP::Socket socket(ctx, ndt::UDP::V4());
+    socket.open();
+    socket.connect(ndt::Address(ndt::kIPv4Loopback, kClosedPort));
+    RecvHandler handler(ctx);
+    socket.handler(&handler);
+
+    // nothing listens on the port, ICMP makes connection refused error
+    // pending on the socket
+    const char kData[] = "ndt";
+    socket.send(ndt::CBuffer(kData));
+
+    ctx.run();
+
+    ASSERT_EQ(error, std::errc::connection_refused);
+    ASSERT_TRUE(handler.data_.empty());
+    socket.close();
+}
+
+TEST(ExecutorTests, PostedDatagramsAreDelivered)
+{
+    constexpr uint16_t kPort = 34107;
+    constexpr std::size_t kDatagramCount = 10;
+    ContextT ctx;
+    ctx.executor().setTimeout(kTimeout);
+    ctx.executor().setTimeoutHandler([&ctx]() { ctx.stop(); });
+
+    ndt::UDP::Socket receiver(ctx, ndt::UDP::V4(), kPort);
+    receiver.nonBlocking(true);
+    RecvHandler handler(ctx);
+    handler.expectedCount_ = kDatagramCount;
+    receiver.handler(&handler);
+
+    ndt::UDP::Socket sender(ctx, ndt::UDP::V4());
+    sender.open();
+    for (std::size_t i = 0; i < kDatagramCount; ++i)
+    {
+        // buffer is reused right after the call
+        const std::string data = std::to_string(i);
+        sender.postSendTo(ndt::Address(ndt::kIPv4Loopback, kPort),
+                          ndt::CBuffer(data.data(), data.size()));
+    }
+
+    ctx.run();
+
+    ASSERT_EQ(handler.data_.size(), kDatagramCount);
+    for (std::size_t i = 0; i < kDatagramCount; ++i)
+    {
+        ASSERT_EQ(handler.data_[i], std::to_string(i));
+    }
+    sender.close();
+    receiver.close();
+}
+
+TEST(ExecutorTests, ListedAndUnlistedHandlersAreCalled)
+{
+    constexpr uint16_t kListedPort = 34109;
+    constexpr uint16_t kUnlistedPort = 34111;
+    StaticContextT ctx;
+    ctx.executor().setTimeout(kTimeout);
+    ctx.executor().setTimeoutHandler([&ctx]() { ctx.stop(); });
+
+    std::size_t totalCount = 0;
+    StaticSocketT listedReceiver(ctx, ndt::UDP::V4(), kListedPort);
+    ListedHandler listed(ctx, totalCount);
+    listedReceiver.handler(&listed);
+    StaticSocketT unlistedReceiver(ctx, ndt::UDP::V4(), kUnlistedPort);
+    UnlistedHandler unlisted(ctx, totalCount);
+    unlistedReceiver.handler(&unlisted);
+
+    StaticSocketT sender(ctx, ndt::UDP::V4());
+    sender.open();
+    const char kData[] = "ndt";
+    sender.sendTo(ndt::Address(ndt::kIPv4Loopback, kListedPort),
+                  ndt::CBuffer(kData));
+    sender.sendTo(ndt::Address(ndt::kIPv4Loopback, kUnlistedPort),
+                  ndt::CBuffer(kData));
+
+    ctx.run();
+
+    ASSERT_EQ(listed.count_, 1);
+    ASSERT_EQ(unlisted.count_, 1);
+    sender.close();
+    listedReceiver.close();
+    unlistedReceiver.close();
+}
+
+TEST(ExecutorTests, WriteInterestIsSwitchedAtRuntime)
+{
+    constexpr uint16_t kPort = 34115;
+    ContextT ctx;
+    ctx.executor().setTimeout(kTimeout);
+    ndt::UDP::Socket receiver(ctx, ndt::UDP::V4(), kPort);
+    receiver.writeInterest(false);
+    ReadWriteHandler handler(ctx);
+    receiver.handler(&handler);
+    ASSERT_EQ(ctx.poll(), 0);
+
+    // socket is watched for reading meanwhile
+    receiver.writeInterest(true);
+    ASSERT_EQ(ctx.runOnce(), 1);
+    ASSERT_EQ(handler.writeCount_, 1);
+    ASSERT_FALSE(receiver.writeInterest());
+
+    ndt::UDP::Socket sender(ctx, ndt::UDP::V4());
+    sender.open();
+    const char kData[] = "ndt";
+    sender.sendTo(ndt::Address(ndt::kIPv4Loopback, kPort), ndt::CBuffer(kData));
+    ASSERT_EQ(ctx.runOnce(), 1);
+    ASSERT_EQ(handler.readCount_, 1);
+    ASSERT_EQ(handler.writeCount_, 1);
+
+    sender.close();
+    receiver.close();
+}
+
+TEST(ExecutorTests, ReadingIsPausedAndResumed)
+{
+    constexpr uint16_t kPort = 34116;
+    ContextT ctx;
+    ctx.executor().setTimeout(kTimeout);
+    ndt::UDP::Socket receiver(ctx, ndt::UDP::V4(), kPort);
+    ReadWriteHandler handler(ctx);
+    receiver.interest(ndt::kInterestRead | ndt::kInterestExceptCond);
+    receiver.handler(&handler);
+    receiver.readInterest(false);
+    ASSERT_EQ(receiver.interest(), ndt::kInterestExceptCond);
+
+    ndt::UDP::Socket sender(ctx, ndt::UDP::V4());
+    sender.open();
+    const char kData[] = "ndt";
+    sender.sendTo(ndt::Address(ndt::kIPv4Loopback, kPort), ndt::CBuffer(kData));
+    ASSERT_EQ(ctx.poll(), 0);
+    ASSERT_EQ(handler.readCount_, 0);
+
+    receiver.readInterest(true);
+    ASSERT_EQ(ctx.runOnce(), 1);
+    ASSERT_EQ(handler.readCount_, 1);
+    ASSERT_EQ(handler.writeCount_, 0);
+
+    sender.close();
+    receiver.close();
+}
+
+TEST(ExecutorTests, ReceivingIsPausedAndResumed)
+{
+    constexpr uint16_t kPort = 34117;
+    ContextT ctx;
+    ctx.executor().setTimeout(kTimeout);
+    ctx.executor().setTimeoutHandler([&ctx]() { ctx.stop(); });
+    ndt::UDP::Socket receiver(ctx, ndt::UDP::V4(), kPort);
+    RecvHandler handler(ctx);
+    receiver.handler(&handler);
+    ASSERT_EQ(ctx.poll(), 0);
+    // io_uring executor cancels its recv request
+    receiver.readInterest(false);
+    ASSERT_EQ(ctx.poll(), 0);
+
+    ndt::UDP::Socket sender(ctx, ndt::UDP::V4());
+    sender.open();
+    const char kData[] = "ndt";
+    sender.sendTo(ndt::Address(ndt::kIPv4Loopback, kPort), ndt::CBuffer(kData));
+    ASSERT_EQ(ctx.poll(), 0);
+    ASSERT_TRUE(handler.data_.empty());
+
+    receiver.readInterest(true);
+    ctx.run();
+    ASSERT_EQ(handler.data_.size(), 1);
+    ASSERT_EQ(handler.data_[0], std::string(kData, sizeof(kData)));
+
+    sender.close();
+    receiver.close();
+}
+
+TEST(ExecutorTests, PendingErrorOfPausedSocketDoesNotWakeExecutor)
+{
+    constexpr uint16_t kClosedPort = 34141;
+    constexpr timeval kShortTimeout = {0, 100000};
+    ContextT ctx;
+    ctx.executor().setTimeout(kShortTimeout);
+    ndt::UDP::Socket socket(ctx, ndt::UDP::V4());
+    socket.open();
+    socket.connect(ndt::Address(ndt::kIPv4Loopback, kClosedPort));
+    ReadHandler handler(ctx);
+    socket.interest(ndt::kInterestRead | ndt::kInterestExceptCond);
+    socket.handler(&handler);
+    socket.readInterest(false);
+
+    // nothing listens on the port, ICMP makes connection refused error
+    // pending on the socket
+    const char kData[] = "ndt";
+    socket.send(ndt::CBuffer(kData));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    // error may be reported once, but it must not be reported over and over
+    // while nobody reads it
+    ctx.runOnce();
+    const auto start = std::chrono::steady_clock::now();
+    ASSERT_EQ(ctx.runOnce(), 0);
+    ASSERT_GE(std::chrono::steady_clock::now() - start,
+              std::chrono::milliseconds(50));
+
+    // error is taken by reading once it is resumed
+    socket.readInterest(true);
+    ASSERT_EQ(ctx.runOnce(), 1);
+    ASSERT_EQ(handler.readCount_, 0);
+    socket.close();
+}
+
+TEST(ExecutorTests, HigherPriorityClassIsDispatchedFirst)
+{
+    constexpr uint16_t kBulkPort = 34121;
+    constexpr uint16_t kControlPort = 34122;
+    ContextT ctx;
+    ctx.executor().setTimeout(kTimeout);
+    OrderHandler handler(ctx);
+    ndt::UDP::Socket bulk(ctx, ndt::UDP::V4(), kBulkPort);
+    bulk.handler(&handler);
+    ndt::UDP::Socket control(ctx, ndt::UDP::V4(), kControlPort);
+    control.handler(&handler);
+    control.priority(ndt::ePriority::kHigh);
+    ASSERT_EQ(control.priority(), ndt::ePriority::kHigh);
+    ASSERT_EQ(bulk.priority(), ndt::ePriority::kNormal);
+    ASSERT_EQ(ctx.poll(), 0);
+
+    ndt::UDP::Socket sender(ctx, ndt::UDP::V4());
+    sender.open();
+    const char kData[] = "ndt";
+    sender.sendTo(ndt::Address(ndt::kIPv4Loopback, kBulkPort),
+                  ndt::CBuffer(kData));
+    sender.sendTo(ndt::Address(ndt::kIPv4Loopback, kControlPort),
+                  ndt::CBuffer(kData));
+    ASSERT_EQ(ctx.runOnce(), 2);
+    const std::vector<ndt::sock_t> kOrder = {control.nativeHandle(),
+                                             bulk.nativeHandle()};
+    ASSERT_EQ(handler.order_, kOrder);
+
+    sender.close();
+    control.close();
+    bulk.close();
+}
+
+TEST(ExecutorTests, PriorityLimitDefersEventsOfClass)
+{
+    constexpr uint16_t kFirstPort = 34123;
+    constexpr uint16_t kSecondPort = 34124;
+    constexpr uint16_t kControlPort = 34125;
+    ContextT ctx;
+    ctx.executor().setTimeout(kTimeout);
+    ctx.executor().setPriorityLimit(ndt::ePriority::kLow, 1);
+    ASSERT_EQ(ctx.executor().priorityLimit(ndt::ePriority::kLow), 1);
+    OrderHandler handler(ctx);
+    ndt::UDP::Socket first(ctx, ndt::UDP::V4(), kFirstPort);
+    ndt::UDP::Socket second(ctx, ndt::UDP::V4(), kSecondPort);
+    ndt::UDP::Socket control(ctx, ndt::UDP::V4(), kControlPort);
+    for (ndt::UDP::Socket *socket: {&first, &second})
+    {
+        socket->priority(ndt::ePriority::kLow);
+        socket->handler(&handler);
+    }
+    control.handler(&handler);
+    ASSERT_EQ(ctx.poll(), 0);
+
+    ndt::UDP::Socket sender(ctx, ndt::UDP::V4());
+    sender.open();
+    const char kData[] = "ndt";
+    for (const uint16_t port: {kFirstPort, kSecondPort, kControlPort})
+    {
+        sender.sendTo(ndt::Address(ndt::kIPv4Loopback, port),
+                      ndt::CBuffer(kData));
+    }
+    // the other low class socket is served by the next iteration
+    ASSERT_EQ(ctx.runOnce(), 2);
+    ASSERT_EQ(handler.order_.size(), 2);
+    ASSERT_EQ(handler.order_[0], control.nativeHandle());
+    ASSERT_EQ(ctx.runOnce(), 1);
+    ASSERT_EQ(handler.order_.size(), 3);
+
+    sender.close();
+    control.close();
+    second.close();
+    first.close();
+}
+
+#if defined(MSG_ZEROCOPY) && defined(SO_EE_ORIGIN_ZEROCOPY)
+TEST(ExecutorTests, ZeroCopySendIsCompletedViaExceptionCondition)
+{
+    constexpr uint16_t kPort = 34130;
+    ContextT ctx;
+    ctx.executor().setTimeout(kTimeout);
+    ctx.executor().setTimeoutHandler([&ctx]() { ctx.stop(); });
+
+    ndt::UDP::Socket receiver(ctx, ndt::UDP::V4(), kPort);
+    ndt::UDP::Socket sender(ctx, ndt::UDP::V4());
+    sender.open();
+    sender.nonBlocking(true);
+    sender.zeroCopy(true);
+    if (!sender.zeroCopy())
+    {
+        sender.close();
+        receiver.close();
+        GTEST_SKIP() << "kernel doesn't support zero-copy UDP sends";
+    }
+    ZeroCopyHandler handler(ctx);
+    sender.handler(&handler);
+
+    const ndt::Address dst(ndt::kIPv4Loopback, kPort);
+    const std::vector<char> small(64, 's');
+    const std::vector<char> large(sender.zeroCopyThreshold(), 'l');
+    ASSERT_FALSE(
+        sender.sendToZeroCopy(dst, ndt::CBuffer(small.data(), small.size())));
+    ASSERT_TRUE(
+        sender.sendToZeroCopy(dst, ndt::CBuffer(large.data(), large.size())));
+    ASSERT_EQ(sender.zeroCopyPendingCount(), 1);
+
+    ctx.run();
+
+    ASSERT_EQ(handler.released_.size(), 1);
+    ASSERT_EQ(handler.released_[0], large.data());
+    ASSERT_EQ(sender.zeroCopyPendingCount(), 0);
+#if defined(NDT_EXECUTOR_EPOLL) || defined(NDT_EXECUTOR_IO_URING)
+    // select can't tell error queue from readability
+    ASSERT_EQ(handler.readCount_, 0);
+#endif
+    sender.close();
+    receiver.close();
+}
+#endif
+
+TEST(ExecutorTests, BusyPollModeNeverBlocks)
+{
+    ContextT ctx;
+    ctx.executor().setTimeoutInfinite();
+    ctx.executor().setWaitMode(ndt::eWaitMode::kBusyPoll);
+    ASSERT_EQ(ctx.executor().waitMode(), ndt::eWaitMode::kBusyPoll);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < 100; ++i)
+    {
+        ctx.runOnce();
+    }
+    ASSERT_LT(std::chrono::steady_clock::now() - start,
+              std::chrono::milliseconds(500));
+}
+
+TEST(ExecutorTests, BusyPollModeCallsTimeoutHandlerAfterIdleTimeout)
+{
+    ContextT ctx;
+    ctx.executor().setTimeout({0, 20000});
+    ctx.executor().setWaitMode(ndt::eWaitMode::kBusyPoll);
+    std::size_t timeoutCount = 0;
+    ctx.executor().setTimeoutHandler([&ctx, &timeoutCount]() {
+        ++timeoutCount;
+        ctx.stop();
+    });
+
+    const auto start = std::chrono::steady_clock::now();
+    ctx.run();
+    ASSERT_EQ(timeoutCount, 1);
+    ASSERT_GE(std::chrono::steady_clock::now() - start,
+              std::chrono::milliseconds(20));
+}
+
+TEST(ExecutorTests, AdaptiveModeBlocksAfterIdlePeriods)
+{
+    ContextT ctx;
+    ctx.executor().setTimeout({0, 50000});
+    ctx.executor().setWaitMode(ndt::eWaitMode::kAdaptive);
+    ctx.executor().setAdaptivePeriods(std::chrono::milliseconds(2),
+                                      std::chrono::milliseconds(2));
+    std::size_t timeoutCount = 0;
+    ctx.executor().setTimeoutHandler([&timeoutCount]() { ++timeoutCount; });
+
+    // executor polls for 4ms and then blocks until the timeout
+    std::size_t iterationCount = 0;
+    const auto start = std::chrono::steady_clock::now();
+    while (!timeoutCount)
+    {
+        ctx.runOnce();
+        ++iterationCount;
+    }
+    ASSERT_GT(iterationCount, 1);
+    ASSERT_GE(std::chrono::steady_clock::now() - start,
+              std::chrono::milliseconds(50));
+}
+
+#if defined(NDT_EXECUTOR_STATS)
+TEST(ExecutorTests, StatsCountIterationsAndHandlerCalls)
+{
+    constexpr uint16_t kPort = 34108;
+    ContextT ctx;
+    ctx.executor().setTimeout(kTimeout);
+    ctx.executor().setTimeoutHandler([&ctx]() { ctx.stop(); });
+
+    ndt::UDP::Socket receiver(ctx, ndt::UDP::V4(), kPort);
+    RecvHandler handler(ctx);
+    receiver.handler(&handler);
+
+    ndt::UDP::Socket sender(ctx, ndt::UDP::V4());
+    sender.open();
+    const char kData[] = "ndt";
+    sender.sendTo(ndt::Address(ndt::kIPv4Loopback, kPort), ndt::CBuffer(kData));
+
+    ctx.run();
+
+    const ndt::ExecutorStatsSnapshot stats = ctx.executor().stats();
+    ASSERT_GE(stats.iterations_, 1);
+    ASSERT_EQ(stats.waitTime_.count(), stats.iterations_);
+    ASSERT_EQ(stats.dispatchTime_.count(), stats.iterations_);
+    ASSERT_GE(stats.readyCount_.max(), 1);
+    ASSERT_GE(stats.handlerTime_.count(), 1);
+    ASSERT_EQ(stats.errors_, 0);
+    sender.close();
+    receiver.close();
+}
+#endif
@@ -0,0 +1,59 @@
+#include <fmt/core.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "ndt/histogram.h"
+
+using ndt::HistogramSnapshot;
+
+TEST(HistogramTest, SmallValuesHaveExactBuckets)
+{
+    for (uint64_t v = 0; v < HistogramSnapshot::kSubBucketCount; ++v)
+    {
+        const std::size_t index = HistogramSnapshot::bucketIndex(v);
+        ASSERT_EQ(HistogramSnapshot::bucketLowerBound(index), v);
+        ASSERT_EQ(HistogramSnapshot::bucketUpperBound(index), v);
+    }
+}
+
+TEST(HistogramTest, BucketBoundsContainValue)
+{
+    for (uint64_t v = 1; v < (uint64_t{1} << 62); v = v * 3 + 1)
+    {
+        const std::size_t index = HistogramSnapshot::bucketIndex(v);
+        ASSERT_LT(index, HistogramSnapshot::kBucketCount);
+        ASSERT_LE(HistogramSnapshot::bucketLowerBound(index), v);
+        ASSERT_GE(HistogramSnapshot::bucketUpperBound(index), v);
+        // relative error is bounded by sub-bucket count
+        const uint64_t width = HistogramSnapshot::bucketUpperBound(index) -
+                               HistogramSnapshot::bucketLowerBound(index);
+        ASSERT_LE(width * HistogramSnapshot::kSubBucketCount, v);
+    }
+    const std::size_t last = HistogramSnapshot::bucketIndex(UINT64_MAX);
+    ASSERT_EQ(last, HistogramSnapshot::kBucketCount - 1);
+}
+
+TEST(HistogramTest, SnapshotReportsPercentiles)
+{
+    ndt::Histogram histogram;
+    ASSERT_EQ(histogram.snapshot().valueAtPercentile(50), 0);
+    for (uint64_t v = 1; v <= 1000; ++v)
+    {
+        histogram.record(v);
+    }
+    const HistogramSnapshot snapshot = histogram.snapshot();
+    ASSERT_EQ(snapshot.count(), 1000);
+    ASSERT_EQ(snapshot.sum(), 500500);
+    ASSERT_EQ(snapshot.max(), 1000);
+    ASSERT_EQ(snapshot.mean(), 500);
+    ASSERT_EQ(snapshot.valueAtPercentile(100), 1000);
+
+    const uint64_t median = snapshot.valueAtPercentile(50);
+    ASSERT_GE(median, 500);
+    ASSERT_LE(median, 500 + 500 / HistogramSnapshot::kSubBucketCount);
+    const uint64_t p99 = snapshot.valueAtPercentile(99);
+    ASSERT_GE(p99, 990);
+    ASSERT_LE(p99, 1000);
+}
@@ -0,0 +1,77 @@
+#include <fmt/core.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ndt/mpsc_queue.h"
+
+TEST(MpscQueueTest, PopsInPushOrder)
+{
+    ndt::MpscQueue<int> queue;
+    ASSERT_TRUE(queue.empty());
+    ASSERT_FALSE(queue.pop());
+    for (int i = 0; i < 5; ++i)
+    {
+        queue.push(i);
+    }
+    ASSERT_FALSE(queue.empty());
+    for (int i = 0; i < 5; ++i)
+    {
+        const auto value = queue.pop();
+        ASSERT_TRUE(value);
+        ASSERT_EQ(*value, i);
+    }
+    ASSERT_TRUE(queue.empty());
+}
+
+TEST(MpscQueueTest, MoveOnlyValuesLeftInQueueAreDestroyed)
+{
+    auto value = std::make_shared<int>(1);
+    {
+        ndt::MpscQueue<std::shared_ptr<int>> queue;
+        queue.push(value);
+        queue.push(value);
+        ASSERT_EQ(value.use_count(), 3);
+        queue.pop();
+        ASSERT_EQ(value.use_count(), 2);
+    }
+    ASSERT_EQ(value.use_count(), 1);
+}
+
+TEST(MpscQueueTest, ConcurrentProducersKeepPerProducerOrder)
+{
+    constexpr std::size_t kProducerCount = 4;
+    constexpr std::size_t kValueCount = 20000;
+    ndt::MpscQueue<std::pair<std::size_t, std::size_t>> queue;
+    std::vector<std::thread> producers;
+    for (std::size_t p = 0; p < kProducerCount; ++p)
+    {
+        producers.emplace_back([&queue, p]() {
+            for (std::size_t i = 0; i < kValueCount; ++i)
+            {
+                queue.push({p, i});
+            }
+        });
+    }
+
+    std::vector<std::size_t> expected(kProducerCount, 0);
+    std::size_t popCount = 0;
+    while (popCount < kProducerCount * kValueCount)
+    {
+        if (const auto value = queue.pop(); value)
+        {
+            ASSERT_EQ(value->second, expected[value->first]);
+            ++expected[value->first];
+            ++popCount;
+        }
+    }
+    for (auto &producer: producers)
+    {
+        producer.join();
+    }
+    ASSERT_TRUE(queue.empty());
+}
@@ -0,0 +1,166 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "ndt/address.h"
+#include "ndt/context.h"
+#include "ndt/event_handler_select.h"
+#include "ndt/send_queue.h"
+#include "ndt/udp.h"
+
+namespace
+{
+// real sockets, but socket's send buffer is full while isFull_ is set
+struct FullBufferOps : ndt::SocketOps
+{
+    static ndt::sdlen_t sendto(ndt::sock_t, ndt::cbufp_t aBuf,
+                               ndt::dlen_t aLen, int, const sockaddr *,
+                               ndt::salen_t)
+    {
+        if (isFull_)
+        {
+            errno = EWOULDBLOCK;
+            return ndt::kSocketError;
+        }
+        sent_.emplace_back(static_cast<const char *>(aBuf), aLen);
+        return static_cast<ndt::sdlen_t>(aLen);
+    }
+
+    static inline bool isFull_ = false;
+    static inline std::vector<std::string> sent_;
+};
+
+using ContextT = ndt::Context<FullBufferOps>;
+using SocketT = ndt::Socket<ndt::UDP, FullBufferOps>;
+using QueueT = ndt::SendQueue<FullBufferOps>;
+
+class Sender : public ndt::HandlerSelect<SocketT, Sender, FullBufferOps>
+{
+   public:
+    Sender(ContextT &aContext, const std::size_t aMaxCount,
+           const std::size_t aMaxBytes, const ndt::eDropPolicy aPolicy)
+        : HandlerSelect(aContext)
+        , socket_(aContext, ndt::UDP::V4())
+        , queue_(socket_, aMaxCount, aMaxBytes, aPolicy)
+    {
+        socket_.open();
+        socket_.nonBlocking(true);
+        socket_.handler(this);
+    }
+
+    ~Sender() { socket_.close(); }
+
+    void writeHandlerImpl(SocketT &)
+    {
+        ++writeCount_;
+        queue_.flush();
+    }
+
+    SocketT socket_;
+    QueueT queue_;
+    std::size_t writeCount_ = 0;
+};
+
+class SendQueueTests : public ::testing::Test
+{
+   protected:
+    SendQueueTests()
+    {
+        FullBufferOps::isFull_ = false;
+        FullBufferOps::sent_.clear();
+    }
+
+    void send(Sender &aSender, const std::string &aData,
+              std::error_code &aEc)
+    {
+        aSender.queue_.sendTo(dst_, ndt::CBuffer(aData.data(), aData.size()),
+                              aEc);
+    }
+
+    const ndt::Address dst_{ndt::kIPv4Loopback, 34114};
+    ContextT ctx_;
+};
+}  // namespace
+
+TEST_F(SendQueueTests, DatagramIsSentRightAwayWhenSocketAcceptsIt)
+{
+    Sender sender(ctx_, 4, 1024, ndt::eDropPolicy::kDropNewest);
+    std::error_code ec;
+    send(sender, "a", ec);
+    ASSERT_FALSE(ec);
+    ASSERT_TRUE(sender.queue_.empty());
+    ASSERT_FALSE(sender.socket_.writeInterest());
+    ASSERT_EQ(FullBufferOps::sent_, std::vector<std::string>{"a"});
+}
+
+TEST_F(SendQueueTests, QueuedDatagramsAreFlushedWhenSocketIsWritable)
+{
+    Sender sender(ctx_, 4, 1024, ndt::eDropPolicy::kDropNewest);
+    FullBufferOps::isFull_ = true;
+    std::error_code ec;
+    send(sender, "a", ec);
+    send(sender, "b", ec);
+    ASSERT_FALSE(ec);
+    ASSERT_EQ(sender.queue_.size(), 2);
+    ASSERT_EQ(sender.queue_.bytes(), 2);
+    ASSERT_TRUE(sender.socket_.writeInterest());
+
+    // later datagrams are queued behind earlier ones even if socket could
+    // accept them
+    FullBufferOps::isFull_ = false;
+    send(sender, "c", ec);
+    ASSERT_TRUE(FullBufferOps::sent_.empty());
+
+    ctx_.runOnce();
+    ASSERT_EQ(sender.writeCount_, 1);
+    ASSERT_EQ(FullBufferOps::sent_,
+              (std::vector<std::string>{"a", "b", "c"}));
+    ASSERT_TRUE(sender.queue_.empty());
+    ASSERT_FALSE(sender.socket_.writeInterest());
+
+    // write readiness isn't watched anymore
+    ctx_.runFor(std::chrono::milliseconds(20));
+    ASSERT_EQ(sender.writeCount_, 1);
+}
+
+TEST_F(SendQueueTests, DropNewestRejectsDatagramWhichDoesNotFit)
+{
+    Sender sender(ctx_, 2, 1024, ndt::eDropPolicy::kDropNewest);
+    FullBufferOps::isFull_ = true;
+    std::error_code ec;
+    send(sender, "a", ec);
+    send(sender, "b", ec);
+    ASSERT_FALSE(ec);
+    send(sender, "c", ec);
+    ASSERT_EQ(ec, std::errc::no_buffer_space);
+    ASSERT_EQ(sender.queue_.droppedCount(), 1);
+
+    FullBufferOps::isFull_ = false;
+    sender.queue_.flush();
+    ASSERT_EQ(FullBufferOps::sent_, (std::vector<std::string>{"a", "b"}));
+}
+
+TEST_F(SendQueueTests, DropOldestMakesRoomForNewDatagram)
+{
+    Sender sender(ctx_, 8, 4, ndt::eDropPolicy::kDropOldest);
+    FullBufferOps::isFull_ = true;
+    std::error_code ec;
+    send(sender, "aa", ec);
+    send(sender, "bb", ec);
+    send(sender, "ccc", ec);
+    ASSERT_FALSE(ec);
+    ASSERT_EQ(sender.queue_.droppedCount(), 2);
+    ASSERT_EQ(sender.queue_.bytes(), 3);
+
+    // datagram bigger than the whole queue can't be queued at all
+    send(sender, "ddddd", ec);
+    ASSERT_EQ(ec, std::errc::no_buffer_space);
+
+    FullBufferOps::isFull_ = false;
+    sender.queue_.flush();
+    ASSERT_EQ(FullBufferOps::sent_, std::vector<std::string>{"ccc"});
+}
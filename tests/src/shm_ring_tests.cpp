@@ -0,0 +1,318 @@
+#include <fmt/core.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ndt/address.h"
+#include "ndt/context.h"
+#include "ndt/event_handler_select.h"
+#include "ndt/shm_ring.h"
+
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace
+{
+using ContextT = ndt::Context<ndt::SocketOps>;
+
+constexpr timeval kTimeout = {1, 0};
+
+class ShmRecvHandler
+    : public ndt::HandlerSelect<ndt::ShmRing::Socket, ShmRecvHandler,
+                                ndt::SocketOps>
+{
+   public:
+    explicit ShmRecvHandler(ContextT &aContext) : HandlerSelect(aContext) {}
+
+    void recvHandlerImpl(ndt::ShmRing::Socket &, const ndt::Address &,
+                         ndt::CBuffer aData)
+    {
+        messages_.emplace_back(static_cast<char const *>(aData.data()),
+                               aData.size());
+        if (messages_.size() == expectedCount_)
+        {
+            context_.stop();
+        }
+    }
+
+    std::size_t expectedCount_ = 1;
+    std::vector<std::string> messages_;
+};
+
+std::string recvString(ndt::ShmRing::Socket &aSocket)
+{
+    char data[256];
+    ndt::Buffer buf(data);
+    ndt::Address sender;
+    aSocket.recvFrom(buf, sender);
+    return std::string(data, buf.size());
+}
+}  // namespace
+
+TEST(ShmRingTests, Flags)
+{
+    const auto flags = ndt::ShmRing::Create(16, 128);
+    ASSERT_TRUE(flags.isCreator());
+    ASSERT_EQ(flags.slotCount(), 16);
+    ASSERT_EQ(flags.slotSize(), 128);
+    ASSERT_EQ(flags, ndt::ShmRing::Create(16, 128));
+    ASSERT_NE(flags, ndt::ShmRing::Create(32, 128));
+
+    ndt::ShmRing::Handles handles;
+    handles.memory_ = 3;
+    handles.creatorWakeup_ = 4;
+    handles.attacherWakeup_ = 5;
+    const auto attachFlags = ndt::ShmRing::Attach(handles);
+    ASSERT_FALSE(attachFlags.isCreator());
+    ASSERT_EQ(attachFlags.handles().memory_, 3);
+    ASSERT_EQ(attachFlags.handles().attacherWakeup_, 5);
+    ASSERT_NE(attachFlags, flags);
+}
+
+TEST(ShmRingTests, SlotCountMustBePowerOfTwo)
+{
+    ContextT ctx;
+    ndt::ShmRing::Socket socket(ctx, ndt::ShmRing::Create(12, 128));
+    std::error_code ec;
+    socket.open(ec);
+    ASSERT_EQ(ec, std::errc::invalid_argument);
+    ASSERT_FALSE(socket.isOpen());
+}
+
+TEST(ShmRingTests, AttachRejectsSegmentWithInvalidSlotCount)
+{
+    constexpr uint32_t kSlotCount = 12;
+    constexpr uint32_t kSlotSize = 128;
+    const std::size_t size =
+        ndt::details::ShmRingView::segmentSize(kSlotCount, kSlotSize);
+    ndt::ShmRing::Handles handles;
+    handles.memory_ = ::memfd_create("ndt_shm_ring_test", MFD_CLOEXEC);
+    ASSERT_NE(handles.memory_, -1);
+    ASSERT_EQ(::ftruncate(handles.memory_, static_cast<off_t>(size)), 0);
+    void *memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                          handles.memory_, 0);
+    ASSERT_NE(memory, MAP_FAILED);
+    ndt::details::ShmRingView::init(memory, kSlotCount, kSlotSize);
+    handles.creatorWakeup_ = ::eventfd(0, EFD_CLOEXEC);
+    handles.attacherWakeup_ = ::eventfd(0, EFD_CLOEXEC);
+
+    ContextT ctx;
+    ndt::ShmRing::Socket attacher(ctx, ndt::ShmRing::Attach(handles));
+    std::error_code ec;
+    attacher.open(ec);
+    ASSERT_EQ(ec, std::errc::invalid_argument);
+    ASSERT_FALSE(attacher.isOpen());
+
+    ::munmap(memory, size);
+    ::close(handles.memory_);
+    ::close(handles.creatorWakeup_);
+    ::close(handles.attacherWakeup_);
+}
+
+TEST(ShmRingTests, CorruptedMessageSizeIsClampedToSlot)
+{
+    constexpr uint32_t kSlotSize = 8;
+    ContextT ctx;
+    ndt::ShmRing::Socket creator(ctx, ndt::ShmRing::Create(4, kSlotSize));
+    creator.open();
+    ndt::ShmRing::Socket attacher(ctx,
+                                  ndt::ShmRing::Attach(creator.handles()));
+    attacher.open();
+
+    const char kData[] = "1234567";
+    creator.send(ndt::CBuffer(kData));
+
+    // other process overwrites size of the message in the first slot
+    const std::size_t size = ndt::details::ShmRingView::segmentSize(4, 8);
+    void *memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                          creator.handles().memory_, 0);
+    ASSERT_NE(memory, MAP_FAILED);
+    auto *segment = static_cast<ndt::details::ShmRingSegment *>(memory);
+    auto *slot = reinterpret_cast<ndt::details::ShmRingSlot *>(segment + 1);
+    slot->size_ = 1 << 20;
+
+    char data[64];
+    ndt::Buffer buf(data);
+    ASSERT_EQ(attacher.recv(buf), kSlotSize);
+    ASSERT_EQ(std::string(data, kSlotSize - 1), "1234567");
+
+    ::munmap(memory, size);
+    attacher.close();
+    creator.close();
+}
+
+TEST(ShmRingTests, SocketWithHandlerIsNonBlocking)
+{
+    ContextT ctx;
+    ShmRecvHandler handler(ctx);
+    ndt::ShmRing::Socket creator(ctx, ndt::ShmRing::Create(16, 128));
+    creator.handler(&handler);
+    creator.open();
+    ASSERT_TRUE(creator.nonBlocking());
+
+    ndt::ShmRing::Socket attacher(ctx,
+                                  ndt::ShmRing::Attach(creator.handles()));
+    attacher.open();
+    ASSERT_FALSE(attacher.nonBlocking());
+    attacher.handler(&handler);
+    ASSERT_TRUE(attacher.nonBlocking());
+    ASSERT_EQ(attacher.handler(), &handler);
+
+    attacher.close();
+    creator.close();
+}
+
+TEST(ShmRingTests, MessagesGoBothWays)
+{
+    ContextT ctx;
+    ndt::ShmRing::Socket creator(ctx, ndt::ShmRing::Create(16, 128));
+    creator.open();
+    ndt::ShmRing::Socket attacher(ctx,
+                                  ndt::ShmRing::Attach(creator.handles()));
+    attacher.open();
+    ASSERT_EQ(attacher.flags().slotCount(), 16);
+    ASSERT_EQ(attacher.flags().slotSize(), 128);
+
+    const std::string kPing = "ping";
+    const std::string kPong = "pong!";
+    ASSERT_EQ(creator.send(ndt::CBuffer(kPing.data(), kPing.size())),
+              kPing.size());
+    ASSERT_EQ(recvString(attacher), kPing);
+    ASSERT_EQ(attacher.sendTo(ndt::Address(),
+                              ndt::CBuffer(kPong.data(), kPong.size())),
+              kPong.size());
+    ASSERT_EQ(recvString(creator), kPong);
+
+    creator.nonBlocking(true);
+    char data[16];
+    ndt::Buffer buf(data);
+    std::error_code ec;
+    ASSERT_EQ(creator.recv(buf, ec), 0);
+    ASSERT_EQ(ec, std::errc::operation_would_block);
+
+    attacher.close();
+    creator.close();
+}
+
+TEST(ShmRingTests, FullRingAndOversizedMessageFail)
+{
+    ContextT ctx;
+    ndt::ShmRing::Socket creator(ctx, ndt::ShmRing::Create(4, 8));
+    creator.open();
+    ndt::ShmRing::Socket attacher(ctx,
+                                  ndt::ShmRing::Attach(creator.handles()));
+    attacher.open();
+
+    const char kTooLong[] = "0123456789";
+    std::error_code ec;
+    ASSERT_EQ(creator.send(ndt::CBuffer(kTooLong), ec), 0);
+    ASSERT_EQ(ec, std::errc::message_size);
+
+    const char kData[] = "1234567";
+    for (int i = 0; i < 4; ++i)
+    {
+        creator.send(ndt::CBuffer(kData));
+    }
+    ec.clear();
+    ASSERT_EQ(creator.send(ndt::CBuffer(kData), ec), 0);
+    ASSERT_EQ(ec, std::errc::no_buffer_space);
+
+    // slot is freed by receiver, message is truncated to the buffer
+    char data[4];
+    ndt::Buffer buf(data);
+    ASSERT_EQ(attacher.recv(buf), sizeof(data));
+    ASSERT_EQ(std::string(data, sizeof(data)), "1234");
+    ASSERT_EQ(creator.send(ndt::CBuffer(kData)), sizeof(kData));
+
+    attacher.close();
+    creator.close();
+}
+
+TEST(ShmRingTests, MessagesAreDispatchedToRecvHandler)
+{
+    constexpr std::size_t kMessageCount = 100;
+    ContextT ctx;
+    ctx.executor().setTimeout(kTimeout);
+    ctx.executor().setTimeoutHandler([&ctx]() { ctx.stop(); });
+
+    ndt::ShmRing::Socket creator(ctx, ndt::ShmRing::Create(16, 64));
+    creator.open();
+    ndt::ShmRing::Socket attacher(ctx,
+                                  ndt::ShmRing::Attach(creator.handles()));
+    attacher.open();
+    ShmRecvHandler handler(ctx);
+    handler.expectedCount_ = kMessageCount;
+    attacher.handler(&handler);
+
+    std::thread producer(
+        [&creator]()
+        {
+            for (std::size_t i = 0; i < kMessageCount;)
+            {
+                const std::string data = std::to_string(i);
+                std::error_code ec;
+                creator.send(ndt::CBuffer(data.data(), data.size()), ec);
+                if (!ec)
+                {
+                    ++i;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    ctx.run();
+    producer.join();
+
+    ASSERT_EQ(handler.messages_.size(), kMessageCount);
+    for (std::size_t i = 0; i < kMessageCount; ++i)
+    {
+        ASSERT_EQ(handler.messages_[i], std::to_string(i));
+    }
+    attacher.close();
+    creator.close();
+}
+
+TEST(ShmRingTests, BlockingReceiverIsWokenByOtherProcess)
+{
+    ContextT ctx;
+    ndt::ShmRing::Socket creator(ctx, ndt::ShmRing::Create(16, 64));
+    creator.open();
+    const ndt::ShmRing::Handles handles = creator.handles();
+
+    const pid_t child = ::fork();
+    ASSERT_NE(child, -1);
+    if (child == 0)
+    {
+        ContextT childCtx;
+        ndt::ShmRing::Socket attacher(childCtx, ndt::ShmRing::Attach(handles));
+        attacher.open();
+        const std::string request = recvString(attacher);
+        const std::string reply = request + " reply";
+        attacher.send(ndt::CBuffer(reply.data(), reply.size()));
+        attacher.close();
+        ::_exit(0);
+    }
+
+    // child waits in eventfd read until request arrives
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    const std::string kRequest = "request";
+    creator.send(ndt::CBuffer(kRequest.data(), kRequest.size()));
+    ASSERT_EQ(recvString(creator), "request reply");
+
+    int status = 0;
+    ASSERT_EQ(::waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+    creator.close();
+}
+#endif
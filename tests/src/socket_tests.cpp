@@ -4,14 +4,19 @@
 
 #include <algorithm>
 #include <array>
+#include <cstring>
+#include <string>
+#include <vector>
 
 #include "ndt/address.h"
 #include "ndt/context.h"
 #include "ndt/exception.h"
 #include "ndt/socket.h"
 #include "ndt/udp.h"
+#include "ndt/unix_dgram.h"
 
 using ::testing::_;
+using ::testing::Invoke;
 using ::testing::InSequence;
 using ::testing::Return;
 
@@ -20,6 +25,7 @@ constexpr int kBindSucceeded = 0;
 constexpr int kCloseSucceeded = 0;
 constexpr ndt::sdlen_t kRecvfromSucceeded = 1;
 constexpr ndt::sdlen_t kSendtoSucceeded = 1;
+constexpr int kSetsockoptSucceeded = 0;
 constexpr ndt::salen_t kV4Size = sizeof(sockaddr_in);
 constexpr ndt::salen_t kV6Size = sizeof(sockaddr_in6);
 
@@ -34,8 +40,30 @@ class MockDetails
     MOCK_METHOD(ndt::sdlen_t, sendto,
                 (ndt::sock_t, ndt::cbufp_t, ndt::dlen_t, int,
                  const struct sockaddr *, ndt::salen_t));
+    MOCK_METHOD(int, connect,
+                (ndt::sock_t, const struct sockaddr *, ndt::salen_t));
+    MOCK_METHOD(ndt::sdlen_t, send,
+                (ndt::sock_t, ndt::cbufp_t, ndt::dlen_t, int));
+    MOCK_METHOD(ndt::sdlen_t, recv,
+                (ndt::sock_t, ndt::bufp_t, ndt::dlen_t, int));
     MOCK_METHOD(ndt::sock_t, socket, (int, int, int));
     MOCK_METHOD(int, close, (ndt::sock_t));
+    MOCK_METHOD(int, setsockopt,
+                (ndt::sock_t, int, int, const void *, ndt::salen_t));
+    MOCK_METHOD(int, getsockopt,
+                (ndt::sock_t, int, int, void *, ndt::salen_t *));
+#if !_WIN32
+    MOCK_METHOD(ndt::sdlen_t, sendmsg,
+                (ndt::sock_t, const struct msghdr *, int));
+    MOCK_METHOD(ndt::sdlen_t, recvmsg, (ndt::sock_t, struct msghdr *, int));
+#endif
+#if defined(__linux__)
+    MOCK_METHOD(int, recvmmsg,
+                (ndt::sock_t, struct mmsghdr *, unsigned int, int,
+                 struct timespec *));
+    MOCK_METHOD(int, sendmmsg,
+                (ndt::sock_t, struct mmsghdr *, unsigned int, int));
+#endif
 
     void expectSocketFailed(const int family)
     {
@@ -94,6 +122,18 @@ class MockDetails
         EXPECT_CALL(*this, recvfrom(_, _, _, _, _, _))
             .WillOnce(Return(ndt::kSocketError));
     }
+
+    void expectSetsockoptSucceded(const int level, const int optname)
+    {
+        EXPECT_CALL(*this, setsockopt(kValidSockId, level, optname, _, _))
+            .WillOnce(Return(kSetsockoptSucceeded));
+    }
+
+    void expectSetsockoptFailed(const int level, const int optname)
+    {
+        EXPECT_CALL(*this, setsockopt(kValidSockId, level, optname, _, _))
+            .WillOnce(Return(ndt::kSocketError));
+    }
 };
 
 class SocketTest : public ::testing::Test
@@ -130,6 +170,24 @@ class SocketTest : public ::testing::Test
         return mDetails->sendto(sockfd, buf, len, flags, dest_addr, addrlen);
     }
 
+    static int connect(ndt::sock_t sockfd, const struct sockaddr *addr,
+                       ndt::salen_t addrlen)
+    {
+        return mDetails->connect(sockfd, addr, addrlen);
+    }
+
+    static ndt::sdlen_t send(ndt::sock_t sockfd, ndt::cbufp_t buf,
+                             ndt::dlen_t len, int flags)
+    {
+        return mDetails->send(sockfd, buf, len, flags);
+    }
+
+    static ndt::sdlen_t recv(ndt::sock_t sockfd, ndt::bufp_t buf,
+                             ndt::dlen_t len, int flags)
+    {
+        return mDetails->recv(sockfd, buf, len, flags);
+    }
+
     static ndt::sock_t socket(int socket_family, int socket_type, int protocol)
     {
         return mDetails->socket(socket_family, socket_type, protocol);
@@ -137,6 +195,24 @@ class SocketTest : public ::testing::Test
 
     static int close(ndt::sock_t fd) { return mDetails->close(fd); }
 
+    static int setsockopt(ndt::sock_t sockfd, int level, int optname,
+                          const void *optval, ndt::salen_t optlen)
+    {
+        return mDetails->setsockopt(sockfd, level, optname, optval, optlen);
+    }
+
+    static int getsockopt(ndt::sock_t sockfd, int level, int optname,
+                          void *optval, ndt::salen_t *optlen)
+    {
+        return mDetails->getsockopt(sockfd, level, optname, optval, optlen);
+    }
+
+    static int getsockname(ndt::sock_t sockfd, struct sockaddr *addr,
+                           ndt::salen_t *addrlen) noexcept
+    {
+        return ndt::SocketOps::getsockname(sockfd, addr, addrlen);
+    }
+
 #if _WIN32
     static int ioctlsocket(ndt::sock_t s, long cmd, u_long *argp) noexcept
     {
@@ -149,6 +225,105 @@ class SocketTest : public ::testing::Test
     }
 
     static int WSACleanup() noexcept { return ndt::SocketOps::WSACleanup(); }
+#else
+    static int pipe(int pipefd[2]) noexcept
+    {
+        return ndt::SocketOps::pipe(pipefd);
+    }
+
+    static ndt::sdlen_t read(int fd, ndt::bufp_t buf,
+                             ndt::dlen_t count) noexcept
+    {
+        return ndt::SocketOps::read(fd, buf, count);
+    }
+
+    static ndt::sdlen_t write(int fd, ndt::cbufp_t buf,
+                              ndt::dlen_t count) noexcept
+    {
+        return ndt::SocketOps::write(fd, buf, count);
+    }
+
+    static ndt::sdlen_t sendmsg(ndt::sock_t sockfd, const struct msghdr *msg,
+                                int flags) noexcept
+    {
+        return mDetails->sendmsg(sockfd, msg, flags);
+    }
+
+    static ndt::sdlen_t recvmsg(ndt::sock_t sockfd, struct msghdr *msg,
+                                int flags) noexcept
+    {
+        return mDetails->recvmsg(sockfd, msg, flags);
+    }
+#endif
+
+#if defined(__linux__)
+    static int recvmmsg(ndt::sock_t sockfd, struct mmsghdr *msgvec,
+                        unsigned int vlen, int flags,
+                        struct timespec *timeout) noexcept
+    {
+        return mDetails->recvmmsg(sockfd, msgvec, vlen, flags, timeout);
+    }
+
+    static int sendmmsg(ndt::sock_t sockfd, struct mmsghdr *msgvec,
+                        unsigned int vlen, int flags) noexcept
+    {
+        return mDetails->sendmmsg(sockfd, msgvec, vlen, flags);
+    }
+
+    static int epoll_create1(int flags) noexcept
+    {
+        return ndt::SocketOps::epoll_create1(flags);
+    }
+
+    static int epoll_ctl(int epfd, int op, ndt::sock_t fd,
+                         struct epoll_event *event) noexcept
+    {
+        return ndt::SocketOps::epoll_ctl(epfd, op, fd, event);
+    }
+
+    static int epoll_wait(int epfd, struct epoll_event *events, int maxevents,
+                          int timeout) noexcept
+    {
+        return ndt::SocketOps::epoll_wait(epfd, events, maxevents, timeout);
+    }
+
+    static int eventfd(unsigned int initval, int flags) noexcept
+    {
+        return ndt::SocketOps::eventfd(initval, flags);
+    }
+#endif
+
+#if defined(NDT_HAS_IO_URING)
+    static int io_uring_setup(unsigned entries,
+                              struct io_uring_params *p) noexcept
+    {
+        return ndt::SocketOps::io_uring_setup(entries, p);
+    }
+
+    static int io_uring_enter(int fd, unsigned to_submit,
+                              unsigned min_complete, unsigned flags,
+                              const void *arg, std::size_t argsz) noexcept
+    {
+        return ndt::SocketOps::io_uring_enter(fd, to_submit, min_complete,
+                                              flags, arg, argsz);
+    }
+
+    static int io_uring_register(int fd, unsigned opcode, void *arg,
+                                 unsigned nr_args) noexcept
+    {
+        return ndt::SocketOps::io_uring_register(fd, opcode, arg, nr_args);
+    }
+
+    static void *mmap(void *addr, std::size_t length, int prot, int flags,
+                      int fd, off_t offset) noexcept
+    {
+        return ndt::SocketOps::mmap(addr, length, prot, flags, fd, offset);
+    }
+
+    static int munmap(void *addr, std::size_t length) noexcept
+    {
+        return ndt::SocketOps::munmap(addr, length);
+    }
 #endif
 
     static std::unique_ptr<MockDetails> mDetails;
@@ -179,6 +354,39 @@ TEST_F(SocketTest, ConstructorWithUDPv6flags)
     ASSERT_EQ(s.flags().getSocketType(), ndt::eSocketType::kDgram);
 }
 
+TEST_F(SocketTest, DualStackSocketMustTurnV6OnlyOff)
+{
+    InSequence seq;
+    mDetails->expectSocketSucceded(AF_INET6);
+    EXPECT_CALL(*mDetails,
+                setsockopt(kValidSockId, IPPROTO_IPV6, IPV6_V6ONLY, _, _))
+        .WillOnce(Invoke([](ndt::sock_t, int, int, const void *aValue,
+                            ndt::salen_t) {
+            EXPECT_EQ(*static_cast<const int *>(aValue), 0);
+            return kSetsockoptSucceeded;
+        }));
+    mDetails->expectBindSucceded(kV6Size);
+    mDetails->expectCloseSucceded();
+
+    ndt::Socket<ndt::UDP, SocketTest> s(ctx, ndt::UDP::DualStack(), 333);
+    ASSERT_TRUE(s.flags().isDualStack());
+    ASSERT_EQ(s.flags().getFamily(), ndt::eAddressFamily::kIPv6);
+    ASSERT_NE(s.flags(), ndt::UDP::V6());
+    s.close();
+}
+
+TEST_F(SocketTest, FailedV6OnlyMustCloseDualStackSocket)
+{
+    InSequence seq;
+    mDetails->expectSocketSucceded(AF_INET6);
+    mDetails->expectSetsockoptFailed(IPPROTO_IPV6, IPV6_V6ONLY);
+    mDetails->expectCloseSucceded();
+
+    ndt::Socket<ndt::UDP, SocketTest> s(ctx, ndt::UDP::DualStack());
+    EXPECT_THROW(s.open(), ndt::Error);
+    ASSERT_FALSE(s.isOpen());
+}
+
 TEST_F(SocketTest, SocketFuncReturnErrorInConstructorWithUDPv4flagsCall)
 {
     mDetails->expectSocketFailed(AF_INET);
@@ -734,6 +942,224 @@ TEST_F(SocketTest, SuccessfulRecvFromMustReturnCountBytesRecieved)
     s.close();
 }
 
+TEST_F(SocketTest, ConnectedSocketMustSendAndRecvWithoutAddress)
+{
+    InSequence seq;
+    mDetails->expectSocketSucceded(AF_INET);
+    mDetails->expectBindSucceded(kV4Size);
+    EXPECT_CALL(*mDetails, connect(kValidSockId, _, kV4Size))
+        .WillOnce(Return(0));
+    EXPECT_CALL(*mDetails, send(kValidSockId, _, 4, 0)).WillOnce(Return(4));
+    EXPECT_CALL(*mDetails, recv(kValidSockId, _, 16, 0)).WillOnce(Return(3));
+    EXPECT_CALL(*mDetails, connect(kValidSockId, _, kV4Size))
+        .WillOnce(Invoke([](ndt::sock_t, const struct sockaddr *aAddr,
+                            ndt::salen_t) {
+#if !_WIN32
+            EXPECT_EQ(aAddr->sa_family, AF_UNSPEC);
+#endif
+            return 0;
+        }));
+    mDetails->expectCloseSucceded();
+
+    ndt::Socket<ndt::UDP, SocketTest> s(ctx, ndt::UDP::V4(), 11);
+    ASSERT_FALSE(s.isConnected());
+    s.connect(ndt::Address(ndt::kIPv4Loopback, 12));
+    ASSERT_TRUE(s.isConnected());
+    const char kData[] = "data";
+    ASSERT_EQ(s.send(ndt::CBuffer(kData, 4)), 4);
+    char data[16];
+    ndt::Buffer buf(data);
+    ASSERT_EQ(s.recv(buf), 3);
+    ASSERT_EQ(buf.size(), 3);
+    s.disconnect();
+    ASSERT_FALSE(s.isConnected());
+    s.close();
+}
+
+TEST_F(SocketTest, FailedConnectMustThrowError)
+{
+    InSequence seq;
+    mDetails->expectSocketSucceded(AF_INET);
+    mDetails->expectBindSucceded(kV4Size);
+    EXPECT_CALL(*mDetails, connect(_, _, _))
+        .WillOnce(Return(ndt::kSocketError));
+    mDetails->expectCloseSucceded();
+
+    ndt::Socket<ndt::UDP, SocketTest> s(ctx, ndt::UDP::V4(), 11);
+    EXPECT_THROW(s.connect(ndt::Address(ndt::kIPv4Loopback, 12)), ndt::Error);
+    ASSERT_FALSE(s.isConnected());
+    s.close();
+}
+
+#if defined(SO_REUSEPORT)
+TEST_F(SocketTest, ReusePortMustSetSocketOption)
+{
+    InSequence seq;
+    mDetails->expectSocketSucceded(AF_INET);
+    mDetails->expectSetsockoptSucceded(SOL_SOCKET, SO_REUSEPORT);
+    mDetails->expectBindSucceded(kV4Size);
+    mDetails->expectCloseSucceded();
+
+    ndt::Socket<ndt::UDP, SocketTest> s(ctx, ndt::UDP::V4());
+    s.open();
+    ASSERT_NO_THROW(s.reusePort(true));
+    s.bind(11);
+    s.close();
+}
+
+TEST_F(SocketTest, FailedReusePortMustThrowError)
+{
+    InSequence seq;
+    mDetails->expectSocketSucceded(AF_INET);
+    mDetails->expectSetsockoptFailed(SOL_SOCKET, SO_REUSEPORT);
+    mDetails->expectCloseSucceded();
+
+    ndt::Socket<ndt::UDP, SocketTest> s(ctx, ndt::UDP::V4());
+    s.open();
+    EXPECT_THROW(s.reusePort(true), ndt::Error);
+    s.close();
+}
+#endif
+
+#if defined(SO_BUSY_POLL)
+TEST_F(SocketTest, BusyPollMustSetSocketOption)
+{
+    InSequence seq;
+    mDetails->expectSocketSucceded(AF_INET);
+    mDetails->expectSetsockoptSucceded(SOL_SOCKET, SO_BUSY_POLL);
+    mDetails->expectCloseSucceded();
+
+    ndt::Socket<ndt::UDP, SocketTest> s(ctx, ndt::UDP::V4());
+    s.open();
+    ASSERT_NO_THROW(s.busyPoll(std::chrono::microseconds(50)));
+    s.close();
+}
+
+TEST_F(SocketTest, FailedBusyPollMustThrowError)
+{
+    InSequence seq;
+    mDetails->expectSocketSucceded(AF_INET);
+    mDetails->expectSetsockoptFailed(SOL_SOCKET, SO_BUSY_POLL);
+    mDetails->expectCloseSucceded();
+
+    ndt::Socket<ndt::UDP, SocketTest> s(ctx, ndt::UDP::V4());
+    s.open();
+    EXPECT_THROW(s.busyPoll(std::chrono::microseconds(50)), ndt::Error);
+    s.close();
+}
+#endif
+
+TEST_F(SocketTest, SetOptionMustPassNativeValueToSetsockopt)
+{
+    InSequence seq;
+    mDetails->expectSocketSucceded(AF_INET);
+    EXPECT_CALL(*mDetails,
+                setsockopt(kValidSockId, SOL_SOCKET, SO_RCVBUF, _, sizeof(int)))
+        .WillOnce(Invoke([](ndt::sock_t, int, int, const void *aValue,
+                            ndt::salen_t) {
+            EXPECT_EQ(*static_cast<const int *>(aValue), 8 << 20);
+            return kSetsockoptSucceeded;
+        }));
+    EXPECT_CALL(*mDetails, setsockopt(kValidSockId, IPPROTO_IP, IP_TOS, _, _))
+        .WillOnce(Invoke([](ndt::sock_t, int, int, const void *aValue,
+                            ndt::salen_t) {
+            // DSCP occupies upper 6 bits of type of service
+            EXPECT_EQ(*static_cast<const int *>(aValue), 46 << 2);
+            return kSetsockoptSucceeded;
+        }));
+    mDetails->expectCloseSucceded();
+
+    ndt::Socket<ndt::UDP, SocketTest> s(ctx, ndt::UDP::V4());
+    s.open();
+    ASSERT_NO_THROW(s.set<ndt::opt::RecvBufferSize>(8 << 20));
+    ASSERT_NO_THROW(s.set<ndt::opt::Dscp>(46));
+    s.close();
+}
+
+TEST_F(SocketTest, GetOptionMustConvertValueOfGetsockopt)
+{
+    InSequence seq;
+    mDetails->expectSocketSucceded(AF_INET);
+    EXPECT_CALL(*mDetails, getsockopt(kValidSockId, IPPROTO_IP, IP_TOS, _, _))
+        .WillOnce(Invoke(
+            [](ndt::sock_t, int, int, void *aValue, ndt::salen_t *aSize) {
+                EXPECT_EQ(*aSize, sizeof(int));
+                *static_cast<int *>(aValue) = (10 << 2) | 1;
+                return 0;
+            }));
+    EXPECT_CALL(*mDetails,
+                getsockopt(kValidSockId, SOL_SOCKET, SO_SNDBUF, _, _))
+        .WillOnce(Return(ndt::kSocketError));
+    mDetails->expectCloseSucceded();
+
+    ndt::Socket<ndt::UDP, SocketTest> s(ctx, ndt::UDP::V4());
+    s.open();
+    ASSERT_EQ(s.get<ndt::opt::Dscp>(), 10);
+    std::error_code ec;
+    ASSERT_EQ(s.get<ndt::opt::SendBufferSize>(ec), 0);
+    ASSERT_EQ(ec.value(), SocketTest::lastErrorCode());
+    s.close();
+}
+
+#if defined(IPV6_TCLASS)
+TEST_F(SocketTest, Dscp6MustSetTrafficClassOfV6Socket)
+{
+    InSequence seq;
+    mDetails->expectSocketSucceded(AF_INET6);
+    EXPECT_CALL(*mDetails,
+                setsockopt(kValidSockId, IPPROTO_IPV6, IPV6_TCLASS, _, _))
+        .WillOnce(Invoke([](ndt::sock_t, int, int, const void *aValue,
+                            ndt::salen_t) {
+            EXPECT_EQ(*static_cast<const int *>(aValue), 46 << 2);
+            return kSetsockoptSucceeded;
+        }));
+    EXPECT_CALL(*mDetails,
+                getsockopt(kValidSockId, IPPROTO_IPV6, IPV6_TCLASS, _, _))
+        .WillOnce(Invoke(
+            [](ndt::sock_t, int, int, void *aValue, ndt::salen_t *aSize) {
+                EXPECT_EQ(*aSize, sizeof(int));
+                *static_cast<int *>(aValue) = (46 << 2) | 2;
+                return 0;
+            }));
+    EXPECT_CALL(*mDetails,
+                getsockopt(kValidSockId, IPPROTO_IPV6, IPV6_TCLASS, _, _))
+        .WillOnce(Invoke(
+            [](ndt::sock_t, int, int, void *aValue, ndt::salen_t *) {
+                *static_cast<int *>(aValue) = 0xB8;
+                return 0;
+            }));
+    mDetails->expectCloseSucceded();
+
+    ndt::Socket<ndt::UDP, SocketTest> s(ctx, ndt::UDP::V6());
+    s.open();
+    ASSERT_NO_THROW(s.set<ndt::opt::Dscp6>(46));
+    ASSERT_EQ(s.get<ndt::opt::Dscp6>(), 46);
+    ASSERT_EQ(s.get<ndt::opt::TrafficClass>(), 0xB8);
+    s.close();
+}
+#endif
+
+#if defined(IPV6_MTU_DISCOVER)
+TEST_F(SocketTest, MtuDiscover6MustSetOptionOfV6Socket)
+{
+    InSequence seq;
+    mDetails->expectSocketSucceded(AF_INET6);
+    EXPECT_CALL(*mDetails,
+                setsockopt(kValidSockId, IPPROTO_IPV6, IPV6_MTU_DISCOVER, _, _))
+        .WillOnce(Invoke([](ndt::sock_t, int, int, const void *aValue,
+                            ndt::salen_t) {
+            EXPECT_EQ(*static_cast<const int *>(aValue), IPV6_PMTUDISC_DO);
+            return kSetsockoptSucceeded;
+        }));
+    mDetails->expectCloseSucceded();
+
+    ndt::Socket<ndt::UDP, SocketTest> s(ctx, ndt::UDP::V6());
+    s.open();
+    ASSERT_NO_THROW(s.set<ndt::opt::MtuDiscover6>(IPV6_PMTUDISC_DO));
+    s.close();
+}
+#endif
+
 TEST_F(SocketTest, FailedRecvFromMustThrowError)
 {
     InSequence seq;
@@ -761,6 +1187,586 @@ TEST_F(SocketTest, FailedRecvFromMustThrowError)
     s.close();
 }
 
+#if defined(__linux__)
+TEST_F(SocketTest, RecvBatchMustSetSizesOfReceivedDatagrams)
+{
+    InSequence seq;
+    mDetails->expectSocketSucceded(AF_INET);
+    mDetails->expectBindSucceded(kV4Size);
+    EXPECT_CALL(*mDetails, recvmmsg(kValidSockId, _, 3u, 0, nullptr))
+        .WillOnce(Invoke([](ndt::sock_t, struct mmsghdr *aMsgs, unsigned int,
+                            int, struct timespec *) {
+            aMsgs[0].msg_len = 5;
+            aMsgs[1].msg_len = 7;
+            return 2;
+        }));
+    mDetails->expectCloseSucceded();
+
+    ndt::Socket<ndt::UDP, SocketTest> s(ctx, ndt::UDP::V4(), 11);
+    char data[3][16];
+    std::array<ndt::Buffer, 3> bufs = {ndt::Buffer(data[0]),
+                                       ndt::Buffer(data[1]),
+                                       ndt::Buffer(data[2])};
+    std::array<ndt::Address, 3> senders;
+    std::error_code ec;
+    ASSERT_EQ(s.recvBatch(bufs.data(), senders.data(), bufs.size(), ec), 2);
+    ASSERT_FALSE(ec);
+    ASSERT_EQ(bufs[0].size(), 5);
+    ASSERT_EQ(bufs[1].size(), 7);
+    ASSERT_EQ(bufs[2].size(), sizeof(data[2]));
+    s.close();
+}
+
+TEST_F(SocketTest, FailedRecvBatchMustThrowError)
+{
+    InSequence seq;
+    mDetails->expectSocketSucceded(AF_INET);
+    mDetails->expectBindSucceded(kV4Size);
+    EXPECT_CALL(*mDetails, recvmmsg(_, _, _, _, _))
+        .WillOnce(Return(ndt::kSocketError));
+    mDetails->expectCloseSucceded();
+
+    ndt::Socket<ndt::UDP, SocketTest> s(ctx, ndt::UDP::V4(), 11);
+    char data[16];
+    ndt::Buffer buf(data);
+    ndt::Address sender;
+    EXPECT_THROW(s.recvBatch(&buf, &sender, 1), ndt::Error);
+    s.close();
+}
+
+TEST_F(SocketTest, SendBatchMustReturnPartialCountAndErrorOfFailedDatagram)
+{
+    InSequence seq;
+    mDetails->expectSocketSucceded(AF_INET);
+    mDetails->expectBindSucceded(kV4Size);
+    EXPECT_CALL(*mDetails, sendmmsg(kValidSockId, _, 3u, 0))
+        .WillOnce(Return(2));
+    EXPECT_CALL(*mDetails, sendmmsg(kValidSockId, _, 1u, 0))
+        .WillOnce(Return(ndt::kSocketError));
+    mDetails->expectCloseSucceded();
+
+    ndt::Socket<ndt::UDP, SocketTest> s(ctx, ndt::UDP::V4(), 11);
+    const char kData[] = "data";
+    const std::array<ndt::CBuffer, 3> bufs = {
+        ndt::CBuffer(kData), ndt::CBuffer(kData), ndt::CBuffer(kData)};
+    const std::array<ndt::Address, 3> dsts;
+    std::error_code ec;
+    ASSERT_EQ(s.sendBatch(dsts.data(), bufs.data(), bufs.size(), ec), 2);
+    ASSERT_EQ(ec.value(), SocketTest::lastErrorCode());
+    s.close();
+}
+
+TEST_F(SocketTest, SendBatchMustSplitDatagramsIntoBatchesOfMaxSize)
+{
+    constexpr std::size_t kMaxBatchSize =
+        ndt::SocketBase<SocketTest>::kMaxBatchSize;
+    constexpr std::size_t kCount = kMaxBatchSize + 1;
+
+    InSequence seq;
+    mDetails->expectSocketSucceded(AF_INET);
+    mDetails->expectBindSucceded(kV4Size);
+    EXPECT_CALL(*mDetails, sendmmsg(kValidSockId, _,
+                                    static_cast<unsigned int>(kMaxBatchSize),
+                                    0))
+        .WillOnce(Return(static_cast<int>(kMaxBatchSize)));
+    EXPECT_CALL(*mDetails, sendmmsg(kValidSockId, _, 1u, 0))
+        .WillOnce(Return(1));
+    mDetails->expectCloseSucceded();
+
+    ndt::Socket<ndt::UDP, SocketTest> s(ctx, ndt::UDP::V4(), 11);
+    const char kData[] = "data";
+    const std::vector<ndt::CBuffer> bufs(kCount, ndt::CBuffer(kData));
+    const std::vector<ndt::Address> dsts(kCount);
+    ASSERT_EQ(s.sendBatch(dsts.data(), bufs.data(), kCount), kCount);
+    s.close();
+}
+
+TEST_F(SocketTest, ConnectedBatchesMustNotPassAddresses)
+{
+    InSequence seq;
+    mDetails->expectSocketSucceded(AF_INET);
+    mDetails->expectBindSucceded(kV4Size);
+    EXPECT_CALL(*mDetails, connect(kValidSockId, _, kV4Size))
+        .WillOnce(Return(0));
+    EXPECT_CALL(*mDetails, sendmmsg(kValidSockId, _, 2u, 0))
+        .WillOnce(Invoke([](ndt::sock_t, struct mmsghdr *aMsgs, unsigned int,
+                            int) {
+            EXPECT_EQ(aMsgs[0].msg_hdr.msg_name, nullptr);
+            EXPECT_EQ(aMsgs[1].msg_hdr.msg_namelen, 0);
+            return 2;
+        }));
+    EXPECT_CALL(*mDetails, recvmmsg(kValidSockId, _, 2u, 0, nullptr))
+        .WillOnce(Invoke([](ndt::sock_t, struct mmsghdr *aMsgs, unsigned int,
+                            int, struct timespec *) {
+            EXPECT_EQ(aMsgs[0].msg_hdr.msg_name, nullptr);
+            aMsgs[0].msg_len = 5;
+            return 1;
+        }));
+    mDetails->expectCloseSucceded();
+
+    ndt::Socket<ndt::UDP, SocketTest> s(ctx, ndt::UDP::V4(), 11);
+    s.connect(ndt::Address(ndt::kIPv4Loopback, 12));
+    const char kData[] = "data";
+    const std::array<ndt::CBuffer, 2> outBufs = {ndt::CBuffer(kData),
+                                                 ndt::CBuffer(kData)};
+    ASSERT_EQ(s.sendBatch(outBufs.data(), outBufs.size()), 2);
+    char data[2][16];
+    std::array<ndt::Buffer, 2> inBufs = {ndt::Buffer(data[0]),
+                                         ndt::Buffer(data[1])};
+    ASSERT_EQ(s.recvBatch(inBufs.data(), inBufs.size()), 1);
+    ASSERT_EQ(inBufs[0].size(), 5);
+    s.close();
+}
+#endif
+
+TEST(SocketTests, BatchOfDatagramsIsSentAndReceived)
+{
+    constexpr std::size_t kCount = 3;
+    ndt::Context<ndt::SocketOps> ctx;
+    ndt::UDP::Socket receiver(ctx, ndt::UDP::V4(), 34126);
+    ndt::UDP::Socket sender(ctx, ndt::UDP::V4(), 34127);
+    receiver.nonBlocking(true);
+
+    const ndt::Address dst(ndt::kIPv4Loopback, 34126);
+    const std::array<ndt::Address, kCount> dsts = {dst, dst, dst};
+    const char kData[] = "batch";
+    const std::array<ndt::CBuffer, kCount> outBufs = {
+        ndt::CBuffer(kData, 1), ndt::CBuffer(kData, 3), ndt::CBuffer(kData)};
+    ASSERT_EQ(sender.sendBatch(dsts.data(), outBufs.data(), kCount), kCount);
+
+    char data[kCount + 1][16];
+    std::array<ndt::Buffer, kCount + 1> inBufs = {
+        ndt::Buffer(data[0]), ndt::Buffer(data[1]), ndt::Buffer(data[2]),
+        ndt::Buffer(data[3])};
+    std::array<ndt::Address, kCount + 1> senders;
+    ASSERT_EQ(receiver.recvBatch(inBufs.data(), senders.data(), inBufs.size()),
+              kCount);
+    for (std::size_t i = 0; i < kCount; ++i)
+    {
+        ASSERT_EQ(inBufs[i].size(), outBufs[i].size());
+        ASSERT_EQ(senders[i].port(), 34127);
+    }
+
+    std::error_code ec;
+    ASSERT_EQ(receiver.recvBatch(inBufs.data(), senders.data(), 1, ec), 0);
+    ASSERT_EQ(ec, std::errc::operation_would_block);
+    sender.close();
+    receiver.close();
+}
+
+TEST(SocketTests, ConnectedSocketsExchangeDatagrams)
+{
+    ndt::Context<ndt::SocketOps> ctx;
+    ndt::UDP::Socket a(ctx, ndt::UDP::V4(), 34133);
+    ndt::UDP::Socket b(ctx, ndt::UDP::V4(), 34134);
+    a.nonBlocking(true);
+    b.nonBlocking(true);
+    a.connect(ndt::Address(ndt::kIPv4Loopback, 34134));
+    b.connect(ndt::Address(ndt::kIPv4Loopback, 34133));
+
+    const char kData[] = "connected";
+    ASSERT_EQ(a.send(ndt::CBuffer(kData)), sizeof(kData));
+    char data[16];
+    ndt::Buffer buf(data);
+    ASSERT_EQ(b.recv(buf), sizeof(kData));
+
+    const std::array<ndt::CBuffer, 2> outBufs = {ndt::CBuffer(kData, 2),
+                                                 ndt::CBuffer(kData, 4)};
+    ASSERT_EQ(b.sendBatch(outBufs.data(), outBufs.size()), 2);
+    char batchData[3][16];
+    std::array<ndt::Buffer, 3> inBufs = {ndt::Buffer(batchData[0]),
+                                         ndt::Buffer(batchData[1]),
+                                         ndt::Buffer(batchData[2])};
+    ASSERT_EQ(a.recvBatch(inBufs.data(), inBufs.size()), 2);
+    ASSERT_EQ(inBufs[0].size(), 2);
+    ASSERT_EQ(inBufs[1].size(), 4);
+
+    a.disconnect();
+    ASSERT_FALSE(a.isConnected());
+    a.close();
+    b.close();
+}
+
+TEST(SocketTests, DualStackSocketServesV4Peers)
+{
+    ndt::Context<ndt::SocketOps> ctx;
+    ndt::UDP::Socket server(ctx, ndt::UDP::DualStack(), 34135);
+    ndt::UDP::Socket client(ctx, ndt::UDP::V4(), 34136);
+    server.nonBlocking(true);
+    client.nonBlocking(true);
+
+    const char kData[] = "dual";
+    ASSERT_EQ(client.sendTo(ndt::Address(ndt::kIPv4Loopback, 34135),
+                            ndt::CBuffer(kData)),
+              sizeof(kData));
+    char data[16];
+    ndt::Buffer buf(data);
+    ndt::Address peer;
+    ASSERT_EQ(server.recvFrom(buf, peer), sizeof(kData));
+    ASSERT_TRUE(peer.isV4Mapped());
+    ndt::Address normalized = peer;
+    normalized.normalize();
+    ASSERT_EQ(normalized, ndt::Address(ndt::kIPv4Loopback, 34136));
+
+    ASSERT_EQ(server.sendTo(peer, ndt::CBuffer(kData)), sizeof(kData));
+    ndt::Buffer reply(data);
+    ASSERT_EQ(client.recvFrom(reply, peer), sizeof(kData));
+    ASSERT_EQ(peer.port(), 34135);
+    server.close();
+    client.close();
+}
+
+#if defined(__linux__)
+TEST(SocketTests, UnixDgramSocketsExchangeDatagrams)
+{
+    const std::string prefix = "ndt_socket_" + std::to_string(::getpid());
+    ndt::Address serverAddress;
+    serverAddress.abstractPath(prefix + "_server");
+    ndt::Address clientAddress;
+    clientAddress.abstractPath(prefix + "_client_with_longer_name");
+
+    ndt::Context<ndt::SocketOps> ctx;
+    ndt::UnixDgram::Socket server(ctx, ndt::UnixDgram(), serverAddress);
+    ndt::UnixDgram::Socket client(ctx, ndt::UnixDgram(), clientAddress);
+    ndt::UnixDgram::Socket unnamed(ctx, ndt::UnixDgram());
+    unnamed.open();
+    server.nonBlocking(true);
+
+    const char kData[] = "ipc";
+    ASSERT_EQ(client.sendTo(serverAddress, ndt::CBuffer(kData)),
+              sizeof(kData));
+    ASSERT_EQ(unnamed.sendTo(serverAddress, ndt::CBuffer(kData, 2)), 2);
+
+    char data[2][16];
+    std::array<ndt::Buffer, 2> bufs = {ndt::Buffer(data[0]),
+                                       ndt::Buffer(data[1])};
+    std::array<ndt::Address, 2> senders;
+    // the second sender reuses address which held longer name
+    senders[1] = clientAddress;
+    ASSERT_EQ(server.recvBatch(bufs.data(), senders.data(), bufs.size()), 2);
+    ASSERT_EQ(bufs[0].size(), sizeof(kData));
+    ASSERT_EQ(senders[0], clientAddress);
+    ASSERT_TRUE(senders[0].isAbstract());
+    ASSERT_EQ(bufs[1].size(), 2);
+    ASSERT_TRUE(senders[1].unixPath().empty());
+
+    ASSERT_EQ(server.sendTo(senders[0], ndt::CBuffer(kData)), sizeof(kData));
+    ndt::Buffer reply(data[0]);
+    ndt::Address sender;
+    ASSERT_EQ(client.recvFrom(reply, sender), sizeof(kData));
+    ASSERT_EQ(sender, serverAddress);
+    unnamed.close();
+    client.close();
+    server.close();
+}
+#endif
+
+TEST(SocketTests, SegmentsSplitBufferIntoDatagrams)
+{
+    const char kData[] = "0123456789";
+    const ndt::Segments segments(ndt::CBuffer(kData, 10), 4);
+    ASSERT_EQ(segments.count(), 3);
+    ASSERT_EQ(segments[0].data<char>(), kData);
+    ASSERT_EQ(segments[0].size(), 4);
+    ASSERT_EQ(segments[1].data<char>(), kData + 4);
+    ASSERT_EQ(segments[1].size(), 4);
+    ASSERT_EQ(segments[2].data<char>(), kData + 8);
+    ASSERT_EQ(segments[2].size(), 2);
+    ASSERT_EQ(ndt::Segments(ndt::CBuffer(kData, 0), 0).count(), 0);
+}
+
+#if defined(UDP_SEGMENT)
+TEST_F(SocketTest, SendSegmentedMustPassSegmentSizeToKernel)
+{
+    InSequence seq;
+    mDetails->expectSocketSucceded(AF_INET);
+    mDetails->expectBindSucceded(kV4Size);
+    EXPECT_CALL(*mDetails, getsockopt(kValidSockId, IPPROTO_UDP, UDP_SEGMENT,
+                                      _, _))
+        .WillOnce(Return(0));
+    EXPECT_CALL(*mDetails, sendmsg(kValidSockId, _, 0))
+        .WillOnce(Invoke([](ndt::sock_t, const struct msghdr *aMsg, int) {
+            const cmsghdr *cmsg = CMSG_FIRSTHDR(aMsg);
+            EXPECT_EQ(cmsg->cmsg_level, IPPROTO_UDP);
+            EXPECT_EQ(cmsg->cmsg_type, UDP_SEGMENT);
+            uint16_t segmentSize = 0;
+            std::memcpy(&segmentSize, CMSG_DATA(cmsg), sizeof(segmentSize));
+            EXPECT_EQ(segmentSize, 4);
+            return static_cast<ndt::sdlen_t>(aMsg->msg_iov->iov_len);
+        }));
+    mDetails->expectCloseSucceded();
+
+    ndt::Socket<ndt::UDP, SocketTest> s(ctx, ndt::UDP::V4(), 11);
+    const char kData[] = "0123456789";
+    ASSERT_EQ(s.sendSegmented(ndt::Address(), ndt::CBuffer(kData, 10), 4), 10);
+    s.close();
+}
+
+TEST_F(SocketTest, SendSegmentedWithoutGsoMustSendDatagramsOneByOne)
+{
+    InSequence seq;
+    mDetails->expectSocketSucceded(AF_INET);
+    mDetails->expectBindSucceded(kV4Size);
+    EXPECT_CALL(*mDetails, getsockopt(kValidSockId, IPPROTO_UDP, UDP_SEGMENT,
+                                      _, _))
+        .WillOnce(Return(ndt::kSocketError));
+    EXPECT_CALL(*mDetails, sendto(kValidSockId, _, 4, _, _, _))
+        .Times(2)
+        .WillRepeatedly(Return(4));
+    EXPECT_CALL(*mDetails, sendto(kValidSockId, _, 2, _, _, _))
+        .WillOnce(Return(ndt::kSocketError));
+    mDetails->expectCloseSucceded();
+
+    ndt::Socket<ndt::UDP, SocketTest> s(ctx, ndt::UDP::V4(), 11);
+    const char kData[] = "0123456789";
+    std::error_code ec;
+    ASSERT_EQ(
+        s.sendSegmented(ndt::Address(), ndt::CBuffer(kData, 10), 4, ec), 8);
+    ASSERT_EQ(ec.value(), SocketTest::lastErrorCode());
+    s.close();
+}
+#endif
+
+#if defined(MSG_ZEROCOPY) && defined(SO_EE_ORIGIN_ZEROCOPY)
+TEST_F(SocketTest, ZeroCopyCompletionsMustReleaseBuffersOfSends)
+{
+    InSequence seq;
+    mDetails->expectSocketSucceded(AF_INET);
+    mDetails->expectBindSucceded(kV4Size);
+    mDetails->expectSetsockoptSucceded(SOL_SOCKET, SO_ZEROCOPY);
+    EXPECT_CALL(*mDetails, sendto(kValidSockId, _, 8, 0, _, _))
+        .WillOnce(Return(8));
+    EXPECT_CALL(*mDetails, sendto(kValidSockId, _, 16, MSG_ZEROCOPY, _, _))
+        .Times(2)
+        .WillRepeatedly(Return(16));
+    EXPECT_CALL(*mDetails, recvmsg(kValidSockId, _, MSG_ERRQUEUE))
+        .WillOnce(Invoke([](ndt::sock_t, struct msghdr *aMsg, int) {
+            // both sends are completed by single notification
+            cmsghdr *cmsg = CMSG_FIRSTHDR(aMsg);
+            cmsg->cmsg_level = IPPROTO_IP;
+            cmsg->cmsg_type = IP_RECVERR;
+            cmsg->cmsg_len = CMSG_LEN(sizeof(sock_extended_err));
+            sock_extended_err err = {};
+            err.ee_origin = SO_EE_ORIGIN_ZEROCOPY;
+            err.ee_info = 0;
+            err.ee_data = 1;
+            std::memcpy(CMSG_DATA(cmsg), &err, sizeof(err));
+            aMsg->msg_controllen = CMSG_SPACE(sizeof(err));
+            return 0;
+        }));
+    mDetails->expectCloseSucceded();
+
+    ndt::Socket<ndt::UDP, SocketTest> s(ctx, ndt::UDP::V4(), 11);
+    s.zeroCopy(true);
+    s.zeroCopyThreshold(16);
+    const char kData[] = "0123456789abcdef";
+    const ndt::Address dst;
+    ASSERT_FALSE(s.sendToZeroCopy(dst, ndt::CBuffer(kData, 8)));
+    ASSERT_TRUE(s.sendToZeroCopy(dst, ndt::CBuffer(kData, 16)));
+    ASSERT_TRUE(s.sendToZeroCopy(dst, ndt::CBuffer(kData + 1, 16)));
+    ASSERT_EQ(s.zeroCopyPendingCount(), 2);
+
+    std::vector<const char *> released;
+    const auto releasedCount =
+        s.readZeroCopyCompletions([&released](ndt::CBuffer aBuf) {
+            released.push_back(aBuf.data<char>());
+        });
+    ASSERT_EQ(releasedCount, 2);
+    ASSERT_EQ(released, (std::vector<const char *>{kData, kData + 1}));
+    ASSERT_EQ(s.zeroCopyPendingCount(), 0);
+    ASSERT_EQ(s.zeroCopyTrackedCount(), 0);
+    s.close();
+}
+
+TEST_F(SocketTest, ZeroCopyBookkeepingMustNotGrowWhileSendsOverlap)
+{
+    constexpr uint32_t kSendCount = 100;
+    // every completion reports the send before the latest one
+    uint32_t completedNumber = 0;
+    InSequence seq;
+    mDetails->expectSocketSucceded(AF_INET);
+    mDetails->expectBindSucceded(kV4Size);
+    mDetails->expectSetsockoptSucceded(SOL_SOCKET, SO_ZEROCOPY);
+    EXPECT_CALL(*mDetails, sendto(kValidSockId, _, 16, MSG_ZEROCOPY, _, _))
+        .WillOnce(Return(16));
+    for (uint32_t i = 1; i < kSendCount; ++i)
+    {
+        EXPECT_CALL(*mDetails, sendto(kValidSockId, _, 16, MSG_ZEROCOPY, _, _))
+            .WillOnce(Return(16));
+        EXPECT_CALL(*mDetails, recvmsg(kValidSockId, _, MSG_ERRQUEUE))
+            .WillOnce(Invoke(
+                [&completedNumber](ndt::sock_t, struct msghdr *aMsg, int) {
+                    cmsghdr *cmsg = CMSG_FIRSTHDR(aMsg);
+                    cmsg->cmsg_level = IPPROTO_IP;
+                    cmsg->cmsg_type = IP_RECVERR;
+                    cmsg->cmsg_len = CMSG_LEN(sizeof(sock_extended_err));
+                    sock_extended_err err = {};
+                    err.ee_origin = SO_EE_ORIGIN_ZEROCOPY;
+                    err.ee_info = completedNumber;
+                    err.ee_data = completedNumber;
+                    ++completedNumber;
+                    std::memcpy(CMSG_DATA(cmsg), &err, sizeof(err));
+                    aMsg->msg_controllen = CMSG_SPACE(sizeof(err));
+                    return 0;
+                }));
+        // the latest send is still pending, error queue is empty
+        EXPECT_CALL(*mDetails, recvmsg(kValidSockId, _, MSG_ERRQUEUE))
+            .WillOnce(Return(ndt::kSocketError));
+    }
+    mDetails->expectCloseSucceded();
+
+    ndt::Socket<ndt::UDP, SocketTest> s(ctx, ndt::UDP::V4(), 11);
+    s.zeroCopy(true);
+    s.zeroCopyThreshold(16);
+    const char kData[] = "0123456789abcdef";
+    const ndt::Address dst;
+    ASSERT_TRUE(s.sendToZeroCopy(dst, ndt::CBuffer(kData, 16)));
+    for (uint32_t i = 1; i < kSendCount; ++i)
+    {
+        // new send is issued before the previous one is completed
+        ASSERT_TRUE(s.sendToZeroCopy(dst, ndt::CBuffer(kData, 16)));
+        std::error_code ec;
+        ASSERT_EQ(s.readZeroCopyCompletions([](ndt::CBuffer) {}, ec), 1);
+        ASSERT_EQ(s.zeroCopyPendingCount(), 1);
+        ASSERT_EQ(s.zeroCopyTrackedCount(), 1);
+    }
+    s.close();
+}
+#endif
+
+#if defined(SCM_TIMESTAMPNS)
+TEST_F(SocketTest, RecvFromMustReturnKernelArrivalTime)
+{
+    InSequence seq;
+    mDetails->expectSocketSucceded(AF_INET);
+    mDetails->expectBindSucceded(kV4Size);
+    EXPECT_CALL(*mDetails, recvmsg(kValidSockId, _, 0))
+        .WillOnce(Invoke([](ndt::sock_t, struct msghdr *aMsg, int) {
+            cmsghdr *cmsg = CMSG_FIRSTHDR(aMsg);
+            cmsg->cmsg_level = SOL_SOCKET;
+            cmsg->cmsg_type = SCM_TIMESTAMPNS;
+            cmsg->cmsg_len = CMSG_LEN(sizeof(timespec));
+            const timespec time = {1700000000, 123456789};
+            std::memcpy(CMSG_DATA(cmsg), &time, sizeof(time));
+            aMsg->msg_controllen = CMSG_SPACE(sizeof(time));
+            return 3;
+        }))
+        .WillOnce(Invoke([](ndt::sock_t, struct msghdr *aMsg, int) {
+            aMsg->msg_controllen = 0;
+            return 2;
+        }));
+    mDetails->expectCloseSucceded();
+
+    ndt::Socket<ndt::UDP, SocketTest> s(ctx, ndt::UDP::V4(), 11);
+    char data[16];
+    ndt::Buffer buf(data);
+    ndt::Address sender;
+    ndt::RecvTimeT time;
+    ASSERT_EQ(s.recvFrom(buf, sender, time), 3);
+    ASSERT_EQ(buf.size(), 3);
+    ASSERT_EQ(time.time_since_epoch(),
+              std::chrono::seconds(1700000000) +
+                  std::chrono::nanoseconds(123456789));
+
+    // datagram without timestamp
+    ASSERT_EQ(s.recvFrom(buf, sender, time), 2);
+    ASSERT_EQ(time, ndt::RecvTimeT{});
+    s.close();
+}
+
+TEST(SocketTests, BatchOfDatagramsIsReceivedWithArrivalTimes)
+{
+    constexpr std::size_t kCount = 2;
+    ndt::Context<ndt::SocketOps> ctx;
+    ndt::UDP::Socket receiver(ctx, ndt::UDP::V4(), 34131);
+    ndt::UDP::Socket sender(ctx, ndt::UDP::V4(), 34132);
+    receiver.nonBlocking(true);
+    receiver.set<ndt::opt::RecvTimestamp>(true);
+    ASSERT_TRUE(receiver.get<ndt::opt::RecvTimestamp>());
+
+    const auto before = std::chrono::system_clock::now();
+    const ndt::Address dst(ndt::kIPv4Loopback, 34131);
+    const char kData[] = "time";
+    sender.sendTo(dst, ndt::CBuffer(kData));
+    sender.sendTo(dst, ndt::CBuffer(kData));
+
+    char data[kCount][16];
+    std::array<ndt::Buffer, kCount> bufs = {ndt::Buffer(data[0]),
+                                            ndt::Buffer(data[1])};
+    std::array<ndt::Address, kCount> senders;
+    std::array<ndt::RecvTimeT, kCount> times;
+    ASSERT_EQ(receiver.recvBatch(bufs.data(), senders.data(), times.data(),
+                                 kCount),
+              kCount);
+    const auto after = std::chrono::system_clock::now();
+    for (const auto &time: times)
+    {
+        // kernel's realtime clock may be coarser than user space one
+        ASSERT_GE(time, before - std::chrono::milliseconds(10));
+        ASSERT_LE(time, after);
+    }
+    ASSERT_LE(times[0], times[1]);
+    sender.close();
+    receiver.close();
+}
+#endif
+
+TEST(SocketTests, SegmentedDatagramsAreSentAndReceived)
+{
+    constexpr std::size_t kSegmentSize = 1000;
+    constexpr std::size_t kCount = 5;
+    ndt::Context<ndt::SocketOps> ctx;
+    ndt::UDP::Socket receiver(ctx, ndt::UDP::V4(), 34128);
+    ndt::UDP::Socket sender(ctx, ndt::UDP::V4(), 34129);
+    receiver.nonBlocking(true);
+    receiver.gro(true);
+
+    std::vector<char> out(kSegmentSize * kCount - 1, 'x');
+    const ndt::Address dst(ndt::kIPv4Loopback, 34128);
+    ASSERT_EQ(sender.sendSegmented(dst, ndt::CBuffer(out.data(), out.size()),
+                                   kSegmentSize),
+              out.size());
+
+    static char data[1 << 16];
+    std::size_t datagramCount = 0;
+    std::size_t byteCount = 0;
+    for (;;)
+    {
+        ndt::Buffer buf(data);
+        ndt::Address src;
+        std::error_code ec;
+        const ndt::Segments segments = receiver.recvSegmented(buf, src, ec);
+        if (ec)
+        {
+            ASSERT_EQ(ec, std::errc::operation_would_block);
+            break;
+        }
+        for (std::size_t i = 0; i < segments.count(); ++i)
+        {
+            ASSERT_LE(segments[i].size(), kSegmentSize);
+            byteCount += segments[i].size();
+        }
+        datagramCount += segments.count();
+    }
+    ASSERT_EQ(datagramCount, kCount);
+    ASSERT_EQ(byteCount, out.size());
+    sender.close();
+    receiver.close();
+}
+
+TEST(SocketTests, KernelBufferSizesAreSetAndRead)
+{
+    constexpr int kSize = 1 << 16;
+    ndt::Context<ndt::SocketOps> ctx;
+    ndt::UDP::Socket s(ctx, ndt::UDP::V4());
+    s.open();
+    s.set<ndt::opt::RecvBufferSize>(kSize);
+    s.set<ndt::opt::SendBufferSize>(kSize);
+    ASSERT_GE(s.get<ndt::opt::RecvBufferSize>(), kSize);
+    ASSERT_GE(s.get<ndt::opt::SendBufferSize>(), kSize);
+    s.close();
+}
+
 TEST(SocketTests, SetNonBlockingMode)
 {
     ndt::Context<ndt::SocketOps> ctx;
@@ -0,0 +1,309 @@
+#include <fmt/core.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ndt/address.h"
+#include "ndt/buffer.h"
+#include "ndt/context.h"
+#include "ndt/event_handler_select.h"
+#include "ndt/tcp.h"
+
+namespace
+{
+using ContextT = ndt::Context<ndt::SocketOps>;
+
+constexpr timeval kTimeout = {2, 0};
+
+ndt::TCP::Socket makeListener(ContextT &aContext, const uint16_t aPort)
+{
+    ndt::TCP::Socket listener(aContext, ndt::TCP::V4());
+    listener.open();
+    listener.set<ndt::opt::ReuseAddress>(true);
+    listener.bind(aPort);
+    listener.listen();
+    return listener;
+}
+
+// reads connection until peer closes it or expected size is reached
+class DataHandler
+    : public ndt::HandlerSelect<ndt::TCP::Socket, DataHandler, ndt::SocketOps>
+{
+   public:
+    explicit DataHandler(ContextT &aContext) : HandlerSelect(aContext) {}
+
+    void readHandlerImpl(ndt::TCP::Socket &aSocket)
+    {
+        char data[65536];
+        ndt::Buffer buf(data);
+        std::error_code ec;
+        const auto bytesReceived = aSocket.recv(buf, ec);
+        if (ec)
+        {
+            return;
+        }
+        data_.append(data, bytesReceived);
+        if ((bytesReceived == 0) || (data_.size() == expectedSize_))
+        {
+            context_.stop();
+        }
+    }
+
+    std::size_t expectedSize_ = 0;
+    std::string data_;
+};
+
+class ListenHandler
+    : public ndt::HandlerSelect<ndt::TCP::Socket, ListenHandler,
+                                ndt::SocketOps>
+{
+   public:
+    ListenHandler(ContextT &aContext, DataHandler &aDataHandler)
+        : HandlerSelect(aContext), dataHandler_(aDataHandler)
+    {
+    }
+
+    void readHandlerImpl(ndt::TCP::Socket &aSocket)
+    {
+        ndt::Address peer;
+        std::error_code ec;
+        auto accepted = aSocket.accept(peer, ec);
+        if (ec)
+        {
+            return;
+        }
+        peer_ = peer;
+        accepted.handler(&dataHandler_);
+        accepted_.push_back(std::move(accepted));
+    }
+
+    DataHandler &dataHandler_;
+    ndt::Address peer_;
+    std::vector<ndt::TCP::Socket> accepted_;
+};
+
+// finishes non-blocking connect and writes message on write readiness
+class ConnectHandler
+    : public ndt::HandlerSelect<ndt::TCP::Socket, ConnectHandler,
+                                ndt::SocketOps>
+{
+   public:
+    explicit ConnectHandler(ContextT &aContext) : HandlerSelect(aContext) {}
+
+    void writeHandlerImpl(ndt::TCP::Socket &aSocket)
+    {
+        if (!aSocket.isConnected())
+        {
+            aSocket.finishConnect(connectEc_);
+            if (connectEc_)
+            {
+                context_.stop();
+                return;
+            }
+        }
+        while (count_ > 0)
+        {
+            std::error_code ec;
+            const auto bytesSent = aSocket.send(bufs_, count_, ec);
+            if (ec)
+            {
+                return;
+            }
+            ++sendCount_;
+            ndt::consume(bufs_, count_, bytesSent);
+        }
+        aSocket.writeInterest(false);
+    }
+
+    std::error_code connectEc_;
+    ndt::CBuffer *bufs_ = nullptr;
+    std::size_t count_ = 0;
+    std::size_t sendCount_ = 0;
+};
+}  // namespace
+
+TEST(TCPTests, Flags)
+{
+    ASSERT_EQ(ndt::TCP::V4().getFamily(), ndt::eAddressFamily::kIPv4);
+    ASSERT_EQ(ndt::TCP::V6().getFamily(), ndt::eAddressFamily::kIPv6);
+    ASSERT_EQ(ndt::TCP::V4().getSocketType(), ndt::eSocketType::kStream);
+    ASSERT_EQ(ndt::TCP::V4().getProtocol(), ndt::eIPProtocol::kTCP);
+    ASSERT_EQ(ndt::TCP::V4().sysSocketType(), SOCK_STREAM);
+    ASSERT_EQ(ndt::TCP::V4().sysProtocol(), IPPROTO_TCP);
+    ASSERT_TRUE(ndt::TCP::DualStack().isDualStack());
+    ASSERT_FALSE(ndt::TCP::V6().isDualStack());
+    ASSERT_EQ(ndt::TCP::V4(), ndt::TCP::V4());
+    ASSERT_NE(ndt::TCP::V6(), ndt::TCP::DualStack());
+}
+
+TEST(TCPTests, ConsumeSkipsTransferredBytes)
+{
+    const char kHeader[] = "head";
+    const char kPayload[] = "payload";
+    ndt::CBuffer bufs[] = {ndt::CBuffer(kHeader, 4), ndt::CBuffer(kPayload, 7)};
+    ndt::CBuffer *rest = bufs;
+    std::size_t count = 2;
+
+    ndt::consume(rest, count, 2);
+    ASSERT_EQ(count, 2);
+    ASSERT_EQ(rest, bufs);
+    ASSERT_EQ(std::string(rest->data<char>(), rest->size()), "ad");
+
+    ndt::consume(rest, count, 4);
+    ASSERT_EQ(count, 1);
+    ASSERT_EQ(rest, bufs + 1);
+    ASSERT_EQ(std::string(rest->data<char>(), rest->size()), "yload");
+
+    ndt::consume(rest, count, 5);
+    ASSERT_EQ(count, 0);
+}
+
+TEST(TCPTests, BlockingConnectionExchangesVectoredData)
+{
+    constexpr uint16_t kPort = 34137;
+    ContextT ctx;
+    auto listener = makeListener(ctx, kPort);
+
+    ndt::TCP::Socket client(ctx, ndt::TCP::V4());
+    client.open();
+    client.set<ndt::opt::NoDelay>(true);
+    ASSERT_TRUE(client.get<ndt::opt::NoDelay>());
+    client.connect(ndt::Address(ndt::kIPv4Loopback, kPort));
+    ASSERT_TRUE(client.isConnected());
+
+    ndt::Address peer;
+    auto server = listener.accept(peer);
+    ASSERT_TRUE(server.isOpen());
+    ASSERT_TRUE(server.isConnected());
+    ASSERT_EQ(peer, ndt::Address(ndt::kIPv4Loopback, peer.port()));
+
+    // header and payload go out in one call without staging buffer
+    const uint32_t kHeader = 0x01020304;
+    const std::string kPayload = "asset bytes";
+    const ndt::CBuffer out[] = {
+        ndt::CBuffer(&kHeader, sizeof(kHeader)),
+        ndt::CBuffer(kPayload.data(), kPayload.size())};
+    const std::size_t total = sizeof(kHeader) + kPayload.size();
+    ASSERT_EQ(client.send(out, 2), total);
+    client.shutdown();
+
+    uint32_t header = 0;
+    char payload[64] = {};
+    ndt::Buffer in[] = {ndt::Buffer(&header, sizeof(header)),
+                        ndt::Buffer(payload, kPayload.size())};
+    ndt::Buffer *rest = in;
+    std::size_t count = 2;
+    while (count > 0)
+    {
+        const auto bytesReceived = server.recv(rest, count);
+        ASSERT_GT(bytesReceived, 0);
+        ndt::consume(rest, count, bytesReceived);
+    }
+    ASSERT_EQ(header, kHeader);
+    ASSERT_EQ(std::string(payload, kPayload.size()), kPayload);
+
+    // peer has shut its side down
+    char data[16];
+    ndt::Buffer buf(data);
+    ASSERT_EQ(server.recv(buf), 0);
+
+    server.close();
+    client.close();
+    listener.close();
+}
+
+TEST(TCPTests, NonBlockingAcceptWithoutPendingConnectionWouldBlock)
+{
+    constexpr uint16_t kPort = 34138;
+    ContextT ctx;
+    auto listener = makeListener(ctx, kPort);
+    listener.nonBlocking(true);
+
+    ndt::Address peer;
+    std::error_code ec;
+    auto accepted = listener.accept(peer, ec);
+    ASSERT_EQ(ec, std::errc::operation_would_block);
+    ASSERT_FALSE(accepted.isOpen());
+    listener.close();
+}
+
+TEST(TCPTests, SendToClosedPeerFailsWithoutSignal)
+{
+    constexpr uint16_t kPort = 34139;
+    ContextT ctx;
+    auto listener = makeListener(ctx, kPort);
+    ndt::TCP::Socket client(ctx, ndt::TCP::V4());
+    client.open();
+    client.connect(ndt::Address(ndt::kIPv4Loopback, kPort));
+    ndt::Address peer;
+    auto server = listener.accept(peer);
+    server.close();
+
+    const char kData[] = "data";
+    std::error_code ec;
+    for (int i = 0; (i < 100) && !ec; ++i)
+    {
+        client.send(ndt::CBuffer(kData), ec);
+    }
+    ASSERT_TRUE((ec == std::errc::broken_pipe) ||
+                (ec == std::errc::connection_reset));
+    client.close();
+    listener.close();
+}
+
+TEST(TCPTests, ExecutorDrivesNonBlockingConnectionAndPartialWrites)
+{
+    constexpr uint16_t kPort = 34140;
+    ContextT ctx;
+    ctx.executor().setTimeout(kTimeout);
+    ctx.executor().setTimeoutHandler([&ctx]() { ctx.stop(); });
+
+    auto listener = makeListener(ctx, kPort);
+    listener.nonBlocking(true);
+    DataHandler dataHandler(ctx);
+    ListenHandler listenHandler(ctx, dataHandler);
+    listener.handler(&listenHandler);
+
+    // larger than socket buffers, so it is written in several parts
+    const std::string kHeader = "size:8388608;";
+    const std::string kPayload(8 << 20, 'x');
+    dataHandler.expectedSize_ = kHeader.size() + kPayload.size();
+    ndt::CBuffer out[] = {ndt::CBuffer(kHeader.data(), kHeader.size()),
+                          ndt::CBuffer(kPayload.data(), kPayload.size())};
+
+    ndt::TCP::Socket client(ctx, ndt::TCP::V4());
+    client.open();
+    client.nonBlocking(true);
+    std::error_code ec;
+    client.connect(ndt::Address(ndt::kIPv4Loopback, kPort), ec);
+    ASSERT_TRUE(!ec || (ec == std::errc::operation_in_progress));
+    ConnectHandler connectHandler(ctx);
+    connectHandler.bufs_ = out;
+    connectHandler.count_ = 2;
+    client.handler(&connectHandler);
+
+    ctx.run();
+
+    ASSERT_FALSE(connectHandler.connectEc_);
+    ASSERT_TRUE(client.isConnected());
+    ASSERT_EQ(connectHandler.count_, 0);
+    ASSERT_GT(connectHandler.sendCount_, 1);
+    ASSERT_EQ(listenHandler.accepted_.size(), 1);
+    ASSERT_EQ(listenHandler.peer_.ip(),
+              ndt::Address(ndt::kIPv4Loopback, kPort).ip());
+    ASSERT_EQ(dataHandler.data_.size(), dataHandler.expectedSize_);
+    ASSERT_EQ(dataHandler.data_.substr(0, kHeader.size()), kHeader);
+    ASSERT_EQ(dataHandler.data_.substr(kHeader.size()), kPayload);
+
+    for (auto &accepted: listenHandler.accepted_)
+    {
+        accepted.close();
+    }
+    client.close();
+    listener.close();
+}
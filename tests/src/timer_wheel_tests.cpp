@@ -0,0 +1,139 @@
+#include <fmt/core.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "ndt/context.h"
+#include "ndt/timer_wheel.h"
+
+TEST(TimerWheelTest, FiresAtExpiry)
+{
+    ndt::TimerWheel wheel;
+    std::size_t fireCount = 0;
+    ndt::Timer timer([&fireCount]() { ++fireCount; });
+    wheel.schedule(timer, 10);
+    ASSERT_TRUE(timer.isArmed());
+    ASSERT_EQ(wheel.nextExpiry(), 10);
+
+    ASSERT_EQ(wheel.advance(9), 0);
+    ASSERT_EQ(fireCount, 0);
+    ASSERT_EQ(wheel.advance(10), 1);
+    ASSERT_EQ(fireCount, 1);
+    ASSERT_FALSE(timer.isArmed());
+    ASSERT_TRUE(wheel.empty());
+    ASSERT_EQ(wheel.nextExpiry(), ndt::TimerWheel::kNever);
+}
+
+TEST(TimerWheelTest, FiresInExpiryOrderAcrossLevels)
+{
+    ndt::TimerWheel wheel;
+    std::vector<uint64_t> fired;
+    // delays cover every level and the overflow list
+    const std::vector<uint64_t> expiries = {
+        1, 255, 256, 257, 70000, 65536, 16777217, (uint64_t{1} << 32) + 5};
+    std::vector<std::unique_ptr<ndt::Timer>> timers;
+    for (const uint64_t expiry: expiries)
+    {
+        timers.push_back(std::make_unique<ndt::Timer>());
+        ndt::Timer &t = *timers.back();
+        t.callback([&fired, &wheel]() { fired.push_back(wheel.now()); });
+        wheel.schedule(t, expiry);
+    }
+
+    // jump from one expiry hint to another like executor does
+    while (!wheel.empty())
+    {
+        const uint64_t next = wheel.nextExpiry();
+        ASSERT_GT(next, wheel.now());
+        wheel.advance(next);
+    }
+
+    std::vector<uint64_t> expected = expiries;
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(fired, expected);
+}
+
+TEST(TimerWheelTest, CancelAndReschedule)
+{
+    ndt::TimerWheel wheel;
+    std::size_t fireCount = 0;
+    ndt::Timer timer([&fireCount]() { ++fireCount; });
+    wheel.schedule(timer, 100);
+    wheel.cancel(timer);
+    ASSERT_FALSE(timer.isArmed());
+    ASSERT_EQ(wheel.advance(200), 0);
+
+    wheel.schedule(timer, 300);
+    wheel.schedule(timer, 1000);
+    ASSERT_EQ(wheel.size(), 1);
+    ASSERT_EQ(wheel.advance(999), 0);
+    ASSERT_EQ(wheel.advance(1000), 1);
+    ASSERT_EQ(fireCount, 1);
+}
+
+TEST(TimerWheelTest, CallbackReschedulesItself)
+{
+    ndt::TimerWheel wheel;
+    std::size_t fireCount = 0;
+    ndt::Timer timer;
+    timer.callback([&]() {
+        if (++fireCount < 3)
+        {
+            wheel.schedule(timer, wheel.now() + 10);
+        }
+    });
+    wheel.schedule(timer, 10);
+    wheel.advance(100);
+    ASSERT_EQ(fireCount, 3);
+    ASSERT_FALSE(timer.isArmed());
+}
+
+TEST(TimerWheelTest, DestroyedTimerIsCancelled)
+{
+    ndt::TimerWheel wheel;
+    {
+        ndt::Timer timer([]() { FAIL(); });
+        wheel.schedule(timer, 10);
+    }
+    ASSERT_TRUE(wheel.empty());
+    ASSERT_EQ(wheel.advance(20), 0);
+}
+
+TEST(TimerWheelTest, PoolReusesReleasedTimers)
+{
+    ndt::TimerWheel wheel;
+    ndt::TimerPool pool;
+    ndt::Timer &first = pool.acquire([]() {});
+    wheel.schedule(first, 10);
+    pool.release(first);
+    ASSERT_TRUE(wheel.empty());
+
+    ndt::Timer &second = pool.acquire([]() {});
+    ASSERT_EQ(&first, &second);
+    ASSERT_EQ(pool.capacity(), 1);
+    pool.release(second);
+    ASSERT_EQ(pool.available(), 1);
+}
+
+TEST(TimerWheelTest, ContextRunFiresTimers)
+{
+    ndt::Context<ndt::SocketOps> ctx;
+    ctx.executor().setTimeoutInfinite();
+    std::size_t fireCount = 0;
+    ndt::Timer second([&]() {
+        ++fireCount;
+        ctx.stop();
+    });
+    ndt::Timer first([&]() {
+        ++fireCount;
+        ctx.schedule(second, std::chrono::milliseconds(5));
+    });
+    ctx.schedule(first, std::chrono::milliseconds(5));
+
+    // infinite executor timeout is limited by the timers
+    ctx.run();
+    ASSERT_EQ(fireCount, 2);
+}